@@ -32,6 +32,8 @@ GainProcessor::~GainProcessor()
 // Prepare to process audio (always called at least once before processBlock)
 void GainProcessor::prepareToPlay (double /*sampleRate*/, int /*maxSamplesPerBlock*/)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
 }
 
 // Audio processing finished; release any allocated memory
@@ -41,6 +43,12 @@ void GainProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void GainProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void GainProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -1,8 +1,10 @@
 #pragma once
 #include "JuceHeader.h"
 #include "GainParameters.h"
+#include "AutomationScheduler.h"
 
 class GainProcessor : public AudioProcessor
+                    , public AutomationScheduler::Owner
 {
 public:
     GainProcessor();
@@ -29,6 +31,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -42,5 +47,9 @@ public:
     GainParameters parameters;
 
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GainProcessor)
 };
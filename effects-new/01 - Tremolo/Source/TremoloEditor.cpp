@@ -24,15 +24,24 @@ TremoloEditor::TremoloEditor (TremoloProcessor& p)
     TremoloLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
 
+    lfoSyncLabel.setText("Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
+
     lfoFreqKnob.setDoubleClickReturnValue(true, 1.0f, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledLfoFreqKnob);
 
     modDepthKnob.setDoubleClickReturnValue(true, 0.5f, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledModDepthKnob);
 
-    processor.parameters.attachControls(lfoWaveformCombo, lfoFreqKnob, modDepthKnob);
+    processor.parameters.attachControls(lfoWaveformCombo, lfoSyncCombo, lfoFreqKnob, modDepthKnob);
 
-    setSize (320, 250);
+    setSize (320, 284);
 }
 
 TremoloEditor::~TremoloEditor()
@@ -52,6 +61,10 @@ void TremoloEditor::resized()
     lfoWaveformLabel.setBounds(waveformArea.removeFromLeft(40));
     lfoWaveformCombo.setBounds(waveformArea);
     widgetsArea.removeFromTop(10);
+    auto syncArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(syncArea.removeFromLeft(40));
+    lfoSyncCombo.setBounds(syncArea);
+    widgetsArea.removeFromTop(10);
 
     int knobWidth = widgetsArea.getWidth() / 2 - 10;
     labeledLfoFreqKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
@@ -19,6 +19,7 @@ private:
 
     GroupComponent tremoloGroup;
     ComboBox lfoWaveformCombo; Label lfoWaveformLabel;
+    ComboBox lfoSyncCombo; Label lfoSyncLabel;
     BasicKnob lfoFreqKnob; LabeledKnob labeledLfoFreqKnob;
     BasicKnob modDepthKnob; LabeledKnob labeledModDepthKnob;
 
@@ -1,6 +1,4 @@
 #include "TremoloLFO.h"
-#include <cmath>
-#define TWOPI_F 6.283185f
 
 void TremoloLFO::populateWaveformComboBox(ComboBox& cb)
 {
@@ -12,35 +10,18 @@ void TremoloLFO::populateWaveformComboBox(ComboBox& cb)
     cb.addItem("Square (sloped edges)", ++itemNumber);
 }
 
-// Function for calculating "biased" LFO waveforms with output range [0, 1].
-// Phase range [0, 1], output also [0, 1] (not [-1, +1] as for the ordinary Sine function).
-float TremoloLFO::getSample(float phase, Waveform waveform)
+BlockLFO::Waveform TremoloLFO::getBlockWaveform(Waveform waveform)
 {
     switch (waveform)
     {
     case kWaveformTriangle:
-        if (phase < 0.25f)
-            return 0.5f + 2.0f*phase;
-        else if (phase < 0.75f)
-            return 1.0f - 2.0f*(phase - 0.25f);
-        else
-            return 2.0f*(phase - 0.75f);
+        return BlockLFO::kWaveformTriangle;
     case kWaveformSquare:
-        if (phase < 0.5f)
-            return 1.0f;
-        else
-            return 0.0f;
+        return BlockLFO::kWaveformSquare;
     case kWaveformSquareSlopedEdges:
-        if (phase < 0.48f)
-            return 1.0f;
-        else if (phase < 0.5f)
-            return 1.0f - 50.0f*(phase - 0.48f);
-        else if (phase < 0.98f)
-            return 0.0f;
-        else
-            return 50.0f*(phase - 0.98f);
+        return BlockLFO::kWaveformSquareSlopedEdges;
     case kWaveformSine:
     default:
-        return 0.5f + 0.5f*sinf(TWOPI_F * phase);
+        return BlockLFO::kWaveformSine;
     }
 }
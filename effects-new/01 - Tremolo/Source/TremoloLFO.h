@@ -1,7 +1,9 @@
 #pragma once
 #include "JuceHeader.h"
+#include "BlockLFO.h"
 
-/*  A simple biased-output (range [0, 1]) LFO, used in the Tremolo effect.
+/*  The LFO waveforms offered by the Tremolo effect, which are generated by a BlockLFO
+    (see Common/BlockLFO.h).
 */
 
 struct TremoloLFO
@@ -17,5 +19,6 @@ struct TremoloLFO
 
     static void populateWaveformComboBox(ComboBox& cb);
 
-    static float getSample(float phase, Waveform waveform);
+    // The BlockLFO waveform each of ours corresponds to
+    static BlockLFO::Waveform getBlockWaveform(Waveform waveform);
 };
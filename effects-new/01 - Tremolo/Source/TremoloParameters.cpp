@@ -5,6 +5,9 @@
 const String TremoloParameters::lfoWaveformID = "lfoWaveform";
 const String TremoloParameters::lfoWaveformName = TRANS("LFO Waveform");
 const String TremoloParameters::lfoWaveformLabel = "";
+const String TremoloParameters::lfoSyncID = "lfoSync";
+const String TremoloParameters::lfoSyncName = TRANS("LFO Sync");
+const String TremoloParameters::lfoSyncLabel = "";
 const String TremoloParameters::lfoFreqID = "lfoFreq";
 const String TremoloParameters::lfoFreqName = TRANS("LFO Freq");
 const String TremoloParameters::lfoFreqLabel = TRANS("Hz");
@@ -23,6 +26,13 @@ AudioProcessorValueTreeState::ParameterLayout TremoloParameters::createParameter
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
 
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, int(BlockLFO::kNumSyncs) - 1, int(BlockLFO::kSyncOff),
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+
     params.push_back(std::make_unique<AudioParameterFloat>(
         lfoFreqID, lfoFreqName,
         NormalisableRange<float>(0.1f, 10.0f), 1.0f,
@@ -44,14 +54,17 @@ AudioProcessorValueTreeState::ParameterLayout TremoloParameters::createParameter
 
 TremoloParameters::TremoloParameters(AudioProcessorValueTreeState& vts)
     : lfoWaveform(TremoloLFO::kWaveformSine)
-    , lfoFreqHz(1.0f)
-    , modDepth(0.5f)
+    , lfoSync(BlockLFO::kSyncOff)
+    , lfoFreqHz(1.0f, 0.05f, SmoothedParameter::kMultiplicative)
+    , modDepth(0.5f, 0.02f)
     , valueTreeState(vts)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , lfoFreqListener(lfoFreqHz)
     , modDepthListener(modDepth, 0.01f)
 {
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(modDepthID, &modDepthListener);
 }
@@ -60,6 +73,7 @@ TremoloParameters::~TremoloParameters()
 {
     detachControls();
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(modDepthID, &modDepthListener);
 }
@@ -67,14 +81,16 @@ TremoloParameters::~TremoloParameters()
 void TremoloParameters::detachControls()
 {
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     lfoFreqAttachment.reset(nullptr);
     modDepthAttachment.reset(nullptr);
 }
 
-void TremoloParameters::attachControls(ComboBox& lfoWaveformCombo, Slider& lfoFreqKnob, Slider& modDepthKnob)
+void TremoloParameters::attachControls(ComboBox& lfoWaveformCombo, ComboBox& lfoSyncCombo, Slider& lfoFreqKnob, Slider& modDepthKnob)
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
     lfoFreqAttachment.reset(new SlAt(valueTreeState, lfoFreqID, lfoFreqKnob));
     modDepthAttachment.reset(new SlAt(valueTreeState, modDepthID, modDepthKnob));
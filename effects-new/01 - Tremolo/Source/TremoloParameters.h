@@ -9,6 +9,7 @@ public:
     // Id's are symbolic names, Names are human-friendly names for GUI
     // Labels are supplementary, typically used for units of measure
     static const String lfoWaveformID, lfoWaveformName, lfoWaveformLabel;
+    static const String lfoSyncID, lfoSyncName, lfoSyncLabel;
     static const String lfoFreqID, lfoFreqName, lfoFreqLabel;
     static const String modDepthID, modDepthName, modDepthLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -18,12 +19,13 @@ public:
     ~TremoloParameters();
 
     void detachControls();
-    void attachControls(ComboBox& lfoWaveformCombo, Slider& lfoFreqKnob, Slider& modDepthKnob);
+    void attachControls(ComboBox& lfoWaveformCombo, ComboBox& lfoSyncCombo, Slider& lfoFreqKnob, Slider& modDepthKnob);
 
     // working parameter values
     TremoloLFO::Waveform lfoWaveform;
-    float lfoFreqHz;
-    float modDepth;
+    BlockLFO::Sync lfoSync;
+    SmoothedParameter lfoFreqHz;
+    SmoothedParameter modDepth;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -31,11 +33,13 @@ private:
 
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoSyncAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> modDepthAttachment;
 
     // Listener objects link parameters to working variables
     EnumListener<TremoloLFO::Waveform> lfoWaveformListener;
-    FloatListener lfoFreqListener;
-    FloatListener modDepthListener;
+    EnumListener<BlockLFO::Sync> lfoSyncListener;
+    SmoothedFloatListener lfoFreqListener;
+    SmoothedFloatListener modDepthListener;
 };
@@ -31,10 +31,15 @@ TremoloProcessor::~TremoloProcessor()
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void TremoloProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void TremoloProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
-    lfoPhase = 0.0;
-    inverseSampleRate = 1.0 / sampleRate;
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
+    lfo.prepare(sampleRate, maxSamplesPerBlock);
+
+    parameters.lfoFreqHz.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.modDepth.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -44,37 +49,39 @@ void TremoloProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void TremoloProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo and position at the start of each block
+    lfo.setSync(parameters.lfoSync);
+    lfo.syncToPlayHead(getPlayHead());
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void TremoloProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
-    // LFO phase starts at current LFO phase for each channel, advances by deltaPhi for each sample
-    float phi = lfoPhase;
-    float deltaPhi = float(parameters.lfoFreqHz * inverseSampleRate);
+    // Smoothed parameter values, for every sample of this block
+    const float* lfoFreqHz = parameters.lfoFreqHz.getNextBlock(buffer.getNumSamples());
+    const float* modDepth = parameters.modDepth.getNextBlock(buffer.getNumSamples());
+
+    // Render this block of LFO output once, and apply it to every channel
+    lfo.advance(buffer.getNumSamples(), lfoFreqHz);
+    const float* modAmount = lfo.render(0, TremoloLFO::getBlockWaveform(parameters.lfoWaveform),
+                                        buffer.getNumSamples());
 
     // apply the same modulation to all input channels for which there is an output channel
     int channelIndex = 0;
     for (; channelIndex < getTotalNumInputChannels(); channelIndex++)
     {
-        // restart the phase sequence
-        phi = lfoPhase;
-
         const float* pIn = buffer.getReadPointer(channelIndex);
         float* pOut = buffer.getWritePointer(channelIndex);
 
         for (int i = 0; i < buffer.getNumSamples(); i++)
-        {
-            float modAmount = TremoloLFO::getSample(phi, parameters.lfoWaveform);
-            *pOut++ = *pIn++ * (1.0f - parameters.modDepth * modAmount);
-
-            // Update LFO phase, keeping in range [0, 1]
-            phi += deltaPhi;
-            while (phi >= 1.0) phi -= 1.0;
-        }
+            pOut[i] = pIn[i] * (1.0f - modDepth[i] * modAmount[i]);
     }
 
-    // update the main LFO phase state variable, ready for the next processBlock() call
-    lfoPhase = phi;
-
     // clear any remaining/excess output channels to zero
     for (; channelIndex < getTotalNumOutputChannels(); channelIndex++)
     {
@@ -1,8 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "TremoloParameters.h"
+#include "AutomationScheduler.h"
+#include "BlockLFO.h"
 
 class TremoloProcessor : public AudioProcessor
+                       , public AutomationScheduler::Owner
 {
 public:
     TremoloProcessor();
@@ -29,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -41,9 +47,11 @@ public:
     TremoloParameters parameters;
 
 private:
-    float lfoPhase;             // Phase of the low-frequency oscillator, range 0 to 1
-    double inverseSampleRate;   // It's more efficient to multiply than divide, so
-                                // cache the inverse of the sample rate
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    BlockLFO lfo;               // Renders each block's modulation once, for all channels
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TremoloProcessor)
 };
@@ -32,15 +32,24 @@ RingModEditor::RingModEditor(RingModProcessor& p)
     RingModLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
 
+    lfoSyncLabel.setText("Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
+
     lfoFreqKnob.setDoubleClickReturnValue(true, 1.0f, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledLfoFreqKnob);
 
     lfoWidthKnob.setDoubleClickReturnValue(true, 0.0f, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledLfoWidthKnob);
 
-    processor.parameters.attachControls(carrierFreqKnob, lfoWaveformCombo, lfoFreqKnob, lfoWidthKnob);
+    processor.parameters.attachControls(carrierFreqKnob, lfoWaveformCombo, lfoSyncCombo, lfoFreqKnob, lfoWidthKnob);
 
-    setSize (480, 250);
+    setSize (480, 284);
 }
 
 RingModEditor::~RingModEditor()
@@ -58,7 +67,7 @@ void RingModEditor::resized()
     lfoGroup.setBounds(groupsArea);
 
     auto widgetsArea = carrierGroup.getBounds().reduced(20);
-    widgetsArea.removeFromTop(46);
+    widgetsArea.removeFromTop(63);
     labeledCarrierFreqKnob.setBounds(widgetsArea);
 
     widgetsArea = lfoGroup.getBounds().reduced(20);
@@ -67,6 +76,10 @@ void RingModEditor::resized()
     lfoWaveformLabel.setBounds(waveformArea.removeFromLeft(80));
     lfoWaveformCombo.setBounds(waveformArea);
     widgetsArea.removeFromTop(10);
+    auto syncArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(syncArea.removeFromLeft(80));
+    lfoSyncCombo.setBounds(syncArea);
+    widgetsArea.removeFromTop(10);
 
     int knobWidth = widgetsArea.getWidth() / 2 - 10;
     labeledLfoFreqKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
@@ -22,6 +22,7 @@ private:
 
     GroupComponent lfoGroup;
     ComboBox lfoWaveformCombo; Label lfoWaveformLabel;
+    ComboBox lfoSyncCombo; Label lfoSyncLabel;
     BasicKnob lfoFreqKnob; LabeledKnob labeledLfoFreqKnob;
     BasicKnob lfoWidthKnob; LabeledKnob labeledLfoWidthKnob;
 
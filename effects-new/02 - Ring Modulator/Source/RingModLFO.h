@@ -1,7 +1,9 @@
 #pragma once
 #include "JuceHeader.h"
+#include "BlockLFO.h"
 
-/*  A simple symmetric-output (range [-1, 1]) LFO, used in the Ring Modulator effect.
+/*  The LFO waveforms offered by the Ring Modulator effect, which are generated by a BlockLFO
+    (see Common/BlockLFO.h), and scaled from its range [0, 1] to the symmetric range [-1, 1].
 */
 
 struct RingModLFO
@@ -18,5 +20,6 @@ struct RingModLFO
 
     static void populateWaveformComboBox(ComboBox& cb);
 
-    static float getSample(float phase, Waveform waveform);
+    // The BlockLFO waveform each of ours corresponds to
+    static BlockLFO::Waveform getBlockWaveform(Waveform waveform);
 };
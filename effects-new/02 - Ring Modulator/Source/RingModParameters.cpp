@@ -8,6 +8,9 @@ const String RingModParameters::carrierFreqLabel = TRANS("Hz");
 const String RingModParameters::lfoWaveformID = "lfoWaveform";
 const String RingModParameters::lfoWaveformName = TRANS("LFO Waveform");
 const String RingModParameters::lfoWaveformLabel = "";
+const String RingModParameters::lfoSyncID = "lfoSync";
+const String RingModParameters::lfoSyncName = TRANS("LFO Sync");
+const String RingModParameters::lfoSyncLabel = "";
 const String RingModParameters::lfoFreqID = "lfoFreq";
 const String RingModParameters::lfoFreqName = TRANS("LFO Freq");
 const String RingModParameters::lfoFreqLabel = TRANS("Hz");
@@ -34,6 +37,13 @@ AudioProcessorValueTreeState::ParameterLayout RingModParameters::createParameter
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
 
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, int(BlockLFO::kNumSyncs) - 1, int(BlockLFO::kSyncOff),
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+
     params.push_back(std::make_unique<AudioParameterFloat>(
         lfoFreqID, lfoFreqName,
         NormalisableRange<float>(0.1f, 10.0f), 1.0f,
@@ -54,18 +64,21 @@ AudioProcessorValueTreeState::ParameterLayout RingModParameters::createParameter
 }
 
 RingModParameters::RingModParameters(AudioProcessorValueTreeState& vts)
-    : carrierFreqHz(100.0f)
+    : carrierFreqHz(100.0f, 0.05f, SmoothedParameter::kMultiplicative)
     , lfoWaveform(RingModLFO::kWaveformSine)
-    , lfoFreqHz(1.0f)
-    , lfoWidthHz(0.0f)
+    , lfoSync(BlockLFO::kSyncOff)
+    , lfoFreqHz(1.0f, 0.05f, SmoothedParameter::kMultiplicative)
+    , lfoWidthHz(0.0f, 0.05f)
     , valueTreeState(vts)
     , carrierFreqListener(carrierFreqHz)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , lfoFreqListener(lfoFreqHz)
     , lfoWidthListener(lfoWidthHz)
 {
     valueTreeState.addParameterListener(carrierFreqID, &carrierFreqListener);
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(lfoWidthID, &lfoWidthListener);
 }
@@ -75,6 +88,7 @@ RingModParameters::~RingModParameters()
     detachControls();
     valueTreeState.removeParameterListener(carrierFreqID, &carrierFreqListener);
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(lfoWidthID, &lfoWidthListener);
 }
@@ -83,15 +97,17 @@ void RingModParameters::detachControls()
 {
     carrierFreqAttachment.reset(nullptr);
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     lfoFreqAttachment.reset(nullptr);
     lfoWidthAttachment.reset(nullptr);
 }
 
 void RingModParameters::attachControls(Slider& carrierFreqKnob,
-                                       ComboBox& lfoWaveformCombo, Slider& lfoFreqKnob, Slider& lfoWidthKnob)
+                                       ComboBox& lfoWaveformCombo, ComboBox& lfoSyncCombo, Slider& lfoFreqKnob, Slider& lfoWidthKnob)
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
     carrierFreqAttachment.reset(new SlAt(valueTreeState, carrierFreqID, carrierFreqKnob));
     lfoFreqAttachment.reset(new SlAt(valueTreeState, lfoFreqID, lfoFreqKnob));
@@ -10,6 +10,7 @@ public:
     // Labels are supplementary, typically used for units of measure
     static const String carrierFreqID, carrierFreqName, carrierFreqLabel;
     static const String lfoWaveformID, lfoWaveformName, lfoWaveformLabel;
+    static const String lfoSyncID, lfoSyncName, lfoSyncLabel;
     static const String lfoFreqID, lfoFreqName, lfoFreqLabel;
     static const String lfoWidthID, lfoWidthName, lfoWidthLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -20,13 +21,14 @@ public:
 
     void detachControls();
     void attachControls(Slider& carrierFreqKnob,
-                        ComboBox& lfoWaveformCombo, Slider& lfoFreqKnob, Slider& lfoWidthKnob);
+                        ComboBox& lfoWaveformCombo, ComboBox& lfoSyncCombo, Slider& lfoFreqKnob, Slider& lfoWidthKnob);
 
     // working parameter values
-    float carrierFreqHz;
+    SmoothedParameter carrierFreqHz;
     RingModLFO::Waveform lfoWaveform;
-    float lfoFreqHz;
-    float lfoWidthHz;
+    BlockLFO::Sync lfoSync;
+    SmoothedParameter lfoFreqHz;
+    SmoothedParameter lfoWidthHz;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -35,12 +37,14 @@ private:
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> carrierFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoSyncAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoWidthAttachment;
 
     // Listener objects link parameters to working variables
-    FloatListener carrierFreqListener;
+    SmoothedFloatListener carrierFreqListener;
     EnumListener<RingModLFO::Waveform> lfoWaveformListener;
-    FloatListener lfoFreqListener;
-    FloatListener lfoWidthListener;
+    EnumListener<BlockLFO::Sync> lfoSyncListener;
+    SmoothedFloatListener lfoFreqListener;
+    SmoothedFloatListener lfoWidthListener;
 };
@@ -31,11 +31,18 @@ RingModProcessor::~RingModProcessor()
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void RingModProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void RingModProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     carrierPhase = 0.0f;
-    lfoPhase = 0.0f;
     inverseSampleRate = 1.0 / sampleRate;
+    lfo.prepare(sampleRate, maxSamplesPerBlock);
+
+    parameters.carrierFreqHz.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.lfoFreqHz.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.lfoWidthHz.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -45,13 +52,32 @@ void RingModProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void RingModProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo and position at the start of each block
+    lfo.setSync(parameters.lfoSync);
+    lfo.syncToPlayHead(getPlayHead());
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void RingModProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
-    // local copies of state variables carrierPhase and lfoPhase
+    // Smoothed parameter values, for every sample of this block
+    const float* carrierFreqHz = parameters.carrierFreqHz.getNextBlock(buffer.getNumSamples());
+    const float* lfoFreqHz = parameters.lfoFreqHz.getNextBlock(buffer.getNumSamples());
+    const float* lfoWidthHz = parameters.lfoWidthHz.getNextBlock(buffer.getNumSamples());
+
+    // Render this block of LFO output once, for all channels, scaled to the range [-1, +1]
+    lfo.advance(buffer.getNumSamples(), lfoFreqHz);
+    float* lfoOut = lfo.render(0, RingModLFO::getBlockWaveform(parameters.lfoWaveform), buffer.getNumSamples());
+    for (int i = 0; i < buffer.getNumSamples(); i++)
+        lfoOut[i] = 2.0f * lfoOut[i] - 1.0f;
+
+    // local copy of state variable carrierPhase
     float cphi = carrierPhase;
-    float lphi = lfoPhase;
-    float dlphi = float(parameters.lfoFreqHz * inverseSampleRate);
 
     // apply the same modulation to all input channels for which there is an output channel
     int channelIndex = 0;
@@ -59,7 +85,6 @@ void RingModProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     {
         // restart the phase sequence
         cphi = carrierPhase;
-        lphi = lfoPhase;
 
         const float* pIn = buffer.getReadPointer(channelIndex);
         float* pOut = buffer.getWritePointer(channelIndex);
@@ -74,21 +99,15 @@ void RingModProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
             *pOut++ = *pIn++ * carrier;
 
             // Update carrier phase with FM, keeping in range [0, 1]
-            float lfo = RingModLFO::getSample(lphi, parameters.lfoWaveform);
-            float deltaCarrierHz = parameters.lfoWidthHz * lfo;
-            float dcphi = float((parameters.carrierFreqHz + deltaCarrierHz) * inverseSampleRate);
+            float deltaCarrierHz = lfoWidthHz[i] * lfoOut[i];
+            float dcphi = float((carrierFreqHz[i] + deltaCarrierHz) * inverseSampleRate);
             cphi += dcphi;
             while (cphi >= 1.0) cphi -= 1.0;
-
-            // Update LFO phase, keeping in range [0, 1]
-            lphi += dlphi;
-            while (lphi >= 1.0) lphi -= 1.0;
         }
     }
 
-    // update the main phase state variables, ready for the next processBlock() call
+    // update the main phase state variable, ready for the next processBlock() call
     carrierPhase = cphi;
-    lfoPhase = lphi;
 
     // clear any remaining/excess output channels to zero
     for (; channelIndex < getTotalNumOutputChannels(); channelIndex++)
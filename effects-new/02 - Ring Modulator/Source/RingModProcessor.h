@@ -1,8 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "RingModParameters.h"
+#include "AutomationScheduler.h"
+#include "BlockLFO.h"
 
 class RingModProcessor : public AudioProcessor
+                       , public AutomationScheduler::Owner
 {
 public:
     RingModProcessor();
@@ -29,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -41,9 +47,13 @@ public:
     RingModParameters parameters;
 
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
     float carrierPhase;         // Phase of carrier, range [0, 1]
-    float lfoPhase;             // Phase of the low-frequency oscillator, range [0, 1]
     double inverseSampleRate;   // 1/(sample rate Hz)
+    BlockLFO lfo;               // Renders each block's carrier frequency modulation once
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RingModProcessor)
 };
@@ -10,6 +10,7 @@ CompressorEditor::CompressorEditor (CompressorProcessor& p)
     , releaseKnob(0.1f, 1000.0f, "ms"), labeledReleaseKnob("Release", releaseKnob)
     , thresholdKnob(-60.0f, 0.0f, "dB"), labeledThresholdKnob("Threshold", thresholdKnob)
     , gainKnob(0.0f, 40.0f, "dB"), labeledGainKnob("Gain", gainKnob)
+    , lookaheadKnob(0.0f, CompressorParameters::lookaheadMaxMs, "ms"), labeledLookaheadKnob("Lookahead", lookaheadKnob)
 {
     setLookAndFeel(lookAndFeel);
 
@@ -19,6 +20,15 @@ CompressorEditor::CompressorEditor (CompressorProcessor& p)
     barGraph.setValue(1.0f);
     addAndMakeVisible(&barGraph);
 
+    detectorLabel.setText("Detector", dontSendNotification);
+    detectorLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&detectorLabel);
+
+    detectorCombo.setEditableText(false);
+    detectorCombo.setJustificationType(Justification::centredLeft);
+    CompressorGainComputer::populateDetectorComboBox(detectorCombo);
+    addAndMakeVisible(detectorCombo);
+
     ratioKnob.setDoubleClickReturnValue(true, 0.1, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledRatioKnob);
 
@@ -34,16 +44,21 @@ CompressorEditor::CompressorEditor (CompressorProcessor& p)
     gainKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledGainKnob);
 
-    processor.parameters.attachControls(ratioKnob, attackKnob, releaseKnob, thresholdKnob, gainKnob);
+    lookaheadKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledLookaheadKnob);
 
-    processor.addChangeListener(this);
+    processor.parameters.attachControls(ratioKnob, attackKnob, releaseKnob, thresholdKnob, gainKnob,
+                                        detectorCombo, lookaheadKnob);
 
-    setSize (600, 200);
+    // Update the bar graph 30 times a second, from processor's meter readings
+    startTimerHz(30);
+
+    setSize (700, 234);
 }
 
 CompressorEditor::~CompressorEditor()
 {
-    processor.removeChangeListener(this);
+    stopTimer();
     processor.parameters.detachControls();
     setLookAndFeel(nullptr);
 }
@@ -56,8 +71,12 @@ void CompressorEditor::resized()
     auto widgetsArea = bounds.reduced(10);
     widgetsArea.removeFromTop(20);
     barGraph.setBounds(widgetsArea.removeFromTop(8).reduced(20, 0));
+    widgetsArea.removeFromTop(10);
+    auto detectorArea = widgetsArea.removeFromTop(24).withSizeKeepingCentre(240, 24);
+    detectorLabel.setBounds(detectorArea.removeFromLeft(80));
+    detectorCombo.setBounds(detectorArea);
     widgetsArea.removeFromTop(12);
-    int width = (widgetsArea.getWidth() - 4 * 10) / 5;
+    int width = (widgetsArea.getWidth() - 5 * 10) / 6;
     labeledRatioKnob.setBounds(widgetsArea.removeFromLeft(width));
     widgetsArea.removeFromLeft(10);
     labeledAttackKnob.setBounds(widgetsArea.removeFromLeft(width));
@@ -66,7 +85,9 @@ void CompressorEditor::resized()
     widgetsArea.removeFromLeft(10);
     labeledThresholdKnob.setBounds(widgetsArea.removeFromLeft(width));
     widgetsArea.removeFromLeft(10);
-    labeledGainKnob.setBounds(widgetsArea);
+    labeledGainKnob.setBounds(widgetsArea.removeFromLeft(width));
+    widgetsArea.removeFromLeft(10);
+    labeledLookaheadKnob.setBounds(widgetsArea);
 }
 
 void CompressorEditor::paint (Graphics& g)
@@ -75,7 +96,9 @@ void CompressorEditor::paint (Graphics& g)
     g.fillAll(lookAndFeel->findColour(ResizableWindow::backgroundColourId));
 }
 
-void CompressorEditor::changeListenerCallback(ChangeBroadcaster*)
+void CompressorEditor::timerCallback()
 {
-    barGraph.setValue(processor.currentGain);
+    MeterFrame frame;
+    if (processor.meterRing.read(frame) > 0)
+        barGraph.setValue(frame.gain);
 }
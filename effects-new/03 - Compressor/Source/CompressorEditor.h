@@ -5,7 +5,7 @@
 #include "LabeledKnob.h"
 #include "DecibelKnob.h"
 
-class CompressorEditor  : public AudioProcessorEditor, public ChangeListener
+class CompressorEditor  : public AudioProcessorEditor, protected Timer
 {
 public:
     CompressorEditor (CompressorProcessor&);
@@ -15,8 +15,9 @@ public:
     void paint (Graphics&) override;
     void resized() override;
 
-    // ChangeListener
-    void changeListenerCallback(ChangeBroadcaster*) override;
+protected:
+    // Timer: polls the processor's meterRing
+    void timerCallback() override;
 
 private:
     SharedResourcePointer<BasicLookAndFeel> lookAndFeel;
@@ -25,11 +26,14 @@ private:
     GroupComponent compressionGroup;
 
     BarGraph barGraph;
+    Label detectorLabel;
+    ComboBox detectorCombo;
     BasicKnob ratioKnob; LabeledKnob labeledRatioKnob;
     BasicKnob attackKnob; LabeledKnob labeledAttackKnob;
     BasicKnob releaseKnob; LabeledKnob labeledReleaseKnob;
     BasicKnob thresholdKnob; LabeledKnob labeledThresholdKnob;
     BasicKnob gainKnob; LabeledKnob labeledGainKnob;
+    BasicKnob lookaheadKnob; LabeledKnob labeledLookaheadKnob;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressorEditor)
 };
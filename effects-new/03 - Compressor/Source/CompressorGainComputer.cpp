@@ -0,0 +1,80 @@
+#include "CompressorGainComputer.h"
+#include "FastMath.h"
+
+void CompressorGainComputer::populateDetectorComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Mix Down", ++itemNumber);
+    cb.addItem("Loudest Channel", ++itemNumber);
+}
+
+void CompressorGainComputer::computeDetectorInput(const float* const* channels, int numChannels,
+                                                  float* detectorInput, int numSamples, Detector detector)
+{
+    if (numChannels < 1)
+    {
+        FloatVectorOperations::clear(detectorInput, numSamples);
+        return;
+    }
+
+    if (detector == kLoudestChannel)
+    {
+        FloatVectorOperations::copy(detectorInput, channels[0], numSamples);
+        for (int ch = 1; ch < numChannels; ++ch)
+        {
+            const float* __restrict in = channels[ch];
+            float* __restrict out = detectorInput;
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = FastMath::max(FastMath::abs(out[i]), FastMath::abs(in[i]));
+        }
+    }
+    else
+    {
+        const float scale = 1.0f / numChannels;
+        FloatVectorOperations::copyWithMultiply(detectorInput, channels[0], scale, numSamples);
+        for (int ch = 1; ch < numChannels; ++ch)
+            FloatVectorOperations::addWithMultiply(detectorInput, channels[ch], scale, numSamples);
+    }
+}
+
+void CompressorGainComputer::computeGainReduction(const float* __restrict input, float* __restrict gainReductionDB,
+                                                  int numSamples, float thresholdDB, float ratio)
+{
+    // Above threshold, output level is T + (x_g - T) / R, so gain reduction is (x_g - T) * (1 - 1/R)
+    const float slope = 1.0f - 1.0f / ratio;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Level detection- peak level in dB, floored at -120 dB (1e-6)
+        float x_g = FastMath::gainToDecibels(FastMath::max(FastMath::abs(input[i]), 0.000001f));
+
+        // Gain computer- static input/output curve
+        gainReductionDB[i] = slope * FastMath::max(x_g - thresholdDB, 0.0f);
+    }
+}
+
+float CompressorGainComputer::applyBallistics(float* gainReductionDB, int numSamples,
+                                              float alphaAttack, float alphaRelease, float& yL_prev)
+{
+    float y_l = yL_prev;
+    float sum = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float x_l = gainReductionDB[i];
+        float alpha = (x_l > y_l) ? alphaAttack : alphaRelease;
+        y_l = alpha * y_l + (1.0f - alpha) * x_l;
+        gainReductionDB[i] = y_l;
+        sum += y_l;
+    }
+
+    yL_prev = y_l;
+    return sum;
+}
+
+void CompressorGainComputer::computeControlGain(float* gainReductionDB, int numSamples, float makeUpGainDB)
+{
+    for (int i = 0; i < numSamples; ++i)
+        gainReductionDB[i] = FastMath::decibelsToGain(makeUpGainDB - gainReductionDB[i]);
+}
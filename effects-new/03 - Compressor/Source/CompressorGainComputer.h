@@ -0,0 +1,41 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  CompressorGainComputer: the per-sample math of CompressorProcessor::computeCompressionGain(),
+    split into three passes over a single scratch array, preceded by computeDetectorInput(), which
+    reduces any number of channels (main or sidechain input) to the one signal which drives them:
+    1. computeGainReduction(): level detection and static gain curve. No sample depends on
+       any other, so this loop is vectorized by the compiler.
+    2. applyBallistics(): attack/release smoothing. This is a recursion, so it stays scalar,
+       but it is now only a compare and two multiply-adds per sample.
+    3. computeControlGain(): converts the smoothed gain reduction to a linear gain. Vectorized.
+    Decibel conversions use FastMath's approximations (within 0.0002 dB) in place of log10()/pow().
+*/
+
+struct CompressorGainComputer
+{
+    enum Detector
+    {
+        kMixDown = 0,       // average of all channels (for stereo, R&M's original (L + R) / 2)
+        kLoudestChannel,    // largest magnitude of any channel, so no channel can exceed threshold
+        kNumDetectors
+    };
+
+    static void populateDetectorComboBox(ComboBox& cb);
+
+    // Reduces numChannels input channels to a single detector signal
+    static void computeDetectorInput(const float* const* channels, int numChannels,
+                                     float* detectorInput, int numSamples, Detector detector);
+
+    // Writes the gain reduction (dB, >= 0) which the static curve calls for, for each input sample
+    static void computeGainReduction(const float* input, float* gainReductionDB, int numSamples,
+                                     float thresholdDB, float ratio);
+
+    // Smooths gain reduction in place; yL_prev carries the filter state from block to block.
+    // Returns the sum of the smoothed values (for averaging, e.g. for GUI display).
+    static float applyBallistics(float* gainReductionDB, int numSamples,
+                                 float alphaAttack, float alphaRelease, float& yL_prev);
+
+    // Converts smoothed gain reduction (dB) to linear control gain, in place
+    static void computeControlGain(float* gainReductionDB, int numSamples, float makeUpGainDB);
+};
@@ -17,6 +17,13 @@ const String CompressorParameters::thresholdLabel = TRANS("dB");
 const String CompressorParameters::gainID = "gain";
 const String CompressorParameters::gainName = TRANS("Make-Up Gain");
 const String CompressorParameters::gainLabel = TRANS("dB");
+const String CompressorParameters::detectorID = "detector";
+const String CompressorParameters::detectorName = TRANS("Detector");
+const String CompressorParameters::detectorLabel = "";
+const String CompressorParameters::lookaheadID = "lookahead";
+const String CompressorParameters::lookaheadName = TRANS("Lookahead");
+const String CompressorParameters::lookaheadLabel = TRANS("ms");
+const float CompressorParameters::lookaheadMaxMs = 10.0f;
 
 AudioProcessorValueTreeState::ParameterLayout CompressorParameters::createParameterLayout()
 {
@@ -62,26 +69,47 @@ AudioProcessorValueTreeState::ParameterLayout CompressorParameters::createParame
         [](float value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getFloatValue(); }));
 
+    params.push_back(std::make_unique<AudioParameterInt>(
+        detectorID, detectorName,
+        0, CompressorGainComputer::kNumDetectors - 1, CompressorGainComputer::kMixDown,
+        detectorLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+
+    params.push_back(std::make_unique<AudioParameterFloat>(
+        lookaheadID, lookaheadName,
+        NormalisableRange<float>(0.0f, lookaheadMaxMs, 0.1f), 0.0f,
+        lookaheadLabel,
+        AudioProcessorParameter::genericParameter,
+        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getFloatValue(); }));
+
     return { params.begin(), params.end() };
 }
 
-CompressorParameters::CompressorParameters(AudioProcessorValueTreeState& vts)
+CompressorParameters::CompressorParameters(AudioProcessorValueTreeState& vts,
+                                           AudioProcessorValueTreeState::Listener* processor)
     : compressionRatio(1.0f)
     , attackTimeMs(15.0f), releaseTimeMs(100.0f)
     , threshold(0.0f)
     , makeUpGain(0.0f)
+    , detector(CompressorGainComputer::kMixDown)
     , valueTreeState(vts)
     , ratioListener(compressionRatio)
     , attackListener(attackTimeMs)
     , releaseListener(releaseTimeMs)
     , thresholdListener(threshold)
     , gainListener(makeUpGain)
+    , detectorListener(detector)
+    , processorAsListener(processor)
 {
     valueTreeState.addParameterListener(ratioID, &ratioListener);
     valueTreeState.addParameterListener(attackID, &attackListener);
     valueTreeState.addParameterListener(releaseID, &releaseListener);
     valueTreeState.addParameterListener(thresholdID, &thresholdListener);
     valueTreeState.addParameterListener(gainID, &gainListener);
+    valueTreeState.addParameterListener(detectorID, &detectorListener);
+    valueTreeState.addParameterListener(lookaheadID, processorAsListener);
 }
 
 CompressorParameters::~CompressorParameters()
@@ -92,6 +120,8 @@ CompressorParameters::~CompressorParameters()
     valueTreeState.removeParameterListener(releaseID, &releaseListener);
     valueTreeState.removeParameterListener(thresholdID, &thresholdListener);
     valueTreeState.removeParameterListener(gainID, &gainListener);
+    valueTreeState.removeParameterListener(detectorID, &detectorListener);
+    valueTreeState.removeParameterListener(lookaheadID, processorAsListener);
 }
 
 void CompressorParameters::detachControls()
@@ -101,15 +131,21 @@ void CompressorParameters::detachControls()
     releaseAttachment.reset(nullptr);
     thresholdAttachment.reset(nullptr);
     gainAttachment.reset(nullptr);
+    detectorAttachment.reset(nullptr);
+    lookaheadAttachment.reset(nullptr);
 }
 
 void CompressorParameters::attachControls(Slider& ratioKnob, Slider& attackKnob, Slider& releaseKnob,
-                                          Slider& thresholdKnob, Slider& gainKnob)
+                                          Slider& thresholdKnob, Slider& gainKnob, ComboBox& detectorCombo,
+                                          Slider& lookaheadKnob)
 {
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
+    using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     ratioAttachment.reset(new SlAt(valueTreeState, ratioID, ratioKnob));
     attackAttachment.reset(new SlAt(valueTreeState, attackID, attackKnob));
     releaseAttachment.reset(new SlAt(valueTreeState, releaseID, releaseKnob));
     thresholdAttachment.reset(new SlAt(valueTreeState, thresholdID, thresholdKnob));
     gainAttachment.reset(new SlAt(valueTreeState, gainID, gainKnob));
+    detectorAttachment.reset(new CbAt(valueTreeState, detectorID, detectorCombo));
+    lookaheadAttachment.reset(new SlAt(valueTreeState, lookaheadID, lookaheadKnob));
 }
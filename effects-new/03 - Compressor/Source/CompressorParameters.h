@@ -1,6 +1,7 @@
 #pragma once
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
+#include "CompressorGainComputer.h"
 
 class CompressorParameters
 {
@@ -12,21 +13,27 @@ public:
     static const String releaseID, releaseName, releaseLabel;
     static const String thresholdID, thresholdName, thresholdLabel;
     static const String gainID, gainName, gainLabel;
+    static const String detectorID, detectorName, detectorLabel;
+    static const String lookaheadID, lookaheadName, lookaheadLabel;
+    static const float lookaheadMaxMs;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
-    CompressorParameters(AudioProcessorValueTreeState& vts);
+    CompressorParameters(AudioProcessorValueTreeState& vts,
+                         AudioProcessorValueTreeState::Listener* processor);
     ~CompressorParameters();
 
     void detachControls();
     void attachControls(Slider& ratioKnob, Slider& attackKnob, Slider& releaseKnob,
-                        Slider& thresholdKnob, Slider& gainKnob);
+                        Slider& thresholdKnob, Slider& gainKnob, ComboBox& detectorCombo,
+                        Slider& lookaheadKnob);
 
     // working parameter values
     float compressionRatio;
     float attackTimeMs, releaseTimeMs;
     float threshold;
     float makeUpGain;
+    CompressorGainComputer::Detector detector;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -38,6 +45,8 @@ private:
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> releaseAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> thresholdAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> gainAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> detectorAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lookaheadAttachment;
 
     // Listener objects link parameters to working variables
     FloatListener ratioListener;
@@ -45,4 +54,8 @@ private:
     FloatListener releaseListener;
     FloatListener thresholdListener;
     FloatListener gainListener;
+    EnumListener<CompressorGainComputer::Detector> detectorListener;
+
+    // Processor listens for lookahead changes itself, and applies them at the start of a block
+    AudioProcessorValueTreeState::Listener* processorAsListener;
 };
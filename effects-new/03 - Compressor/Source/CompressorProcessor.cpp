@@ -1,5 +1,6 @@
 #include "CompressorProcessor.h"
 #include "CompressorEditor.h"
+#include "CompressorGainComputer.h"
 
 // Instantiate this plugin
 AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -13,15 +14,23 @@ AudioProcessorEditor* CompressorProcessor::createEditor()
     return new CompressorEditor(*this);
 }
 
-// Constructor: start off assuming stereo input, stereo output
+// Constructor: start off assuming stereo input, stereo output, and an optional
+// sidechain input, which the host must enable
 CompressorProcessor::CompressorProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput  ("Input",  AudioChannelSet::stereo(), true)
                      .withOutput ("Output", AudioChannelSet::stereo(), true)
+                     .withInput  ("Sidechain", AudioChannelSet::stereo(), false)
                      )
+    , currentGain(1.0f)
     , valueTreeState(*this, nullptr, Identifier(JucePlugin_Name), CompressorParameters::createParameterLayout())
-    , parameters(valueTreeState)
+    , parameters(valueTreeState, this)
     , inputBuffer(1, 1)
+    , lookaheadBufferLength(1)
+    , lookaheadWritePosition(0)
+    , lookaheadSamples(0)
+    , lookaheadTargetMs(0.0f)
+    , latencyReporter(*this)
 {
 }
 
@@ -30,116 +39,185 @@ CompressorProcessor::~CompressorProcessor()
 {
 }
 
+void CompressorProcessor::parameterChanged(const String& parameterID, float newValue)
+{
+    if (parameterID == CompressorParameters::lookaheadID)
+        lookaheadTargetMs.store(newValue);
+}
+
+// Main input and output may have any channel layout (mono, stereo, 5.1, 7.1, ...), so long as
+// they match. The sidechain input may have any number of channels, or be disabled.
+bool CompressorProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    auto mainInput = layouts.getMainInputChannelSet();
+    return !mainInput.isDisabled() && mainInput == layouts.getMainOutputChannelSet();
+}
+
 // Prepare to process audio (always called at least once before processBlock)
 void CompressorProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     samplerate = int(sampleRate);
     bufferSize = maxSamplesPerBlock;
 
-    x_g.allocate(bufferSize, true);
-    x_l.allocate(bufferSize, true);
-    y_g.allocate(bufferSize, true);
-    y_l.allocate(bufferSize, true);
+    inputBuffer.setSize(1, bufferSize);
     c.allocate(bufferSize, true);
-    yL_prev = 0;
     autoTime = false;
 
     yL_prev = 0;
-    for (int i = 0; i < bufferSize; ++i)
-    {
-        x_g[i] = y_g[i] = 0.0f;
-        x_l[i] = y_l[i] = 0.0f;
-        c[i] = 0.0f;
-    }
+
+    // Allocate and zero the lookahead delay, long enough for the maximum lookahead at this sample rate
+    int maxLookaheadSamples = roundToInt(0.001 * CompressorParameters::lookaheadMaxMs * sampleRate);
+    lookaheadBufferLength = maxLookaheadSamples + 1;
+    lookaheadBuffer.setSize(getMainBusNumInputChannels(), lookaheadBufferLength);
+    lookaheadBuffer.clear();
+    lookaheadWritePosition = 0;
+    peakDetector.prepare(lookaheadBufferLength);
+    updateLookahead();
+    latencyReporter.setLatencySamplesNow(lookaheadSamples);
+}
+
+// Convert the latest lookahead time to samples, for both the delay and the peak detector
+void CompressorProcessor::updateLookahead()
+{
+    lookaheadSamples = jlimit(0, lookaheadBufferLength - 1,
+                              roundToInt(0.001 * lookaheadTargetMs.load() * getSampleRate()));
+    peakDetector.setWindowLength(lookaheadSamples + 1);
 }
 
 // Audio processing finished; release any allocated memory
 void CompressorProcessor::releaseResources()
 {
-    x_g.free();
-    x_l.free();
-    y_g.free();
-    y_l.free();
     c.free();
+    lookaheadBuffer.setSize(0, 0);
 }
 
 // Process one buffer ("block") of data
 void CompressorProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void CompressorProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
-    int M = getTotalNumInputChannels() / 2;
-    inputBuffer.setSize(M, bufferSize);
+    // A lookahead change takes effect here, for the delay and the detector alike, and the host
+    // hears about it (only if it has changed) from the message thread
+    updateLookahead();
+    latencyReporter.setLatencySamples(lookaheadSamples);
+
+    int numSamples = buffer.getNumSamples();
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    bool compressing = parameters.threshold < 0.0f;
 
-    for (int m = 0; m < M; ++m)
+    if (compressing)
     {
-        if ((parameters.threshold < 0.0f))
+        // All channels are compressed together, driven by one detector signal (linked),
+        // derived from the sidechain input if the host has enabled it, or else from the main input
+        computeDetectorInput(buffer, numSamples);
+
+        // Lookahead: detect the peak over the window of input which the delayed audio is about to play
+        if (lookaheadSamples > 0)
         {
-            // Mix down left-right to analyse the input (feedforward)
-            inputBuffer.clear(m, 0, bufferSize);
-            inputBuffer.addFrom(m, 0, buffer, m * 2, 0, bufferSize, 0.5f);
-            inputBuffer.addFrom(m, 0, buffer, m * 2 + 1, 0, bufferSize, 0.5f);
-
-            // compression : calculates the control voltage
-            computeCompressionGain(inputBuffer, m);
-
-            // apply control voltage to the audio signal
-            const float *pIL = buffer.getReadPointer(2 * m + 0);
-            const float *pIR = buffer.getReadPointer(2 * m + 1);
-            float* pOL = buffer.getWritePointer(2 * m + 0);
-            float* pOR = buffer.getWritePointer(2 * m + 1);
-            for (int i = 0; i < bufferSize; ++i)
-            {
-                float cv = c[i];
-                *pOL++ = cv * *pIL++;
-                *pOR++ = cv * *pIR++;
-            }
-
-            // Mix down left-right to analyse the output (feedback)
-            //inputBuffer.clear(m, 0, bufferSize);
-            //inputBuffer.addFrom(m, 0, buffer, m * 2, 0, bufferSize, 0.5f);
-            //inputBuffer.addFrom(m, 0, buffer, m * 2 + 1, 0, bufferSize, 0.5f);
+            float* detector = inputBuffer.getWritePointer(0);
+            for (int i = 0; i < numSamples; ++i)
+                detector[i] = peakDetector.process(std::abs(detector[i]));
         }
+
+        // compression : calculates the control voltage
+        computeCompressionGain(inputBuffer, 0, numSamples);
+    }
+
+    // Delay the audio even when not compressing, so the latency reported to the host always holds
+    delayAudio(mainBuffer, numSamples);
+
+    if (compressing)
+    {
+        // apply control voltage to the audio signal
+        for (int ch = 0; ch < mainBuffer.getNumChannels(); ++ch)
+            FloatVectorOperations::multiply(mainBuffer.getWritePointer(ch), c, numSamples);
     }
+    else currentGain = 1.0f;
+
+    pushMeterFrame(mainBuffer, numSamples);
 }
 
-void CompressorProcessor::computeCompressionGain(AudioSampleBuffer &buffer, int m)
+// Summarize this block's gain and output levels for the GUI (which polls meterRing)
+void CompressorProcessor::pushMeterFrame(AudioSampleBuffer &mainBuffer, int numSamples)
 {
-    float alphaAttack = exp(-1.0f / (0.001f * samplerate * parameters.attackTimeMs));
-    float alphaRelease = exp(-1.0f / (0.001f * samplerate * parameters.releaseTimeMs));
+    int numChannels = mainBuffer.getNumChannels();
+    float peak = 0.0f, sumOfSquares = 0.0f;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        peak = jmax(peak, mainBuffer.getMagnitude(ch, 0, numSamples));
+        float rms = mainBuffer.getRMSLevel(ch, 0, numSamples);
+        sumOfSquares += rms * rms;
+    }
+
+    MeterFrame frame = { currentGain, peak, std::sqrt(sumOfSquares / jmax(1, numChannels)) };
+    meterRing.push(frame);
+}
 
-    float yl_avg = 0.0f;
+// Delay the main channels by lookaheadSamples, using the lookaheadBuffer ring buffer
+void CompressorProcessor::delayAudio(AudioSampleBuffer &mainBuffer, int numSamples)
+{
+    int numChannels = jmin(mainBuffer.getNumChannels(), lookaheadBuffer.getNumChannels());
+    int dpw = lookaheadWritePosition;
 
-    for (int i = 0; i < bufferSize; ++i)
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        // Level detection- estimate level using peak detector
-        if (fabs(buffer.getWritePointer(m)[i]) < 0.000001f) x_g[i] = -120;
-        else x_g[i] = 20 * log10(fabs(buffer.getWritePointer(m)[i]));
-
-        // Gain computer- static apply input/output curve
-        if (x_g[i] >= parameters.threshold)
-            y_g[i] = parameters.threshold + (x_g[i] - parameters.threshold) / parameters.compressionRatio;
-        else
-            y_g[i] = x_g[i];
-        x_l[i] = x_g[i] - y_g[i];
-
-        // Ballistics- smoothing of the gain 
-        if (x_l[i] > yL_prev)
-            y_l[i] = alphaAttack * yL_prev + (1 - alphaAttack) * x_l[i];
-        else
-            y_l[i] = alphaRelease * yL_prev + (1 - alphaRelease) * x_l[i];
-
-        // Accumulate averaged gain for the whole buffer (for GUI display)
-        yl_avg += y_l[i];
-
-        // find control
-        c[i] = pow(10.0f, (parameters.makeUpGain - y_l[i]) / 20.0f);
-        yL_prev = y_l[i];
+        float* channelData = mainBuffer.getWritePointer(ch);
+        float* delayData = lookaheadBuffer.getWritePointer(ch);
+        dpw = lookaheadWritePosition;
+        int dpr = dpw - lookaheadSamples;
+        if (dpr < 0) dpr += lookaheadBufferLength;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // write before read, so zero lookahead passes audio straight through
+            delayData[dpw] = channelData[i];
+            channelData[i] = delayData[dpr];
+            if (++dpw >= lookaheadBufferLength) dpw = 0;
+            if (++dpr >= lookaheadBufferLength) dpr = 0;
+        }
     }
 
-    yl_avg /= bufferSize;
+    lookaheadWritePosition = dpw;
+}
+
+void CompressorProcessor::computeDetectorInput(AudioSampleBuffer &buffer, int numSamples)
+{
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    auto sidechainBuffer = getBusCount(true) > 1 ? getBusBuffer(buffer, true, 1) : AudioSampleBuffer();
+    auto& detectorSource = sidechainBuffer.getNumChannels() > 0 ? sidechainBuffer : mainBuffer;
+
+    CompressorGainComputer::computeDetectorInput(detectorSource.getArrayOfReadPointers(),
+                                                 detectorSource.getNumChannels(),
+                                                 inputBuffer.getWritePointer(0), numSamples,
+                                                 parameters.detector);
+}
+
+void CompressorProcessor::computeCompressionGain(AudioSampleBuffer &buffer, int m, int numSamples)
+{
+    float alphaAttack = exp(-1.0f / (0.001f * samplerate * parameters.attackTimeMs));
+    float alphaRelease = exp(-1.0f / (0.001f * samplerate * parameters.releaseTimeMs));
+
+    // Level detection and gain computer- static apply input/output curve
+    CompressorGainComputer::computeGainReduction(buffer.getReadPointer(m), c, numSamples,
+                                                 parameters.threshold, parameters.compressionRatio);
+
+    // Ballistics- smoothing of the gain, accumulating the total for the whole buffer (for GUI display)
+    float yl_avg = CompressorGainComputer::applyBallistics(c, numSamples, alphaAttack, alphaRelease, yL_prev);
+
+    // find control
+    CompressorGainComputer::computeControlGain(c, numSamples, parameters.makeUpGain);
+
+    yl_avg /= jmax(1, numSamples);
     currentGain = pow(10.0f, -yl_avg / 20.0f);
-    sendChangeMessage();
 }
 
 // Called by the host when it needs to persist the current plugin state
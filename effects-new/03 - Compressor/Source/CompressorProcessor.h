@@ -1,8 +1,14 @@
 #pragma once
 #include "JuceHeader.h"
 #include "CompressorParameters.h"
+#include "SlidingMaximum.h"
+#include "MeterRing.h"
+#include "AutomationScheduler.h"
+#include "LatencyReporter.h"
 
-class CompressorProcessor : public AudioProcessor, public ChangeBroadcaster
+class CompressorProcessor : public AudioProcessor
+                          , public AudioProcessorValueTreeState::Listener
+                          , public AutomationScheduler::Owner
 {
 public:
     CompressorProcessor();
@@ -13,7 +19,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
-    //bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     bool hasEditor() const override { return true; }
     AudioProcessorEditor* createEditor() override;
 
@@ -29,15 +35,28 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    // Computed linear gain (for GUI display)
+    // Responding to parameter changes (lookahead only; any thread)
+    void parameterChanged(const String&, float) override;
+
+    // Computed linear gain, averaged over the most recent block
     float currentGain;
 
+    // Per-block gain and output levels, for GUI display
+    MeterRing meterRing;
+
 protected:
-    void computeCompressionGain(AudioSampleBuffer &buffer, int m);
+    void computeCompressionGain(AudioSampleBuffer &buffer, int m, int numSamples);
+    void computeDetectorInput(AudioSampleBuffer &buffer, int numSamples);
+    void updateLookahead();
+    void delayAudio(AudioSampleBuffer &mainBuffer, int numSamples);
+    void pushMeterFrame(AudioSampleBuffer &mainBuffer, int numSamples);
 
 public:
     // Plugin's AudioProcessorValueTreeState, and its associated UndoManager
@@ -48,11 +67,29 @@ public:
 
     int bufferSize;
     bool autoTime;
-    AudioSampleBuffer inputBuffer;
-    HeapBlock <float> x_g, x_l, y_g, y_l, c; // input, output, control
+    AudioSampleBuffer inputBuffer;  // single-channel detector signal, sized in prepareToPlay()
+    HeapBlock <float> c;   // control gain (gain reduction in dB while it is being computed)
     float yL_prev;
     int samplerate;
 
+    // Lookahead: the audio is delayed by lookaheadSamples, while the detector sees the peak
+    // level over the same span of (undelayed) input, so gain reduction starts before a peak arrives
+    AudioSampleBuffer lookaheadBuffer;
+    int lookaheadBufferLength;
+    int lookaheadWritePosition;
+    int lookaheadSamples;
+    SlidingMaximum peakDetector;
+
+    // The lookahead time the listener last saw, applied at the start of the next sub-block, so
+    // the delay and the detector always agree; the resulting latency goes to the host from the
+    // message thread
+    std::atomic<float> lookaheadTargetMs;
+    LatencyReporter latencyReporter;
+
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressorProcessor)
 };
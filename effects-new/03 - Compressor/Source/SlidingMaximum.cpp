@@ -0,0 +1,57 @@
+#include "SlidingMaximum.h"
+
+SlidingMaximum::SlidingMaximum()
+    : capacity(0)
+    , head(0), size(0)
+    , windowLength(1)
+    , sampleCount(0)
+{
+}
+
+void SlidingMaximum::prepare(int maxWindowLength)
+{
+    capacity = jmax(1, maxWindowLength);
+    values.allocate(capacity, true);
+    indices.allocate(capacity, true);
+    windowLength = jlimit(1, capacity, windowLength);
+    reset();
+}
+
+void SlidingMaximum::reset()
+{
+    head = size = 0;
+    sampleCount = 0;
+}
+
+void SlidingMaximum::setWindowLength(int length)
+{
+    windowLength = jlimit(1, jmax(1, capacity), length);
+}
+
+float SlidingMaximum::process(float value)
+{
+    // Values older than the window have expired
+    while (size > 0 && sampleCount - indices[head] >= unsigned(windowLength))
+    {
+        if (++head == capacity) head = 0;
+        --size;
+    }
+
+    // Values no larger than the new one can never be the maximum again
+    while (size > 0)
+    {
+        int back = head + size - 1;
+        if (back >= capacity) back -= capacity;
+        if (values[back] > value) break;
+        --size;
+    }
+
+    // The queue can't overflow: it only ever holds values from the last windowLength samples
+    int tail = head + size;
+    if (tail >= capacity) tail -= capacity;
+    values[tail] = value;
+    indices[tail] = sampleCount++;
+    ++size;
+
+    return values[head];
+}
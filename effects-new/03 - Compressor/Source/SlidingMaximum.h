@@ -0,0 +1,34 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  SlidingMaximum: running maximum of the most recent windowLength input values, in O(1)
+    (amortized) time per sample, using a monotonic deque: a queue of candidate values in
+    decreasing order, from which any value that can no longer be the maximum is dropped.
+    Each value enters and leaves the queue at most once, however long the window is.
+
+    The queue is a fixed-size ring buffer, allocated by prepare(), so process() never allocates.
+*/
+
+class SlidingMaximum
+{
+public:
+    SlidingMaximum();
+
+    // Allocate for windows of up to maxWindowLength samples, and reset
+    void prepare(int maxWindowLength);
+    void reset();
+
+    // Window length may change at any time; it takes full effect once enough samples have passed
+    void setWindowLength(int length);
+
+    // Adds one value, and returns the maximum of the current window (including this value)
+    float process(float value);
+
+private:
+    HeapBlock<float> values;
+    HeapBlock<unsigned> indices;    // sample count when each value was added
+    int capacity;
+    int head, size;                 // queue occupies [head, head + size) mod capacity
+    int windowLength;
+    unsigned sampleCount;           // may wrap; only differences are used
+};
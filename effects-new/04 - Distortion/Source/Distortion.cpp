@@ -1,4 +1,5 @@
 #include "Distortion.h"
+#include "FastMath.h"
 
 void Distortion::populateDistortionTypeComboBox(ComboBox& cb)
 {
@@ -9,6 +10,7 @@ void Distortion::populateDistortionTypeComboBox(ComboBox& cb)
     cb.addItem("Exp. Soft Clip", ++itemNumber);
     cb.addItem("Full-Wave Rectifier", ++itemNumber);
     cb.addItem("Half-Wave Rectifier", ++itemNumber);
+    cb.addItem("Custom Curve", ++itemNumber);
 }
 
 float Distortion::processSample(float sample, Type type)
@@ -70,3 +72,296 @@ float Distortion::processSample(float sample, Type type)
 
     return sample;
 }
+
+void Distortion::processBlock(float* samples, int numSamples, Type type, float gain)
+{
+    switch (type)
+    {
+    case kHardClipping:
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = FastMath::min(FastMath::max(gain * samples[i], -0.5f), 0.5f);
+        break;
+
+    case kSoftClipping:
+        // For |x| in the knee, (3 - (2 - 3|x|)^2) / 6 = 1/3 + (1 - v^2) / 6, with v = 2 - 3|x|;
+        // clamping |x| to the knee's range makes the second term 0 below it and 1/6 above it
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = gain * samples[i];
+            const float a = FastMath::abs(x);
+            const float v = 2.0f - 3.0f * FastMath::min(FastMath::max(a, 1.0f / 3.0f), 2.0f / 3.0f);
+            samples[i] = std::copysign(FastMath::min(a, 1.0f / 3.0f) + (1.0f - v * v) / 6.0f, x);
+        }
+        break;
+
+    case kSoftClippingExp:
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = gain * samples[i];
+            const float log2e = 1.44269504f;
+            samples[i] = std::copysign(1.0f - FastMath::exp2(-log2e * FastMath::abs(x)), x);
+        }
+        break;
+
+    case kFullWaveRectifier:
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = FastMath::abs(gain * samples[i]);
+        break;
+
+    case kHalfWaveRectifier:
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = FastMath::max(gain * samples[i], 0.0f);
+        break;
+
+    default:
+        FloatVectorOperations::multiply(samples, gain, numSamples);
+        break;
+    }
+}
+
+namespace
+{
+    // Building blocks for the antiderivative methods, in double precision, with no comparisons,
+    // so that loops which use them can be vectorized
+
+    inline double clamp(double x, double lo, double hi)
+    {
+        return 0.5 * (std::abs(x - lo) - std::abs(x - hi) + lo + hi);
+    }
+
+    // 1 when a and b are far enough apart to divide by their difference, otherwise 0
+    // (GCC vectorizes this comparison, where it wouldn't a choice between two computed values)
+    inline double apart(double a, double b)
+    {
+        const double tolerance = 1.0e-5;
+        return std::abs(a - b) < tolerance ? 0.0 : 1.0;
+    }
+
+    // e^-a, for a >= 0, accurate to about 1e-12 (relative). a is limited to 40, where e^-a is
+    // well below anything that matters, and divided by 256, so a few terms of the Taylor series
+    // cover the range; the result is then squared 8 times. Unlike a table, or FastMath::exp2(),
+    // this is smooth, so small differences between nearby values come out right.
+    inline double expMinus(double a)
+    {
+        const double r = -0.00390625 * (0.5 * (a + 40.0 - std::abs(a - 40.0)));
+        double e = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120
+                       + r * (1.0 / 720 + r * (1.0 / 5040 + r * (1.0 / 40320 + r * (1.0 / 362880)))))))));
+        for (int i = 0; i < 8; ++i)
+            e *= e;
+        return e;
+    }
+
+    // Each type's shaping function f, and its first and second antiderivatives F1 and F2, which
+    // are zero at zero. Each is the same as Distortion::processSample() for f.
+
+    struct HardClipping
+    {
+        static constexpr double t = 0.5;    // threshold
+
+        // With c = f(x), F1 = x^2/2 (inside the threshold) or t*|x| - t^2/2 (outside) comes to
+        // the same expression either way, as does F2
+        static double f(double x) { return clamp(x, -t, t); }
+        static double F1(double x) { const double c = f(x); return x * c - 0.5 * c * c; }
+        static double F2(double x) { const double c = f(x); return c * (0.5 * x * x - 0.5 * c * x + c * c / 6.0); }
+    };
+
+    struct SoftClipping
+    {
+        // For x >= 0, f is linear up to 1/3, a parabola from 1/3 to 2/3, and constant 1/2 from
+        // there on. Clamping |x| to each piece's range gives each piece's contribution; f is odd,
+        // so F1 is even and F2 is odd.
+        static double sign(double x) { return std::copysign(1.0, x); }
+        static double linear(double a) { return clamp(a, 0.0, 1.0 / 3.0); }
+        static double knee(double a) { return clamp(a, 1.0 / 3.0, 2.0 / 3.0); }
+        static double flat(double a) { return 0.5 * (a + 2.0 / 3.0 + std::abs(a - 2.0 / 3.0)); }
+
+        static double f(double x)
+        {
+            const double a = std::abs(x), u = knee(a), v = 2.0 - 3.0 * u;
+            return sign(x) * (linear(a) + (1.0 - v * v) / 6.0);
+        }
+        static double F1(double x)
+        {
+            const double a = std::abs(x), l = linear(a), u = knee(a), v = 2.0 - 3.0 * u;
+            return 0.5 * l * l + (0.5 * u + v * v * v / 54.0 - 5.0 / 27.0) + 0.5 * (flat(a) - 2.0 / 3.0);
+        }
+        static double F2(double x)
+        {
+            const double a = std::abs(x), l = linear(a), u = knee(a), v = 2.0 - 3.0 * u;
+            const double w = flat(a) - 2.0 / 3.0;
+            return sign(x) * (l * l * l / 6.0
+                              + (0.25 * u * u - v * v * v * v / 648.0 - 7.0 * u / 54.0 + 11.0 / 648.0)
+                              + (11.0 / 54.0 + 0.25 * w) * w);
+        }
+    };
+
+    struct SoftClippingExp
+    {
+        static double f(double x) { return std::copysign(1.0 - expMinus(std::abs(x)), x); }
+        static double F1(double x) { const double a = std::abs(x); return a + expMinus(a) - 1.0; }
+        static double F2(double x)
+        {
+            const double a = std::abs(x);
+            return std::copysign(0.5 * a * a - a + 1.0 - expMinus(a), x);
+        }
+    };
+
+    struct FullWaveRectifier
+    {
+        static double f(double x) { return std::abs(x); }
+        static double F1(double x) { return 0.5 * x * std::abs(x); }
+        static double F2(double x) { return x * x * std::abs(x) / 6.0; }
+    };
+
+    struct HalfWaveRectifier
+    {
+        static double f(double x) { return 0.5 * (std::abs(x) + x); }
+        static double F1(double x) { const double p = f(x); return 0.5 * p * p; }
+        static double F2(double x) { const double p = f(x); return p * p * p / 6.0; }
+    };
+
+    // x[-1] is the sample before x[0]; F is working space for numSamples + 1 values
+    template <typename Shape>
+    void processFirstOrder(float* __restrict samples, int numSamples, const float* __restrict x, double* __restrict F)
+    {
+        for (int i = -1; i < numSamples; ++i)
+            F[i + 1] = Shape::F1(x[i]);
+
+        // y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), or f at the mid-point
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x0 = x[i], x1 = x[i - 1];
+            const double w = apart(x0, x1);
+            const double difference = (F[i + 1] - F[i]) / (x0 - x1 + 1.0 - w);
+            samples[i] = float(w * difference + (1.0 - w) * Shape::f(0.5 * (x0 + x1)));
+        }
+    }
+
+    // x[-2] and x[-1] are the two samples before x[0]; F and D are working space for
+    // numSamples + 2 and numSamples + 1 values
+    template <typename Shape>
+    void processSecondOrder(float* __restrict samples, int numSamples, const float* __restrict x,
+                            double* __restrict F, double* __restrict D)
+    {
+        for (int i = -2; i < numSamples; ++i)
+            F[i + 2] = Shape::F2(x[i]);
+
+        // D[n] = (F2(x[n]) - F2(x[n-1])) / (x[n] - x[n-1]), or F1 at the mid-point
+        for (int i = -1; i < numSamples; ++i)
+        {
+            const double x0 = x[i], x1 = x[i - 1];
+            const double w = apart(x0, x1);
+            const double difference = (F[i + 2] - F[i + 1]) / (x0 - x1 + 1.0 - w);
+            D[i + 1] = w * difference + (1.0 - w) * Shape::F1(0.5 * (x0 + x1));
+        }
+
+        // y[n] = 2 * (D[n] - D[n-1]) / (x[n] - x[n-2]). When x[n] and x[n-2] are too close, the
+        // same with both replaced by their mean m, i.e. the limit as they approach each other,
+        // which is 2 * (F1(m) - (F2(m) - F2(x[n-1])) / (m - x[n-1])) / (m - x[n-1]), or, when
+        // x[n-1] is also too close, f at the mid-point of m and x[n-1].
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x0 = x[i], x1 = x[i - 1], x2 = x[i - 2];
+            const double w = apart(x0, x2);
+            const double secondDifference = 2.0 * (D[i + 1] - D[i]) / (x0 - x2 + 1.0 - w);
+
+            const double m = 0.5 * (x0 + x2);
+            const double wm = apart(m, x1);
+            const double delta = m - x1 + 1.0 - wm;
+            const double limit = 2.0 * (Shape::F1(m) - (Shape::F2(m) - F[i + 1]) / delta) / delta;
+            const double closeTogether = wm * limit + (1.0 - wm) * Shape::f(0.5 * (m + x1));
+
+            samples[i] = float(w * secondDifference + (1.0 - w) * closeTogether);
+        }
+    }
+
+    template <typename Shape>
+    void processAntialiased(float* samples, int numSamples, Distortion::Antialiasing antialiasing,
+                            const float* x, double* F, double* D)
+    {
+        if (antialiasing == Distortion::kAntialiasingSecondOrder)
+            processSecondOrder<Shape>(samples, numSamples, x, F, D);
+        else
+            processFirstOrder<Shape>(samples, numSamples, x, F);
+    }
+}
+
+void Distortion::populateAntialiasingComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("None", ++itemNumber);
+    cb.addItem("ADAA 1st Order", ++itemNumber);
+    cb.addItem("ADAA 2nd Order", ++itemNumber);
+}
+
+Distortion::AntialiasingState::AntialiasingState()
+    : maxBlockSize(0)
+{
+}
+
+void Distortion::AntialiasingState::prepare(int maxBlockSizeToUse)
+{
+    maxBlockSize = maxBlockSizeToUse;
+    input.allocate(size_t(maxBlockSize + 2), true);
+    antiderivative.allocate(size_t(maxBlockSize + 2), true);
+    difference.allocate(size_t(maxBlockSize + 1), true);
+}
+
+void Distortion::AntialiasingState::reset()
+{
+    if (maxBlockSize > 0)
+        FloatVectorOperations::clear(input.get(), 2);
+}
+
+void Distortion::processBlockAntialiased(float* samples, int numSamples, Type type, float gain,
+                                         Antialiasing antialiasing, AntialiasingState& state)
+{
+    jassert(state.maxBlockSize > 0);
+
+    // Blocks longer than the working space are processed in pieces
+    while (numSamples > 0)
+    {
+        const int count = jmin(numSamples, state.maxBlockSize);
+        float* x = state.input + 2;
+        FloatVectorOperations::copyWithMultiply(x, samples, gain, count);
+
+        if (antialiasing == kAntialiasingNone)
+        {
+            // The history is still kept, in case antialiasing is switched on
+            processBlock(samples, count, type, gain);
+        }
+        else
+        {
+            double* F = state.antiderivative;
+            double* D = state.difference;
+            switch (type)
+            {
+            case kHardClipping:
+                processAntialiased<HardClipping>(samples, count, antialiasing, x, F, D);
+                break;
+            case kSoftClipping:
+                processAntialiased<SoftClipping>(samples, count, antialiasing, x, F, D);
+                break;
+            case kSoftClippingExp:
+                processAntialiased<SoftClippingExp>(samples, count, antialiasing, x, F, D);
+                break;
+            case kFullWaveRectifier:
+                processAntialiased<FullWaveRectifier>(samples, count, antialiasing, x, F, D);
+                break;
+            case kHalfWaveRectifier:
+                processAntialiased<HalfWaveRectifier>(samples, count, antialiasing, x, F, D);
+                break;
+            default:
+                FloatVectorOperations::copy(samples, x, count);
+                break;
+            }
+        }
+
+        // Keep the last two input samples, which may include the previous block's
+        std::memmove(state.input.get(), state.input + count, 2 * sizeof(float));
+
+        samples += count;
+        numSamples -= count;
+    }
+}
@@ -2,6 +2,28 @@
 #include "JuceHeader.h"
 
 /*  Distortion: Encapsulates the basic wave-shaping functions of the Distortion effect.
+
+    processBlock() is the fast way to shape a whole block: the type is chosen once, not per
+    sample, the input gain is applied in the same pass, and every curve is written without
+    branches (using FastMath's abs(), min() and max(), and exp2() in place of expf()), so each
+    loop is vectorized by the compiler, to whatever width the target allows (SSE, AVX or NEON).
+    Its results match processSample()'s to within a few float rounding errors.
+
+    processBlockAntialiased() offers a cheaper alternative to oversampling: antiderivative
+    antialiasing (ADAA). Rather than the shaping function f at each sample, the first-order
+    method outputs the average of f over the straight line joining each input sample to the one
+    before, i.e. (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), where F1 is f's antiderivative.
+    Averaging is a lowpass filter, applied (in effect) to the shaper's output before sampling,
+    so the harmonics which would alias are much reduced. The second-order method does the same
+    again, with the second antiderivative F2, and does better still. The price is a little
+    high-frequency rolloff, and a delay of half a sample (first order) or one sample (second).
+
+    Every type has closed-form antiderivatives, written (like f itself) without branches or
+    comparisons, so the block loops are vectorized by the compiler. When successive samples are
+    too close together for the differences to be computed accurately, f (or F1) at their
+    mid-point is used instead, by weighting both results with 0 or 1, rather than branching.
+    The sums are done in double precision: the second-order method divides a difference of
+    differences by the square of a small number, which single precision can't survive.
 */
 
 struct Distortion
@@ -13,10 +35,46 @@ struct Distortion
         kSoftClippingExp,
         kFullWaveRectifier,
         kHalfWaveRectifier,
+        kCustomCurve,           // shaped by a TransferCurve (see TransferCurve.h), not by this class
         kNumTypes
     };
 
+    enum Antialiasing
+    {
+        kAntialiasingNone = 0,
+        kAntialiasingFirstOrder,
+        kAntialiasingSecondOrder,
+        kNumAntialiasings
+    };
+
     static void populateDistortionTypeComboBox(ComboBox& cb);
+    static void populateAntialiasingComboBox(ComboBox& cb);
 
     static float processSample(float sample, Type type);
+
+    // Apply gain, then shape, numSamples samples in place
+    static void processBlock(float* samples, int numSamples, Type type, float gain = 1.0f);
+
+    // The input samples which the antiderivative methods carry over from block to block, plus
+    // working space; one per channel
+    class AntialiasingState
+    {
+    public:
+        AntialiasingState();
+
+        void prepare(int maxBlockSize);
+        void reset();
+
+    private:
+        friend struct Distortion;
+        HeapBlock<float> input;             // 2 previous input samples, then the block
+        HeapBlock<double> antiderivative;   // of each of those
+        HeapBlock<double> difference;       // of antiderivatives, divided by those of the inputs
+        int maxBlockSize;
+    };
+
+    // Apply gain, then shape, numSamples samples in place, with the given antialiasing method
+    // (with kAntialiasingNone, this is just processBlock())
+    static void processBlockAntialiased(float* samples, int numSamples, Type type, float gain,
+                                        Antialiasing antialiasing, AntialiasingState& state);
 };
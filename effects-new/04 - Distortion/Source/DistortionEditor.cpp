@@ -24,11 +24,45 @@ DistortionEditor::DistortionEditor (DistortionProcessor& p)
     gainKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledGainKnob);
 
+    oversamplingLabel.setText("Oversample", dontSendNotification);
+    oversamplingLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&oversamplingLabel);
+
+    oversamplingCombo.setEditableText(false);
+    oversamplingCombo.setJustificationType(Justification::centredLeft);
+    Oversampler::populateFactorComboBox(oversamplingCombo);
+    addAndMakeVisible(oversamplingCombo);
+
+    antialiasingLabel.setText("Antialias", dontSendNotification);
+    antialiasingLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&antialiasingLabel);
+
+    antialiasingCombo.setEditableText(false);
+    antialiasingCombo.setJustificationType(Justification::centredLeft);
+    Distortion::populateAntialiasingComboBox(antialiasingCombo);
+    addAndMakeVisible(antialiasingCombo);
+
+    curveGroup.setText("Custom Curve");
+    addAndMakeVisible(&curveGroup);
+
+    Array<Slider*> harmonicSliders;
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        auto knob = harmonicKnobs.add(new BasicKnob(-1.0f, 1.0f));
+        knob->setDoubleClickReturnValue(true, h == 0 ? 1.0 : 0.0, ModifierKeys::noModifiers);
+        harmonicSliders.add(knob);
+        auto labeledKnob = labeledHarmonicKnobs.add(new LabeledKnob("H" + String(h + 1), *knob));
+        addAndMakeVisible(labeledKnob);
+    }
+
     processor.parameters.attachControls(
         distTypeCombo,
-        gainKnob);
+        gainKnob,
+        oversamplingCombo,
+        antialiasingCombo,
+        harmonicSliders);
 
-    setSize (60 + 100 * 2 + 10 * (2 - 1), 220);
+    setSize (720, 288);
 }
 
 DistortionEditor::~DistortionEditor()
@@ -39,10 +73,13 @@ DistortionEditor::~DistortionEditor()
 
 void DistortionEditor::resized()
 {
-    auto bounds = getLocalBounds().reduced(20);
+    auto groupsArea = getLocalBounds().reduced(20);
+
+    mainGroup.setBounds(groupsArea.removeFromLeft(230));
+    groupsArea.removeFromLeft(20);
+    curveGroup.setBounds(groupsArea);
 
-    mainGroup.setBounds(bounds);
-    auto widgetsArea = bounds.reduced(10);
+    auto widgetsArea = mainGroup.getBounds().reduced(10);
 
     widgetsArea.removeFromTop(12);
     auto waveformArea = widgetsArea.removeFromTop(24);
@@ -50,7 +87,27 @@ void DistortionEditor::resized()
     distTypeCombo.setBounds(waveformArea);
     widgetsArea.removeFromTop(10);
 
+    auto antialiasingArea = widgetsArea.removeFromBottom(24);
+    antialiasingLabel.setBounds(antialiasingArea.removeFromLeft(80));
+    antialiasingCombo.setBounds(antialiasingArea);
+    widgetsArea.removeFromBottom(10);
+
+    auto oversamplingArea = widgetsArea.removeFromBottom(24);
+    oversamplingLabel.setBounds(oversamplingArea.removeFromLeft(80));
+    oversamplingCombo.setBounds(oversamplingArea);
+    widgetsArea.removeFromBottom(10);
+
     labeledGainKnob.setBounds(widgetsArea);
+
+    // One column per harmonic, 70 wide with 10 between
+    widgetsArea = curveGroup.getBounds().reduced(20);
+    widgetsArea.removeFromTop(63);
+    widgetsArea.removeFromBottom(34);
+    for (auto labeledKnob : labeledHarmonicKnobs)
+    {
+        labeledKnob->setBounds(widgetsArea.removeFromLeft(70));
+        widgetsArea.removeFromLeft(10);
+    }
 }
 
 void DistortionEditor::paint (Graphics& g)
@@ -22,6 +22,11 @@ private:
 
     ComboBox distTypeCombo; Label distTypeLabel;
     DecibelKnob gainKnob; LabeledKnob labeledGainKnob;
+    ComboBox oversamplingCombo; Label oversamplingLabel;
+    ComboBox antialiasingCombo; Label antialiasingLabel;
+
+    GroupComponent curveGroup;
+    OwnedArray<BasicKnob> harmonicKnobs; OwnedArray<LabeledKnob> labeledHarmonicKnobs;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DistortionEditor)
 };
@@ -8,6 +8,16 @@ const String DistortionParameters::distTypeLabel = "";
 const String DistortionParameters::gainID = "gain";
 const String DistortionParameters::gainName = TRANS("Gain");
 const String DistortionParameters::gainLabel = "dB";
+const String DistortionParameters::oversamplingID = "oversampling";
+const String DistortionParameters::oversamplingName = TRANS("Oversampling");
+const String DistortionParameters::oversamplingLabel = "";
+const String DistortionParameters::antialiasingID = "antialiasing";
+const String DistortionParameters::antialiasingName = TRANS("Antialiasing");
+const String DistortionParameters::antialiasingLabel = "";
+const String DistortionParameters::harmonicID[] = { "harmonic1", "harmonic2", "harmonic3", "harmonic4", "harmonic5" };
+const String DistortionParameters::harmonicName[] = { TRANS("Harmonic 1"), TRANS("Harmonic 2"), TRANS("Harmonic 3"),
+                                                      TRANS("Harmonic 4"), TRANS("Harmonic 5") };
+const String DistortionParameters::harmonicLabel = "";
 
 AudioProcessorValueTreeState::ParameterLayout DistortionParameters::createParameterLayout()
 {
@@ -15,7 +25,7 @@ AudioProcessorValueTreeState::ParameterLayout DistortionParameters::createParame
 
     params.push_back(std::make_unique<AudioParameterInt>(
         distTypeID, distTypeName,
-        0, 5 - 1, 0,
+        0, int(Distortion::kNumTypes) - 1, 0,
         distTypeLabel,
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
@@ -26,19 +36,59 @@ AudioProcessorValueTreeState::ParameterLayout DistortionParameters::createParame
         AudioProcessorParameter::genericParameter,
         [](float value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        oversamplingID, oversamplingName,
+        0, int(Oversampler::kNumFactors) - 1, int(Oversampler::kFactor1x),
+        oversamplingLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        antialiasingID, antialiasingName,
+        0, int(Distortion::kNumAntialiasings) - 1, int(Distortion::kAntialiasingNone),
+        antialiasingLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            harmonicID[h], harmonicName[h],
+            NormalisableRange<float>(-1.0f, 1.0f, 0.01f), (h == 0) ? 1.0f : 0.0f,
+            harmonicLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+    }
 
     return { params.begin(), params.end() };
 }
 
-DistortionParameters::DistortionParameters(AudioProcessorValueTreeState& vts)
+DistortionParameters::DistortionParameters(AudioProcessorValueTreeState& vts,
+                                           AudioProcessorValueTreeState::Listener* processor)
     : distType(Distortion::kHardClipping)
     , linearGain(1.0f)
+    , antialiasing(Distortion::kAntialiasingNone)
     , valueTreeState(vts)
     , distTypeListener(distType)
     , gainListener(linearGain, -100.0f)
+    , antialiasingListener(antialiasing)
+    , processorAsListener(processor)
 {
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        harmonicLevels[h] = (h == 0) ? 1.0f : 0.0f;
+        harmonicListeners.add(new FloatListener(harmonicLevels[h]));
+    }
+
     valueTreeState.addParameterListener(distTypeID, &distTypeListener);
     valueTreeState.addParameterListener(gainID, &gainListener);
+    valueTreeState.addParameterListener(antialiasingID, &antialiasingListener);
+
+    valueTreeState.addParameterListener(oversamplingID, processorAsListener);
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        valueTreeState.addParameterListener(harmonicID[h], harmonicListeners[h]);
+        valueTreeState.addParameterListener(harmonicID[h], processorAsListener);
+    }
 }
 
 DistortionParameters::~DistortionParameters()
@@ -46,18 +96,35 @@ DistortionParameters::~DistortionParameters()
     detachControls();
     valueTreeState.removeParameterListener(distTypeID, &distTypeListener);
     valueTreeState.removeParameterListener(gainID, &gainListener);
+    valueTreeState.removeParameterListener(antialiasingID, &antialiasingListener);
+    valueTreeState.removeParameterListener(oversamplingID, processorAsListener);
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        valueTreeState.removeParameterListener(harmonicID[h], harmonicListeners[h]);
+        valueTreeState.removeParameterListener(harmonicID[h], processorAsListener);
+    }
 }
 
 void DistortionParameters::detachControls()
 {
     distTypeAttachment.reset(nullptr);
     gainAttachment.reset(nullptr);
+    oversamplingAttachment.reset(nullptr);
+    antialiasingAttachment.reset(nullptr);
+    harmonicAttachments.clear();
 }
 
-void DistortionParameters::attachControls(ComboBox& distTypeCombo, Slider& gainKnob)
+void DistortionParameters::attachControls(ComboBox& distTypeCombo, Slider& gainKnob,
+                                          ComboBox& oversamplingCombo, ComboBox& antialiasingCombo,
+                                          const Array<Slider*>& harmonicKnobs)
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
     distTypeAttachment.reset(new CbAt(valueTreeState, distTypeID, distTypeCombo));
     gainAttachment.reset(new SlAt(valueTreeState, gainID, gainKnob));
+    oversamplingAttachment.reset(new CbAt(valueTreeState, oversamplingID, oversamplingCombo));
+    antialiasingAttachment.reset(new CbAt(valueTreeState, antialiasingID, antialiasingCombo));
+    harmonicAttachments.clear();
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+        harmonicAttachments.add(new SlAt(valueTreeState, harmonicID[h], *harmonicKnobs[h]));
 }
@@ -2,6 +2,8 @@
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
 #include "Distortion.h"
+#include "Oversampler.h"
+#include "TransferCurve.h"
 
 class DistortionParameters
 {
@@ -10,18 +12,27 @@ public:
     // Labels are supplementary, typically used for units of measure
     static const String distTypeID, distTypeName, distTypeLabel;
     static const String gainID, gainName, gainLabel;
+    static const String oversamplingID, oversamplingName, oversamplingLabel;
+    static const String antialiasingID, antialiasingName, antialiasingLabel;
+    static const String harmonicID[TransferCurve::numHarmonics], harmonicName[TransferCurve::numHarmonics];
+    static const String harmonicLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
-    DistortionParameters(AudioProcessorValueTreeState& vts);
+    DistortionParameters(AudioProcessorValueTreeState& vts,
+                         AudioProcessorValueTreeState::Listener* processor);
     ~DistortionParameters();
 
     void detachControls();
-    void attachControls(ComboBox& distTypeCombo, Slider& gainKnob);
+    void attachControls(ComboBox& distTypeCombo, Slider& gainKnob,
+                        ComboBox& oversamplingCombo, ComboBox& antialiasingCombo,
+                        const Array<Slider*>& harmonicKnobs);
 
     // working parameter values
     Distortion::Type distType;
     float linearGain;
+    Distortion::Antialiasing antialiasing;
+    float harmonicLevels[TransferCurve::numHarmonics];
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -30,8 +41,17 @@ private:
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> distTypeAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> gainAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> antialiasingAttachment;
+    OwnedArray<AudioProcessorValueTreeState::SliderAttachment> harmonicAttachments;
 
     // Listener objects link parameters to working variables
     EnumListener<Distortion::Type> distTypeListener;
     FloatDecibelListener gainListener;  // gainID -> linearGain
+    EnumListener<Distortion::Antialiasing> antialiasingListener;
+    OwnedArray<FloatListener> harmonicListeners;
+
+    // Processor listens for oversampling changes itself, and applies them at the start of a
+    // block; it also listens for harmonic level changes, to recompile its transfer curve
+    AudioProcessorValueTreeState::Listener* processorAsListener;
 };
@@ -21,7 +21,9 @@ DistortionProcessor::DistortionProcessor()
                      .withOutput ("Output", AudioChannelSet::stereo(), true)
                      )
     , valueTreeState(*this, nullptr, Identifier("Distortion"), DistortionParameters::createParameterLayout())
-    , parameters(valueTreeState)
+    , parameters(valueTreeState, this)
+    , oversamplingTarget(Oversampler::kFactor1x)
+    , latencyReporter(*this)
 {
 }
 
@@ -30,9 +32,48 @@ DistortionProcessor::~DistortionProcessor()
 {
 }
 
+// A new oversampling factor is picked up by processSubBlock(); a new harmonic level means a
+// new custom curve, which is compiled in the background. (Any thread.)
+void DistortionProcessor::parameterChanged(const String& paramID, float newValue)
+{
+    if (paramID == DistortionParameters::oversamplingID)
+    {
+        oversamplingTarget.store(int(newValue + 0.5f));
+        return;
+    }
+
+    for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+    {
+        if (paramID == DistortionParameters::harmonicID[h])
+        {
+            transferCurve.setHarmonicLevel(h, newValue);
+            return;
+        }
+    }
+}
+
 // Prepare to process audio (always called at least once before processBlock)
-void DistortionProcessor::prepareToPlay (double /*sampleRate*/, int /*maxSamplesPerBlock*/)
+void DistortionProcessor::prepareToPlay (double /*sampleRate*/, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
+    const Oversampler::Factor factor = Oversampler::Factor(oversamplingTarget.load());
+    oversampler.prepare(jmax(1, getTotalNumInputChannels()), maxSamplesPerBlock);
+    oversampler.setFactor(factor);
+
+    // The shaper may run at up to the highest oversampling factor's rate
+    antialiasingStates.clear();
+    for (int channel = 0; channel < getTotalNumInputChannels(); ++channel)
+    {
+        auto state = antialiasingStates.add(new Distortion::AntialiasingState());
+        state->prepare(maxSamplesPerBlock << (Oversampler::kNumFactors - 1));
+    }
+
+    latencyReporter.setLatencySamplesNow(Oversampler::getLatencySamples(factor));
+
+    transferCurve.setHarmonicLevels(parameters.harmonicLevels);
+    transferCurve.compileNow();
 }
 
 // Audio processing finished; release any allocated memory
@@ -42,23 +83,47 @@ void DistortionProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void DistortionProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void DistortionProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
+    // A change of oversampling factor clears the filters, and the shaper's input history, which
+    // was at the old rate, and changes the latency, which the host hears about from the message
+    // thread
+    const Oversampler::Factor factor = Oversampler::Factor(oversamplingTarget.load());
+    if (factor != oversampler.getFactor())
+    {
+        oversampler.setFactor(factor);
+        for (auto state : antialiasingStates)
+            state->reset();
+        latencyReporter.setLatencySamples(Oversampler::getLatencySamples(factor));
+    }
+    transferCurve.update();
+
+    const int numSamples = buffer.getNumSamples();
+    const int numOversampled = numSamples * oversampler.getRatio();
+
     // apply the same distortion to all input channels for which there is an output channel
     int channelIndex = 0;
     for (; channelIndex < getTotalNumInputChannels(); channelIndex++)
     {
-        // Apply gain
-        buffer.applyGain(channelIndex, 0, buffer.getNumSamples(), parameters.linearGain);
+        // Wave-shape at the oversampled rate (which may be just the original samples). The
+        // up- and downsampling filters are linear, so the gain can be applied after upsampling,
+        // in the same pass as the shaper.
+        float* pData = oversampler.upsample(channelIndex, buffer.getWritePointer(channelIndex), numSamples);
 
-        const float* pIn = buffer.getReadPointer(channelIndex);
-        float* pOut = buffer.getWritePointer(channelIndex);
+        if (parameters.distType == Distortion::kCustomCurve)
+            transferCurve.processBlock(pData, numOversampled, parameters.linearGain);
+        else
+            Distortion::processBlockAntialiased(pData, numOversampled, parameters.distType, parameters.linearGain,
+                                                parameters.antialiasing, *antialiasingStates[channelIndex]);
 
-        for (int i = 0; i < buffer.getNumSamples(); i++)
-        {
-            *pOut++ = Distortion::processSample(*pIn++, parameters.distType);
-        }
+        oversampler.downsample(channelIndex, buffer.getWritePointer(channelIndex), numSamples);
     }
 
     // clear any remaining/excess output channels to zero
@@ -1,8 +1,12 @@
 #pragma once
 #include "JuceHeader.h"
 #include "DistortionParameters.h"
+#include "AutomationScheduler.h"
+#include "LatencyReporter.h"
 
 class DistortionProcessor : public AudioProcessor
+                          , public AudioProcessorValueTreeState::Listener
+                          , public AutomationScheduler::Owner
 {
 public:
     DistortionProcessor();
@@ -29,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -40,6 +47,26 @@ public:
     // Application's view of the AudioProcessorValueTreeState, including working parameter values
     DistortionParameters parameters;
 
+    // Responding to parameter changes
+    void parameterChanged(const String&, float) override;
+
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // Runs the wave-shaper at a multiple of the sample rate, to reduce aliasing. The factor
+    // the listener last saw is applied at the start of the next sub-block, and the resulting
+    // latency goes to the host from the message thread.
+    Oversampler oversampler;
+    std::atomic<int> oversamplingTarget;
+    LatencyReporter latencyReporter;
+
+    // Input history for the wave-shaper's antiderivative antialiasing, one per channel
+    OwnedArray<Distortion::AntialiasingState> antialiasingStates;
+
+    // The Custom Curve type's shaper, compiled from the harmonic levels on a background thread
+    TransferCurve transferCurve;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DistortionProcessor)
 };
@@ -0,0 +1,210 @@
+#include "Oversampler.h"
+
+namespace
+{
+    // halfLength of each stage's filters. With the Kaiser window below, the first stage is
+    // flat (to 0.001 dB) up to 0.4 of the original sample rate, and every stage rejects
+    // images and aliases by around 85 dB or more.
+    const int stageHalfLengths[Oversampler::kNumFactors - 1] = { 24, 7, 5 };
+    const double kaiserBeta = 8.0;
+
+    // Delay of the stages used for a factor, in samples at the original rate, which can be a
+    // fraction (a half or a quarter) of a sample from the 4x and 8x stages
+    double getFilterLatency(Oversampler::Factor factor)
+    {
+        // Each stage's up- and downsampling filters together delay the signal by
+        // 4 * halfLength - 2 samples at that stage's higher rate
+        double latency = 0.0;
+        for (int s = 0; s < int(factor); ++s)
+            latency += (2 * stageHalfLengths[s] - 1) / double(1 << s);
+        return latency;
+    }
+
+    // Zeroth-order modified Bessel function of the first kind, for the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= (0.5 * x / k) * (0.5 * x / k);
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+}
+
+void Oversampler::populateFactorComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("None", ++itemNumber);
+    cb.addItem("2x", ++itemNumber);
+    cb.addItem("4x", ++itemNumber);
+    cb.addItem("8x", ++itemNumber);
+}
+
+int Oversampler::getLatencySamples(Factor factor)
+{
+    return int(std::ceil(getFilterLatency(factor)));
+}
+
+Oversampler::Oversampler()
+    : paddingSamples(0)
+    , factor(kFactor1x)
+{
+    for (int s = 0; s < kNumFactors - 1; ++s)
+        stages[s].design(stageHalfLengths[s], kaiserBeta);
+}
+
+void Oversampler::prepare(int numChannels, int maxBlockSize)
+{
+    for (int s = 0; s < kNumFactors - 1; ++s)
+    {
+        stages[s].prepare(numChannels, maxBlockSize << s);
+        levels[s].setSize(numChannels, maxBlockSize << (s + 1));
+    }
+    padding.setSize(numChannels, maxPaddingSamples + (maxBlockSize << (kNumFactors - 1)));
+    reset();
+}
+
+void Oversampler::reset()
+{
+    for (auto& stage : stages)
+        stage.reset();
+    padding.clear();
+}
+
+void Oversampler::setFactor(Factor newFactor)
+{
+    if (newFactor != factor)
+    {
+        factor = newFactor;
+        const int ratio = getRatio();
+        paddingSamples = roundToInt((getLatencySamples(factor) - getFilterLatency(factor)) * ratio);
+        jassert(paddingSamples <= maxPaddingSamples);
+        reset();
+    }
+}
+
+float* Oversampler::upsample(int channel, float* data, int numSamples)
+{
+    float* signal = data;
+    for (int s = 0; s < int(factor); ++s)
+    {
+        float* output = levels[s].getWritePointer(channel);
+        stages[s].upsample(channel, signal, output, numSamples << s);
+        signal = output;
+    }
+
+    // Delay the oversampled signal by whatever fraction of an original sample makes the
+    // total latency a whole number of original samples
+    if (paddingSamples > 0)
+    {
+        const int numOversampled = numSamples * getRatio();
+        float* p = padding.getWritePointer(channel);
+        FloatVectorOperations::copy(p + paddingSamples, signal, numOversampled);
+        FloatVectorOperations::copy(signal, p, numOversampled);
+        std::memmove(p, p + numOversampled, size_t(paddingSamples) * sizeof(float));
+    }
+    return signal;
+}
+
+void Oversampler::downsample(int channel, float* data, int numSamples)
+{
+    for (int s = int(factor) - 1; s >= 0; --s)
+    {
+        const float* input = levels[s].getReadPointer(channel);
+        float* output = s > 0 ? levels[s - 1].getWritePointer(channel) : data;
+        stages[s].downsample(channel, input, output, numSamples << s);
+    }
+}
+
+void Oversampler::HalfBandStage::design(int halfLengthToUse, double beta)
+{
+    jassert(halfLengthToUse <= maxHalfLength);
+    halfLength = halfLengthToUse;
+    historyLength = 2 * halfLength - 1;
+
+    // Kaiser-windowed sinc, cutting off at a quarter of the higher sample rate. g[j] is tap
+    // 2j of the full filter (numTaps = 4 * halfLength - 1, centre tap at historyLength),
+    // doubled to make up for the zeros inserted by upsampling, and the set is normalised to
+    // a DC gain of exactly 1.
+    const int numTaps = 4 * halfLength - 1;
+    const double denominator = besselI0(beta);
+    double sum = 0.0;
+    for (int j = 0; j < 2 * halfLength; ++j)
+    {
+        const double n = 2 * j - historyLength;     // always odd, so the sinc is never 0/0
+        const double x = 0.5 * MathConstants<double>::pi * n;
+        const double r = 2.0 * (2 * j) / (numTaps - 1) - 1.0;
+        const double window = besselI0(beta * std::sqrt(1.0 - r * r)) / denominator;
+        const double tap = std::sin(x) / x * window;
+        g[j] = float(tap);
+        sum += tap;
+    }
+    for (int j = 0; j < 2 * halfLength; ++j)
+        g[j] = float(g[j] / sum);
+}
+
+void Oversampler::HalfBandStage::prepare(int numChannels, int maxInputSamples)
+{
+    upInput.setSize(numChannels, historyLength + maxInputSamples);
+    downEven.setSize(numChannels, historyLength + maxInputSamples);
+    downOdd.setSize(numChannels, historyLength + maxInputSamples);
+}
+
+void Oversampler::HalfBandStage::reset()
+{
+    upInput.clear();
+    downEven.clear();
+    downOdd.clear();
+}
+
+void Oversampler::HalfBandStage::upsample(int channel, const float* input, float* output, int numSamples)
+{
+    // x[historyLength + i] is input[i]; the history before it is carried over between blocks
+    float* x = upInput.getWritePointer(channel);
+    FloatVectorOperations::copy(x + historyLength, input, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // p[-k] is the input k samples ago. The coefficients are symmetric, so each is
+        // applied to a pair of samples.
+        const float* p = x + historyLength + i;
+        float sum = 0.0f;
+        for (int j = 0; j < halfLength; ++j)
+            sum += g[j] * (p[-j] + p[j - historyLength]);
+
+        output[2 * i] = sum;
+        output[2 * i + 1] = p[1 - halfLength];
+    }
+
+    std::memmove(x, x + numSamples, size_t(historyLength) * sizeof(float));
+}
+
+void Oversampler::HalfBandStage::downsample(int channel, const float* input, float* output, int numSamples)
+{
+    // Split the input into its even and odd samples, after the history of each
+    float* even = downEven.getWritePointer(channel);
+    float* odd = downOdd.getWritePointer(channel);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        even[historyLength + i] = input[2 * i];
+        odd[historyLength + i] = input[2 * i + 1];
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float* pe = even + historyLength + i;
+        const float* po = odd + historyLength + i;
+        float sum = 0.0f;
+        for (int j = 0; j < halfLength; ++j)
+            sum += g[j] * (pe[-j] + pe[j - historyLength]);
+
+        output[i] = 0.5f * (sum + po[-halfLength]);
+    }
+
+    std::memmove(even, even + numSamples, size_t(historyLength) * sizeof(float));
+    std::memmove(odd, odd + numSamples, size_t(historyLength) * sizeof(float));
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  Oversampler: lets the Distortion effect run its wave-shaper at 2, 4 or 8 times the host's
+    sample rate, so the harmonics it generates above the original Nyquist frequency are filtered
+    out, instead of aliasing back down into the audible range.
+
+    Each factor of 2 is one HalfBandStage: a half-band lowpass FIR for upsampling, and another
+    for downsampling. Every other coefficient of a half-band filter is zero (apart from the
+    centre one, which is 0.5), so in polyphase form each upsampled output pair is one short FIR
+    plus one plain delayed input sample, and each downsampled output is the same in reverse.
+    The first stage has the steepest filters (flat to 0.4 of the original sample rate); later
+    stages only have to separate what is left of the images, so need far fewer taps.
+
+    The filters are linear-phase, so the whole process simply delays the signal. The later
+    stages' delays come to a fraction of an original sample, so the oversampled signal is
+    delayed by a few samples more, to make the total a whole number of samples, which the
+    processor can report to the host (see getLatencySamples()). All buffers are allocated in
+    prepare(), for the largest factor.
+*/
+
+class Oversampler
+{
+public:
+    enum Factor
+    {
+        kFactor1x = 0,
+        kFactor2x,
+        kFactor4x,
+        kFactor8x,
+        kNumFactors
+    };
+
+    static void populateFactorComboBox(ComboBox& cb);
+
+    // Delay, in samples at the original rate, of upsampling followed by downsampling
+    static int getLatencySamples(Factor factor);
+
+    Oversampler();
+
+    void prepare(int numChannels, int maxBlockSize);
+    void reset();
+
+    // Changing the factor clears all filter state
+    void setFactor(Factor newFactor);
+    Factor getFactor() const { return factor; }
+    int getRatio() const { return 1 << int(factor); }
+
+    // Upsample numSamples samples of one channel, and return the numSamples * getRatio()
+    // resulting samples, for the caller to process in place (with kFactor1x, this is just data)
+    float* upsample(int channel, float* data, int numSamples);
+
+    // Downsample the samples last returned by upsample() for this channel, back into data
+    void downsample(int channel, float* data, int numSamples);
+
+private:
+    struct HalfBandStage
+    {
+        // Each filter has 4 * halfLength - 1 taps, of which 2 * halfLength (g) are nonzero
+        // and not the centre tap; historyLength earlier input samples are kept between blocks
+        static const int maxHalfLength = 24;
+        int halfLength, historyLength;
+        float g[2 * maxHalfLength];
+
+        AudioBuffer<float> upInput, downEven, downOdd;
+
+        void design(int halfLengthToUse, double kaiserBeta);
+        void prepare(int numChannels, int maxInputSamples);
+        void reset();
+        void upsample(int channel, const float* input, float* output, int numSamples);
+        void downsample(int channel, const float* input, float* output, int numSamples);
+    };
+
+    HalfBandStage stages[kNumFactors - 1];
+
+    // Signal at 2, 4 and 8 times the original rate, between stages
+    AudioBuffer<float> levels[kNumFactors - 1];
+
+    // Extra delay of the oversampled signal (see above)
+    static const int maxPaddingSamples = 4;
+    AudioBuffer<float> padding;
+    int paddingSamples;
+
+    Factor factor;
+
+    JUCE_DECLARE_NON_COPYABLE(Oversampler)
+};
@@ -0,0 +1,141 @@
+#include "TransferCurve.h"
+#include "FastMath.h"
+
+namespace
+{
+    // How often the background thread checks for new levels
+    const int pollIntervalMs = 20;
+}
+
+TransferCurve::TransferCurve()
+    : frontIndex(0)
+    , backIndex(1)
+    , middleIndex(2)
+    , levelsChanged(false)
+{
+    // Default is the fundamental alone, i.e. a straight line, clipped at +/-1
+    for (int h = 0; h < numHarmonics; ++h)
+        harmonicLevels[h] = (h == 0) ? 1.0f : 0.0f;
+    compile(tables[frontIndex]);
+
+    backgroundThread->addTimeSliceClient(this);
+}
+
+TransferCurve::~TransferCurve()
+{
+    backgroundThread->removeTimeSliceClient(this);
+}
+
+void TransferCurve::setHarmonicLevels(const float* levels)
+{
+    for (int h = 0; h < numHarmonics; ++h)
+        harmonicLevels[h] = levels[h];
+    levelsChanged = true;
+}
+
+void TransferCurve::setHarmonicLevel(int h, float level)
+{
+    jassert(h >= 0 && h < numHarmonics);
+    harmonicLevels[h] = level;
+    levelsChanged = true;
+}
+
+void TransferCurve::compileNow()
+{
+    const ScopedLock lock(compileLock);
+    levelsChanged = false;
+    compile(tables[backIndex]);
+    publish();
+    update();
+}
+
+int TransferCurve::useTimeSlice()
+{
+    if (levelsChanged.exchange(false))
+    {
+        const ScopedLock lock(compileLock);
+        compile(tables[backIndex]);
+        publish();
+    }
+    return pollIntervalMs;
+}
+
+void TransferCurve::publish()
+{
+    // The new table becomes the middle one, flagged as new; the old middle becomes the back
+    backIndex = middleIndex.exchange(backIndex | newBit) & (newBit - 1);
+}
+
+void TransferCurve::update()
+{
+    // Only if the middle table is new: it becomes the front, and the old front the middle
+    if (middleIndex.load() & newBit)
+        frontIndex = middleIndex.exchange(frontIndex) & (newBit - 1);
+}
+
+void TransferCurve::compile(Table& table)
+{
+    double levels[numHarmonics];
+    for (int h = 0; h < numHarmonics; ++h)
+        levels[h] = harmonicLevels[h];
+
+    // The curve and its slope at x, by the recurrences T[k+1] = 2x T[k] - T[k-1] and
+    // T'[k+1] = 2 T[k] + 2x T'[k] - T'[k-1], starting from T[0] = 1 and T[1] = x
+    auto evaluate = [&levels](double x, double& slope)
+    {
+        double t0 = 1.0, t1 = x, d0 = 0.0, d1 = 1.0;
+        double y = 0.0;
+        slope = 0.0;
+        for (int h = 0; h < numHarmonics; ++h)
+        {
+            y += levels[h] * t1;
+            slope += levels[h] * d1;
+            const double t2 = 2.0 * x * t1 - t0;
+            const double d2 = 2.0 * t1 + 2.0 * x * d1 - d0;
+            t0 = t1; t1 = t2;
+            d0 = d1; d1 = d2;
+        }
+        return y;
+    };
+
+    double slopeAtZero;
+    const double offset = evaluate(0.0, slopeAtZero);
+
+    // Each segment is a cubic matching the curve and its slope at both ends; with t running
+    // from 0 to 1 across a segment of width w, slopes with respect to t are w times larger
+    const double width = 2.0 / numSegments;
+    double slope0, slope1;
+    double y0 = evaluate(-1.0, slope0) - offset;
+    for (int s = 0; s < numSegments; ++s)
+    {
+        const double y1 = evaluate(-1.0 + (s + 1) * width, slope1) - offset;
+        const double m0 = slope0 * width, m1 = slope1 * width;
+
+        float* c = table.coefficients[s];
+        c[0] = float(y0);
+        c[1] = float(m0);
+        c[2] = float(3.0 * (y1 - y0) - 2.0 * m0 - m1);
+        c[3] = float(2.0 * (y0 - y1) + m0 + m1);
+
+        y0 = y1;
+        slope0 = slope1;
+    }
+}
+
+void TransferCurve::processBlock(float* samples, int numSamples, float gain) const
+{
+    const Table& table = tables[frontIndex];
+    const float scale = 0.5f * numSegments;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // u runs from 0 at x = -1 to numSegments at x = +1; x = +1 is the end of the last segment
+        const float x = FastMath::min(FastMath::max(gain * samples[i], -1.0f), 1.0f);
+        const float u = (x + 1.0f) * scale;
+        const int segment = jmin(int(u), numSegments - 1);
+        const float t = u - float(segment);
+
+        const float* c = table.coefficients[segment];
+        samples[i] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "JuceHeader.h"
+#include "BackgroundThread.h"
+
+/*  TransferCurve: the user-defined wave-shaping curve of the Distortion effect's "Custom Curve"
+    type, defined by the levels of numHarmonics Chebyshev polynomials. A full-scale sine passed
+    through the Chebyshev polynomial T_k comes out as a sine at k times its frequency, so each
+    level sets the amplitude of one harmonic, for a full-scale input (smaller inputs produce
+    fewer, weaker harmonics, as with any wave-shaper). The curve is defined for inputs from -1
+    to +1, and held constant beyond those; it is shifted so that it passes through 0, so
+    silence stays silent however much of the even harmonics there is.
+
+    Evaluating the polynomials directly would cost more for every harmonic used. Instead, the
+    curve is "compiled" into a table of cubic segments (Hermite interpolation of the curve and
+    its exact slope at numSegments + 1 points), so the audio thread's cost is one segment per
+    sample, however complicated the curve.
+
+    Compiling is done on a background thread, shared by every instance of the plugin (see
+    Common/BackgroundThread.h), which checks for new levels every few milliseconds. A level
+    may be set on the audio thread, e.g. by host automation, so setting it only stores it,
+    rather than waking the thread.
+
+    Finished tables reach the audio thread through a lock-free triple buffer: the compiler
+    always has one table to write (the "back"), the audio thread one to read (the "front"),
+    and the third (the "middle") is swapped with either of them by an atomic exchange, with a
+    flag to say whether it is newer than the front. Neither thread ever waits for the other,
+    and no memory is allocated or freed after construction.
+*/
+
+class TransferCurve : private TimeSliceClient
+{
+public:
+    static const int numHarmonics = 5;
+
+    TransferCurve();
+    ~TransferCurve();
+
+    // Any thread: set the levels (-1 to +1) of harmonics 1 to numHarmonics, for the
+    // background thread to compile
+    void setHarmonicLevels(const float* levels);
+
+    // Any thread: set the level of harmonic h (0 to numHarmonics - 1) alone
+    void setHarmonicLevel(int h, float level);
+
+    // Compile the current levels on the calling thread, and make the result current, e.g. in
+    // prepareToPlay(), so processing starts with the right curve (not while processing)
+    void compileNow();
+
+    // Audio thread: pick up the most recently compiled curve, if there is a new one
+    void update();
+
+    // Audio thread: apply gain, then the curve, to numSamples samples in place
+    void processBlock(float* samples, int numSamples, float gain) const;
+
+private:
+    static const int numSegments = 256;
+
+    // Each segment is c0 + t * (c1 + t * (c2 + t * c3)), t from 0 to 1 across the segment
+    struct Table
+    {
+        float coefficients[numSegments][4];
+    };
+
+    int useTimeSlice() override;
+    void compile(Table& table);
+    void publish();
+
+    Table tables[3];
+    int frontIndex;                         // audio thread's
+    int backIndex;                          // compiler's
+    std::atomic<int> middleIndex;           // index, plus newBit if newer than the front
+    static const int newBit = 4;
+
+    std::atomic<float> harmonicLevels[numHarmonics];
+    std::atomic<bool> levelsChanged;
+    CriticalSection compileLock;            // compileNow() vs. the background thread
+    SharedResourcePointer<BackgroundThread> backgroundThread;
+
+    JUCE_DECLARE_NON_COPYABLE(TransferCurve)
+};
@@ -0,0 +1,357 @@
+#include "LinearPhaseEQ.h"
+
+namespace
+{
+    // How often the background thread checks for new bands
+    const int pollIntervalMs = 20;
+
+    // Rounded up to a power of two, and never less than two partitions of the largest block
+    const double filterLengthSec = 0.08;
+    const int minFirLength = 4096;
+
+    // Block size b's FFTs are of 2 * (128 << b) samples, i.e. 2 to the power 8 + b
+    const int smallestFFTOrder = 8;
+
+    int getOrder(int powerOfTwo)
+    {
+        int order = 0;
+        while ((1 << order) < powerOfTwo) ++order;
+        return order;
+    }
+}
+
+void LinearPhaseEQ::populateModeComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("IIR", ++itemNumber);
+    cb.addItem("Linear Phase", ++itemNumber);
+}
+
+void LinearPhaseEQ::populateBlockSizeComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    for (int b = 0; b < kNumBlockSizes; ++b)
+        cb.addItem(String(getBlockSamples(BlockSize(b))), ++itemNumber);
+}
+
+LinearPhaseEQ::LinearPhaseEQ()
+    : firLength(0)
+    , maxBins(0)
+    , frontIndex(0)
+    , previousIndex(1)
+    , backIndex(2)
+    , middleIndex(3)
+    , blockSize(kBlock512)
+    , blockSamples(getBlockSamples(kBlock512))
+    , position(0)
+    , delayLineHead(0)
+    , crossfading(false)
+    , requestedBlockSize(int(kBlock512))
+    , bandsChanged(false)
+{
+    for (auto& filter : filters)
+    {
+        filter.blockSize = kBlock512;
+        filter.numPartitions = 0;
+    }
+
+    for (int b = 0; b < kNumBlockSizes; ++b)
+    {
+        ffts.add(new RealFFT(smallestFFTOrder + b));
+        designFFTs.add(new RealFFT(smallestFFTOrder + b));
+    }
+
+    const int maxBlockSamples = getBlockSamples(BlockSize(kNumBlockSizes - 1));
+    sumRe.allocate(maxBlockSamples + 1, true);
+    sumIm.allocate(maxBlockSamples + 1, true);
+    blockOutput.allocate(2 * maxBlockSamples, true);
+    fadeOutput.allocate(maxBlockSamples, true);
+    partition.allocate(2 * maxBlockSamples, true);
+
+    // Every band off, i.e. a filter which only delays
+    ParametricEQFilter::Coefficients bands[numBands];
+    for (auto& band : bands)
+        band = ParametricEQFilter::makeBand(ParametricEQFilter::kOff, 1.0, 1.0, 1.0);
+    setBands(bands, kBlock512);
+
+    backgroundThread->addTimeSliceClient(this);
+}
+
+LinearPhaseEQ::~LinearPhaseEQ()
+{
+    backgroundThread->removeTimeSliceClient(this);
+}
+
+void LinearPhaseEQ::prepare(double sampleRate, int numChannels)
+{
+    const ScopedLock lock(designLock);
+
+    const int maxBlockSamples = getBlockSamples(BlockSize(kNumBlockSizes - 1));
+    const int newFirLength = jmax(minFirLength, nextPowerOfTwo(roundToInt(sampleRate * filterLengthSec)));
+    if (newFirLength != firLength)
+    {
+        firLength = newFirLength;
+
+        // The smallest blocks have the most bins in all, counting each partition's Nyquist bin
+        maxBins = 0;
+        for (int b = 0; b < kNumBlockSizes; ++b)
+        {
+            const int numSamples = getBlockSamples(BlockSize(b));
+            maxBins = jmax(maxBins, (firLength / numSamples) * (numSamples + 1));
+        }
+
+        for (auto& filter : filters)
+        {
+            filter.re.allocate(maxBins, true);
+            filter.im.allocate(maxBins, true);
+            filter.numPartitions = 0;
+        }
+
+        designFFT.reset(new RealFFT(getOrder(firLength)));
+        designRe.allocate(firLength / 2 + 1, true);
+        designIm.allocate(firLength / 2 + 1, true);
+        impulse.allocate(firLength, true);
+
+        // Every channel's delay line is the wrong size now
+        channels.clear();
+    }
+
+    while (channels.size() < numChannels)
+    {
+        auto channel = channels.add(new Channel);
+        channel->input.allocate(2 * maxBlockSamples, true);
+        channel->output.allocate(maxBlockSamples, true);
+        channel->delayLineRe.allocate(maxBins, true);
+        channel->delayLineIm.allocate(maxBins, true);
+    }
+
+    reset();
+}
+
+int LinearPhaseEQ::getLatencySamples(BlockSize blockSizeToUse) const
+{
+    return firLength / 2 + getBlockSamples(blockSizeToUse);
+}
+
+void LinearPhaseEQ::setBands(const ParametricEQFilter::Coefficients* bands, BlockSize blockSizeToUse)
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        bandCoefficients[band][0] = bands[band].b0;
+        bandCoefficients[band][1] = bands[band].b1;
+        bandCoefficients[band][2] = bands[band].b2;
+        bandCoefficients[band][3] = bands[band].a1;
+        bandCoefficients[band][4] = bands[band].a2;
+    }
+    requestedBlockSize = int(blockSizeToUse);
+    bandsChanged = true;
+}
+
+void LinearPhaseEQ::designNow()
+{
+    const ScopedLock lock(designLock);
+    bandsChanged = false;
+    design(filters[backIndex]);
+    publish();
+    pickUpFilter(false);
+}
+
+int LinearPhaseEQ::useTimeSlice()
+{
+    if (bandsChanged.exchange(false))
+    {
+        // (before prepare(), there is nothing to design for; designNow() will do it)
+        const ScopedLock lock(designLock);
+        if (firLength > 0)
+        {
+            design(filters[backIndex]);
+            publish();
+        }
+    }
+    return pollIntervalMs;
+}
+
+void LinearPhaseEQ::publish()
+{
+    // The new filter becomes the middle one, flagged as new; the old middle becomes the back
+    backIndex = middleIndex.exchange(backIndex | newBit) & (newBit - 1);
+}
+
+bool LinearPhaseEQ::pickUpFilter(bool crossfade)
+{
+    // Only if the middle filter is new: it becomes the current one, the current one the
+    // previous, and the previous one, which is no longer used, the middle
+    if ((middleIndex.load() & newBit) == 0) return false;
+    const int newIndex = middleIndex.exchange(previousIndex) & (newBit - 1);
+    previousIndex = frontIndex;
+    frontIndex = newIndex;
+
+    if (filters[frontIndex].blockSize != blockSize)
+    {
+        blockSize = filters[frontIndex].blockSize;
+        blockSamples = getBlockSamples(blockSize);
+        reset();
+        return true;
+    }
+    crossfading = crossfade;
+    return false;
+}
+
+void LinearPhaseEQ::design(Filter& filter)
+{
+    double b[numBands][5];
+    for (int band = 0; band < numBands; ++band)
+        for (int i = 0; i < 5; ++i)
+            b[band][i] = bandCoefficients[band][i];
+    const BlockSize blockSizeToUse = BlockSize(requestedBlockSize.load());
+
+    // The magnitude response at every bin. On the unit circle, |b0 + b1 z^-1 + b2 z^-2|^2 is
+    // b0^2 + b1^2 + b2^2 + 2 (b0 b1 + b1 b2) cos w + 2 b0 b2 cos 2w, and likewise for
+    // 1 + a1 z^-1 + a2 z^-2.
+    const int numBins = firLength / 2 + 1;
+    for (int k = 0; k < numBins; ++k)
+    {
+        const double w = MathConstants<double>::twoPi * k / firLength;
+        const double cos1 = std::cos(w), cos2 = std::cos(2.0 * w);
+        double magnitude = 1.0;
+        for (auto& c : b)
+        {
+            const double numerator = c[0] * c[0] + c[1] * c[1] + c[2] * c[2]
+                                   + 2.0 * (c[0] * c[1] + c[1] * c[2]) * cos1 + 2.0 * c[0] * c[2] * cos2;
+            const double denominator = 1.0 + c[3] * c[3] + c[4] * c[4]
+                                     + 2.0 * (c[3] + c[3] * c[4]) * cos1 + 2.0 * c[4] * cos2;
+            magnitude *= std::sqrt(jmax(0.0, numerator) / denominator);
+        }
+        designRe[k] = float(magnitude);
+        designIm[k] = 0.0f;
+    }
+    designFFT->performInverse(designRe, designIm, impulse);
+
+    // The impulse response is centred on sample 0, wrapping around from the end; move its
+    // centre to firLength / 2, and window it. The window is 0 at tap 0, so the other taps are
+    // symmetric about the centre. The scale undoes the design's inverse FFT, and the one each
+    // block's output will go through.
+    const int numSamples = getBlockSamples(blockSizeToUse);
+    const int bins = numSamples + 1;
+    const double scale = 1.0 / (double(firLength) * 2.0 * numSamples);
+    RealFFT& fft = *designFFTs[int(blockSizeToUse)];
+
+    filter.blockSize = blockSizeToUse;
+    filter.numPartitions = firLength / numSamples;
+    for (int p = 0; p < filter.numPartitions; ++p)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int tap = p * numSamples + i;
+            const double window = 0.5 - 0.5 * std::cos(MathConstants<double>::twoPi * tap / firLength);
+            partition[i] = float(impulse[(tap + firLength / 2) & (firLength - 1)] * window * scale);
+        }
+        FloatVectorOperations::clear(partition + numSamples, numSamples);
+        fft.performForward(partition, filter.re + p * bins, filter.im + p * bins);
+    }
+}
+
+void LinearPhaseEQ::reset()
+{
+    const int maxBlockSamples = getBlockSamples(BlockSize(kNumBlockSizes - 1));
+    for (auto channel : channels)
+    {
+        FloatVectorOperations::clear(channel->input, 2 * maxBlockSamples);
+        FloatVectorOperations::clear(channel->output, maxBlockSamples);
+        FloatVectorOperations::clear(channel->delayLineRe, maxBins);
+        FloatVectorOperations::clear(channel->delayLineIm, maxBins);
+    }
+    position = 0;
+    delayLineHead = 0;
+    crossfading = false;
+}
+
+void LinearPhaseEQ::processBlock(AudioBuffer<float>& buffer, int numChannels)
+{
+    jassert(numChannels <= channels.size());
+    const int numSamples = buffer.getNumSamples();
+
+    // Each input sample is stored for the next block's FFT, and replaced by the output sample
+    // from the same position in the last block
+    for (int done = 0; done < numSamples;)
+    {
+        const int count = jmin(numSamples - done, blockSamples - position);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = buffer.getWritePointer(ch) + done;
+            auto channel = channels[ch];
+            FloatVectorOperations::copy(channel->input + blockSamples + position, data, count);
+            FloatVectorOperations::copy(data, channel->output + position, count);
+        }
+
+        done += count;
+        position += count;
+        if (position == blockSamples)
+        {
+            processPartition(numChannels);
+            position = 0;
+        }
+    }
+}
+
+void LinearPhaseEQ::processPartition(int numChannels)
+{
+    // (a new block size clears everything, including the block just collected)
+    if (pickUpFilter(true)) return;
+
+    const Filter& filter = filters[frontIndex];
+    jassert(filter.numPartitions > 0);      // designNow() has not been called
+    const int bins = blockSamples + 1;
+    RealFFT& fft = *ffts[int(blockSize)];
+
+    // The delay line is circular, and runs backwards, so partition p always goes with the
+    // spectrum p blocks after the newest
+    delayLineHead = (delayLineHead + filter.numPartitions - 1) % filter.numPartitions;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        Channel& channel = *channels[ch];
+        fft.performForward(channel.input, channel.delayLineRe + delayLineHead * bins,
+                           channel.delayLineIm + delayLineHead * bins);
+        FloatVectorOperations::copy(channel.input, channel.input + blockSamples, blockSamples);
+
+        convolve(channel, filter, channel.output);
+        if (crossfading)
+        {
+            convolve(channel, filters[previousIndex], fadeOutput);
+            const float step = 1.0f / blockSamples;
+            for (int i = 0; i < blockSamples; ++i)
+                channel.output[i] = fadeOutput[i] + (channel.output[i] - fadeOutput[i]) * step * (i + 1);
+        }
+    }
+    crossfading = false;
+}
+
+void LinearPhaseEQ::convolve(const Channel& channel, const Filter& filter, float* output)
+{
+    const int bins = blockSamples + 1;
+    float* sr = sumRe;
+    float* si = sumIm;
+    FloatVectorOperations::clear(sr, bins);
+    FloatVectorOperations::clear(si, bins);
+
+    for (int p = 0; p < filter.numPartitions; ++p)
+    {
+        const int slot = (delayLineHead + p) % filter.numPartitions;
+        const float* xr = channel.delayLineRe + slot * bins;
+        const float* xi = channel.delayLineIm + slot * bins;
+        const float* hr = filter.re + p * bins;
+        const float* hi = filter.im + p * bins;
+        for (int k = 0; k < bins; ++k)
+        {
+            sr[k] += xr[k] * hr[k] - xi[k] * hi[k];
+            si[k] += xr[k] * hi[k] + xi[k] * hr[k];
+        }
+    }
+
+    // The first half of the inverse FFT wraps around, and is discarded (overlap-save)
+    ffts[int(blockSize)]->performInverse(sr, si, blockOutput);
+    FloatVectorOperations::copy(output, blockOutput + blockSamples, blockSamples);
+}
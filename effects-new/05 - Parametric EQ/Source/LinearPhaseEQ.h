@@ -0,0 +1,143 @@
+#pragma once
+#include "JuceHeader.h"
+#include "ParametricEQFilter.h"
+#include "RealFFT.h"
+#include "BackgroundThread.h"
+
+/*  LinearPhaseEQ: the Parametric EQ's "Linear Phase" mode. The magnitude response of the same
+    numBands IIR sections the normal mode uses is turned into a symmetric FIR filter, so every
+    frequency is delayed by the same amount (half the filter's length) and the EQ changes only
+    the levels of a signal's components, never their timing relative to one another.
+
+    Designing the filter: the sections' combined magnitude response is evaluated at every bin
+    of an FFT the length of the filter, the inverse FFT of that (with no phase at all) is
+    shifted to the middle of the filter and Hann-windowed. The filter is about 80 ms long
+    (rounded up to a power of two), enough for the lowest band's default 60 Hz.
+
+    Running it: a long FIR filter costs far less by FFT than sample by sample. It is split into
+    partitions of blockSize taps, each held as the spectrum of a 2 * blockSize FFT. Every
+    blockSize input samples, the newest 2 * blockSize inputs are transformed, and their
+    spectrum goes into a frequency-domain delay line, so the output block is the sum of each
+    partition's spectrum times the spectrum of the input as it was that many blocks ago,
+    transformed back (uniformly partitioned overlap-save convolution). The output lags one
+    block behind the input, so the block size is a trade-off: small blocks mean little added
+    latency, but many partitions to multiply and add for every block.
+
+    Designs are made on a background thread, shared by every instance of the plugin (see
+    Common/BackgroundThread.h), which checks for new bands every few milliseconds, as the
+    Distortion's TransferCurve does; the processor only asks for them while this mode is in
+    use. They reach the audio thread through a
+    quadruple buffer: as with a triple buffer, the designer always has one filter to write, and
+    swaps it with a "middle" one by an atomic exchange, but the audio thread keeps two, the
+    current filter and the previous one. When it picks up a new filter, it runs both over the
+    next block and crossfades from the old output to the new, so changes never click; the
+    previous filter is finished with by the time the next one can arrive. A new block size
+    cannot be crossfaded (the latency changes anyway), so all signal history is cleared.
+    Neither thread ever waits for the other, and nothing is allocated after prepare().
+*/
+
+class LinearPhaseEQ : private TimeSliceClient
+{
+public:
+    enum Mode
+    {
+        kModeIIR = 0,
+        kModeLinearPhase,
+        kNumModes
+    };
+    static void populateModeComboBox(ComboBox& cb);
+
+    enum BlockSize
+    {
+        kBlock128 = 0,
+        kBlock256,
+        kBlock512,
+        kBlock1024,
+        kBlock2048,
+        kNumBlockSizes
+    };
+    static void populateBlockSizeComboBox(ComboBox& cb);
+    static int getBlockSamples(BlockSize blockSize) { return 128 << int(blockSize); }
+
+    LinearPhaseEQ();
+    ~LinearPhaseEQ();
+
+    // Not while processing: size everything for the sample rate and number of channels.
+    // Call designNow() before processing.
+    void prepare(double sampleRate, int numChannels);
+
+    // Total delay through the filter (after prepare()), including one block of buffering
+    int getLatencySamples(BlockSize blockSize) const;
+
+    // Audio thread: the same, for the block size actually in use, which only changes when a
+    // filter designed for a new one is picked up
+    int getCurrentLatencySamples() const { return getLatencySamples(blockSize); }
+
+    // Any thread: the sections whose magnitude response to design a filter for, and the block
+    // size to run it with, for the background thread to design
+    void setBands(const ParametricEQFilter::Coefficients* bands, BlockSize blockSize);
+
+    // Design a filter for the current bands on the calling thread, and make it current with
+    // no crossfade, e.g. in prepareToPlay() (not while processing)
+    void designNow();
+
+    // Audio thread: clear all signal history
+    void reset();
+
+    // Audio thread: filter the first numChannels channels of the buffer in place
+    void processBlock(AudioBuffer<float>& buffer, int numChannels);
+
+private:
+    static const int numBands = ParametricEQFilter::numBands;
+
+    // Partition p's bins are elements p * numBins to (p + 1) * numBins - 1
+    struct Filter
+    {
+        BlockSize blockSize;
+        int numPartitions;
+        HeapBlock<float> re, im;
+    };
+
+    // The input since the last block began, after the one before it; each block's spectrum,
+    // newest at delayLineHead; and the output of the last block
+    struct Channel
+    {
+        HeapBlock<float> input, output, delayLineRe, delayLineIm;
+    };
+
+    int useTimeSlice() override;
+    void design(Filter& filter);
+    void publish();
+    bool pickUpFilter(bool crossfade);
+    void processPartition(int numChannels);
+    void convolve(const Channel& channel, const Filter& filter, float* output);
+
+    int firLength;                          // 0 until prepare()
+    int maxBins;                            // most bins of all partitions, over all block sizes
+
+    Filter filters[4];
+    int frontIndex, previousIndex;          // audio thread's
+    int backIndex;                          // designer's
+    std::atomic<int> middleIndex;           // index, plus newBit if newer than the front
+    static const int newBit = 4;
+
+    // Audio thread
+    OwnedArray<Channel> channels;
+    OwnedArray<RealFFT> ffts;               // one per block size, of 2 * blockSize
+    HeapBlock<float> sumRe, sumIm, blockOutput, fadeOutput;
+    BlockSize blockSize;
+    int blockSamples, position, delayLineHead;
+    bool crossfading;
+
+    // Designer
+    std::atomic<double> bandCoefficients[numBands][5];
+    std::atomic<int> requestedBlockSize;
+    std::atomic<bool> bandsChanged;
+    OwnedArray<RealFFT> designFFTs;         // as ffts
+    std::unique_ptr<RealFFT> designFFT;     // of firLength
+    HeapBlock<float> designRe, designIm, impulse, partition;
+    CriticalSection designLock;             // designNow() and prepare() vs. the background thread
+    SharedResourcePointer<BackgroundThread> backgroundThread;
+
+    JUCE_DECLARE_NON_COPYABLE(LinearPhaseEQ)
+};
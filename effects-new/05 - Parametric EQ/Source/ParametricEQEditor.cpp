@@ -4,38 +4,83 @@
 ParametricEQEditor::ParametricEQEditor (ParametricEQProcessor& p)
     : AudioProcessorEditor (&p)
     , processor (p)
-    , centreFreqKnob(10.0f, 20000.0f), labeledCentreFreqKnob("Centre Freq", centreFreqKnob)
-    , filterQKnob(0.1f, 20.0f), labeledFilterQKnob("Q", filterQKnob)
-    , gainKnob(-12.0f, 12.0f), labeledGainKnob("Gain", gainKnob)
 {
     setLookAndFeel(lookAndFeel);
 
     mainGroup.setText("ParametricEQ");
     addAndMakeVisible(&mainGroup);
 
-    centreFreqKnob.setDoubleClickReturnValue(true, 1000.0, ModifierKeys::noModifiers);
-    addAndMakeVisible(labeledCentreFreqKnob);
-    filterQKnob.setDoubleClickReturnValue(true, 2.0, ModifierKeys::noModifiers);
-    addAndMakeVisible(labeledFilterQKnob);
-    gainKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
-    addAndMakeVisible(labeledGainKnob);
+    Array<ComboBox*> bandTypeComboPtrs;
+    Array<Slider*> centreFreqKnobPtrs, filterQKnobPtrs, gainKnobPtrs;
+    for (int band = 0; band < ParametricEQFilter::numBands; ++band)
+    {
+        auto bandTypeCombo = bandTypeCombos.add(new ComboBox);
+        bandTypeCombo->setEditableText(false);
+        bandTypeCombo->setJustificationType(Justification::centredLeft);
+        ParametricEQFilter::populateBandTypeComboBox(*bandTypeCombo);
+        addAndMakeVisible(bandTypeCombo);
+        bandTypeComboPtrs.add(bandTypeCombo);
 
-    addAndMakeVisible(bandwidthLabel);
+        auto centreFreqKnob = centreFreqKnobs.add(new BasicKnob(10.0f, 20000.0f));
+        labeledCentreFreqKnobs.add(new LabeledKnob("Freq", *centreFreqKnob));
+        centreFreqKnob->setDoubleClickReturnValue(true, double(ParametricEQParameters::centreFreqDefault[band]),
+                                                  ModifierKeys::noModifiers);
+        addAndMakeVisible(labeledCentreFreqKnobs[band]);
+        centreFreqKnobPtrs.add(centreFreqKnob);
+
+        auto filterQKnob = filterQKnobs.add(new BasicKnob(0.1f, 20.0f));
+        labeledFilterQKnobs.add(new LabeledKnob("Q", *filterQKnob));
+        filterQKnob->setDoubleClickReturnValue(true, 2.0, ModifierKeys::noModifiers);
+        addAndMakeVisible(labeledFilterQKnobs[band]);
+        filterQKnobPtrs.add(filterQKnob);
+
+        auto gainKnob = gainKnobs.add(new DecibelKnob(-12.0f, 12.0f));
+        labeledGainKnobs.add(new LabeledKnob("Gain", *gainKnob));
+        gainKnob->setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
+        addAndMakeVisible(labeledGainKnobs[band]);
+        gainKnobPtrs.add(gainKnob);
+
+        auto bandwidthLabel = bandwidthLabels.add(new Label);
+        bandwidthLabel->setJustificationType(Justification::centred);
+        addAndMakeVisible(bandwidthLabel);
+    }
+
+    phaseModeLabel.setText("Phase", dontSendNotification);
+    phaseModeLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&phaseModeLabel);
+
+    phaseModeCombo.setEditableText(false);
+    phaseModeCombo.setJustificationType(Justification::centredLeft);
+    LinearPhaseEQ::populateModeComboBox(phaseModeCombo);
+    addAndMakeVisible(phaseModeCombo);
+
+    firBlockSizeLabel.setText("FIR Block", dontSendNotification);
+    firBlockSizeLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&firBlockSizeLabel);
+
+    firBlockSizeCombo.setEditableText(false);
+    firBlockSizeCombo.setJustificationType(Justification::centredLeft);
+    LinearPhaseEQ::populateBlockSizeComboBox(firBlockSizeCombo);
+    addAndMakeVisible(firBlockSizeCombo);
 
     processor.parameters.attachControls(
-        centreFreqKnob,
-        filterQKnob,
-        gainKnob );
+        bandTypeComboPtrs,
+        centreFreqKnobPtrs,
+        filterQKnobPtrs,
+        gainKnobPtrs,
+        phaseModeCombo,
+        firBlockSizeCombo );
 
-    processor.addChangeListener(this);
-    changeListenerCallback(nullptr);    // force 1st update of bandwidthLabel
+    // Keep bandwidthLabels and the FIR block size's enabled state up to date, starting now
+    timerCallback();
+    startTimerHz(10);
 
-    setSize (60 + 100 * 3 + 10 * (3 - 1), 200);
+    setSize (60 + 80 * ParametricEQFilter::numBands + 10 * (ParametricEQFilter::numBands - 1), 434);
 }
 
 ParametricEQEditor::~ParametricEQEditor()
 {
-    processor.removeChangeListener(this);
+    stopTimer();
     processor.parameters.detachControls();
     setLookAndFeel(nullptr);
 }
@@ -48,15 +93,32 @@ void ParametricEQEditor::resized()
     auto widgetsArea = bounds.reduced(10);
     widgetsArea.removeFromTop(16);
 
-    bandwidthLabel.setBounds(widgetsArea.removeFromTop(20).reduced(20, 0));
-    widgetsArea.removeFromTop(4);
+    auto modeArea = widgetsArea.removeFromBottom(24);
+    phaseModeLabel.setBounds(modeArea.removeFromLeft(80));
+    phaseModeCombo.setBounds(modeArea.removeFromLeft(140));
+    modeArea.removeFromLeft(20);
+    firBlockSizeLabel.setBounds(modeArea.removeFromLeft(80));
+    firBlockSizeCombo.setBounds(modeArea.removeFromLeft(100));
+    widgetsArea.removeFromBottom(10);
+
+    // One column per band: type, bandwidth readout, then the three knobs
+    for (int band = 0; band < ParametricEQFilter::numBands; ++band)
+    {
+        auto columnArea = widgetsArea.removeFromLeft(80);
+        widgetsArea.removeFromLeft(10);
 
-    int width = (widgetsArea.getWidth() - (3 - 1) * 10) / 3;
-    labeledCentreFreqKnob.setBounds(widgetsArea.removeFromLeft(width));
-    widgetsArea.removeFromLeft(10);
-    labeledFilterQKnob.setBounds(widgetsArea.removeFromLeft(width));
-    widgetsArea.removeFromLeft(10);
-    labeledGainKnob.setBounds(widgetsArea);
+        bandTypeCombos[band]->setBounds(columnArea.removeFromTop(24));
+        columnArea.removeFromTop(4);
+        bandwidthLabels[band]->setBounds(columnArea.removeFromTop(20));
+        columnArea.removeFromTop(4);
+
+        int height = (columnArea.getHeight() - (3 - 1) * 10) / 3;
+        labeledCentreFreqKnobs[band]->setBounds(columnArea.removeFromTop(height));
+        columnArea.removeFromTop(10);
+        labeledFilterQKnobs[band]->setBounds(columnArea.removeFromTop(height));
+        columnArea.removeFromTop(10);
+        labeledGainKnobs[band]->setBounds(columnArea);
+    }
 }
 
 void ParametricEQEditor::paint (Graphics& g)
@@ -65,8 +127,17 @@ void ParametricEQEditor::paint (Graphics& g)
     g.fillAll(lookAndFeel->findColour(ResizableWindow::backgroundColourId));
 }
 
-void ParametricEQEditor::changeListenerCallback(ChangeBroadcaster*)
+void ParametricEQEditor::timerCallback()
 {
-    String bws = "Bandwidth " + String(processor.parameters.getBandwidthHz()) + " Hz";
-    bandwidthLabel.setText(bws, dontSendNotification);
+    for (int band = 0; band < ParametricEQFilter::numBands; ++band)
+    {
+        // Bandwidth only means something for peaking bands
+        String bws;
+        if (processor.parameters.bandType[band] == ParametricEQFilter::kPeaking)
+            bws = "BW " + String(roundToInt(processor.parameters.getBandwidthHz(band))) + " Hz";
+        bandwidthLabels[band]->setText(bws, dontSendNotification);
+    }
+
+    // The block size only matters to the linear-phase filter
+    firBlockSizeCombo.setEnabled(processor.parameters.phaseMode == LinearPhaseEQ::kModeLinearPhase);
 }
@@ -5,7 +5,7 @@
 #include "DecibelKnob.h"
 
 class ParametricEQEditor : public AudioProcessorEditor
-                         , public ChangeListener
+                         , protected Timer
 {
 public:
     ParametricEQEditor (ParametricEQProcessor&);
@@ -15,8 +15,9 @@ public:
     void paint (Graphics&) override;
     void resized() override;
 
-    // ChangeListener
-    void changeListenerCallback(ChangeBroadcaster*) override;
+protected:
+    // Timer: polls the bandwidths and the phase mode
+    void timerCallback() override;
 
 private:
     SharedResourcePointer<BasicLookAndFeel> lookAndFeel;
@@ -24,11 +25,16 @@ private:
 
     GroupComponent mainGroup;
 
-    BasicKnob centreFreqKnob; LabeledKnob labeledCentreFreqKnob;
-    BasicKnob filterQKnob; LabeledKnob labeledFilterQKnob;
-    DecibelKnob gainKnob; LabeledKnob labeledGainKnob;
+    // One of each per band, in a column
+    OwnedArray<ComboBox> bandTypeCombos;
+    OwnedArray<BasicKnob> centreFreqKnobs; OwnedArray<LabeledKnob> labeledCentreFreqKnobs;
+    OwnedArray<BasicKnob> filterQKnobs; OwnedArray<LabeledKnob> labeledFilterQKnobs;
+    OwnedArray<DecibelKnob> gainKnobs; OwnedArray<LabeledKnob> labeledGainKnobs;
+    OwnedArray<Label> bandwidthLabels;
 
-    Label bandwidthLabel;
+    // For all bands, along the bottom
+    ComboBox phaseModeCombo; Label phaseModeLabel;
+    ComboBox firBlockSizeCombo; Label firBlockSizeLabel;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParametricEQEditor)
 };
\ No newline at end of file
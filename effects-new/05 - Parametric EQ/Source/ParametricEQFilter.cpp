@@ -1,34 +1,192 @@
 #include "ParametricEQFilter.h"
 #define PI_D 3.141592654
 
-/* The actual audio processing is handled by the Juce IIRFilter parent
- * class. This subclass is used to define the coefficients for our
- * implementation of a parametric equaliser.
- */
+void ParametricEQFilter::populateBandTypeComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Off", ++itemNumber);
+    cb.addItem("Peaking", ++itemNumber);
+    cb.addItem("Low Shelf", ++itemNumber);
+    cb.addItem("High Shelf", ++itemNumber);
+    cb.addItem("High Pass", ++itemNumber);
+    cb.addItem("Low Pass", ++itemNumber);
+}
 
-void ParametricEQFilter::makeParametric(const double discreteFrequency,
-                                        const double Q,
-                                        const double gainFactor) noexcept
+ParametricEQFilter::Coefficients ParametricEQFilter::makeBand(BandType type,
+                                                              const double discreteFrequency,
+                                                              const double Q,
+                                                              const double gainFactor) noexcept
 {
     jassert (discreteFrequency > 0);
     jassert (Q > 0);
-    
-    // Limit the bandwidth so we don't get a nonsense result from tan(B/2)
-    const double bandwidth = jmin(discreteFrequency / Q, PI_D * 0.99);
-    const double two_cos_wc = -2.0*cos(discreteFrequency);
-    const double tan_half_bw = tan(bandwidth / 2.0);
-    const double g_tan_half_bw = gainFactor * tan_half_bw;
-    const double sqrt_g = sqrt(gainFactor);
-    
-    // setCoefficients() takes arguments: b0, b1, b2, a0, a1, a2
-    //It will normalise the filter according to the value of a0
-    //to allow standard time-domain implementations
-    coefficients = IIRCoefficients(sqrt_g + g_tan_half_bw,  // b0
-                                   sqrt_g * two_cos_wc,     // b1
-                                   sqrt_g - g_tan_half_bw,  // b2
-                                   sqrt_g + tan_half_bw,    // a0
-                                   sqrt_g * two_cos_wc,     // a1
-                                   sqrt_g - tan_half_bw);   // a2
-    
-    setCoefficients(coefficients);
+
+    // Keep the frequency below Nyquist, e.g. 20 kHz at a sample rate of 32 kHz
+    const double wc = jmin(discreteFrequency, PI_D * 0.99);
+    const double cos_wc = cos(wc);
+    const double alpha = sin(wc) / (2.0 * Q);
+    const double A = sqrt(gainFactor);
+    const double two_sqrt_A_alpha = 2.0 * sqrt(A) * alpha;
+
+    // b0, b1, b2, a0, a1, a2, normalised below according to the value of a0
+    double b[3] = { 1.0, 0.0, 0.0 }, a[3] = { 1.0, 0.0, 0.0 };
+    switch (type)
+    {
+        case kPeaking:
+        {
+            // Limit the bandwidth so we don't get a nonsense result from tan(B/2)
+            const double bandwidth = jmin(wc / Q, PI_D * 0.99);
+            const double two_cos_wc = -2.0 * cos_wc;
+            const double tan_half_bw = tan(bandwidth / 2.0);
+            const double g_tan_half_bw = gainFactor * tan_half_bw;
+            const double sqrt_g = A;
+            b[0] = sqrt_g + g_tan_half_bw;  b[1] = sqrt_g * two_cos_wc;  b[2] = sqrt_g - g_tan_half_bw;
+            a[0] = sqrt_g + tan_half_bw;    a[1] = sqrt_g * two_cos_wc;  a[2] = sqrt_g - tan_half_bw;
+            break;
+        }
+        case kLowShelf:
+            b[0] = A * ((A + 1.0) - (A - 1.0) * cos_wc + two_sqrt_A_alpha);
+            b[1] = 2.0 * A * ((A - 1.0) - (A + 1.0) * cos_wc);
+            b[2] = A * ((A + 1.0) - (A - 1.0) * cos_wc - two_sqrt_A_alpha);
+            a[0] = (A + 1.0) + (A - 1.0) * cos_wc + two_sqrt_A_alpha;
+            a[1] = -2.0 * ((A - 1.0) + (A + 1.0) * cos_wc);
+            a[2] = (A + 1.0) + (A - 1.0) * cos_wc - two_sqrt_A_alpha;
+            break;
+        case kHighShelf:
+            b[0] = A * ((A + 1.0) + (A - 1.0) * cos_wc + two_sqrt_A_alpha);
+            b[1] = -2.0 * A * ((A - 1.0) + (A + 1.0) * cos_wc);
+            b[2] = A * ((A + 1.0) + (A - 1.0) * cos_wc - two_sqrt_A_alpha);
+            a[0] = (A + 1.0) - (A - 1.0) * cos_wc + two_sqrt_A_alpha;
+            a[1] = 2.0 * ((A - 1.0) - (A + 1.0) * cos_wc);
+            a[2] = (A + 1.0) - (A - 1.0) * cos_wc - two_sqrt_A_alpha;
+            break;
+        case kHighPass:
+            b[0] = 0.5 * (1.0 + cos_wc);  b[1] = -(1.0 + cos_wc);  b[2] = 0.5 * (1.0 + cos_wc);
+            a[0] = 1.0 + alpha;           a[1] = -2.0 * cos_wc;    a[2] = 1.0 - alpha;
+            break;
+        case kLowPass:
+            b[0] = 0.5 * (1.0 - cos_wc);  b[1] = 1.0 - cos_wc;     b[2] = 0.5 * (1.0 - cos_wc);
+            a[0] = 1.0 + alpha;           a[1] = -2.0 * cos_wc;    a[2] = 1.0 - alpha;
+            break;
+        default:
+            break;
+    }
+
+    return { b[0] / a[0], b[1] / a[0], b[2] / a[0], a[1] / a[0], a[2] / a[0] };
+}
+
+ParametricEQFilter::ParametricEQFilter()
+    : rampLength(0)
+    , rampSamplesRemaining(0)
+    , targetsChanged(false)
+{
+    for (int k = 0; k < numBands; ++k)
+        setBand(k, makeBand(kOff, 1.0, 1.0, 1.0));
+    jumpToTargets();
+    reset();
+}
+
+void ParametricEQFilter::setBand(int band, const Coefficients& c) noexcept
+{
+    targets.b0[band] = float(c.b0);
+    targets.b1[band] = float(c.b1);
+    targets.b2[band] = float(c.b2);
+    targets.a1[band] = float(c.a1);
+    targets.a2[band] = float(c.a2);
+    targetsChanged = true;
+}
+
+void ParametricEQFilter::jumpToTargets() noexcept
+{
+    coefficients = targets;
+    targetsChanged = false;
+    rampSamplesRemaining = 0;
+}
+
+void ParametricEQFilter::reset() noexcept
+{
+    for (int k = 0; k < numBands; ++k)
+        s1[k] = s2[k] = 0.0f;
+}
+
+void ParametricEQFilter::processSamples(float* samples, int numSamples) noexcept
+{
+    if (targetsChanged)
+    {
+        // Start a new ramp from wherever the coefficients are now, even part way along a ramp
+        if (rampLength <= 0) jumpToTargets();
+        else
+        {
+            const float scale = 1.0f / float(rampLength);
+            for (int k = 0; k < numBands; ++k)
+            {
+                increments.b0[k] = (targets.b0[k] - coefficients.b0[k]) * scale;
+                increments.b1[k] = (targets.b1[k] - coefficients.b1[k]) * scale;
+                increments.b2[k] = (targets.b2[k] - coefficients.b2[k]) * scale;
+                increments.a1[k] = (targets.a1[k] - coefficients.a1[k]) * scale;
+                increments.a2[k] = (targets.a2[k] - coefficients.a2[k]) * scale;
+            }
+            rampSamplesRemaining = rampLength;
+            targetsChanged = false;
+        }
+    }
+
+    if (rampSamplesRemaining > 0)
+    {
+        const int numRamped = jmin(numSamples, rampSamplesRemaining);
+        processPipeline<true>(samples, numRamped);
+        samples += numRamped;
+        numSamples -= numRamped;
+
+        // Land exactly on the targets, rather than wherever rounding errors have got to
+        rampSamplesRemaining -= numRamped;
+        if (rampSamplesRemaining == 0) jumpToTargets();
+    }
+
+    processPipeline<false>(samples, numSamples);
+}
+
+template <bool ramping>
+void ParametricEQFilter::processPipeline(float* samples, int numSamples) noexcept
+{
+    if (numSamples < numBands)
+    {
+        // Too few samples to fill the pipeline: just run each section over the block in turn
+        for (int k = 0; k < numBands; ++k)
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] = processSection<ramping>(k, samples[i]);
+        return;
+    }
+
+    // At step n, section k processes sample n - k: pipe[k] is its input (section k - 1's output
+    // from step n - 1), and pipe[k + 1] receives its output. Sections after the nth are idle
+    // while the pipeline fills, and sections before the (n - numSamples + 1)th once the input
+    // runs out; those steps work backwards, so each input is used before it is overwritten.
+    float pipe[numBands + 1];
+    int n = 0;
+    for (; n < numBands - 1; ++n)
+    {
+        pipe[0] = samples[n];
+        for (int k = n; k >= 0; --k)
+            pipe[k + 1] = processSection<ramping>(k, pipe[k]);
+    }
+
+    for (; n < numSamples; ++n)
+    {
+        // Every section at once, into a separate array, so the compiler can vectorize it
+        float output[numBands];
+        pipe[0] = samples[n];
+        for (int k = 0; k < numBands; ++k)
+            output[k] = processSection<ramping>(k, pipe[k]);
+        for (int k = 0; k < numBands; ++k)
+            pipe[k + 1] = output[k];
+        samples[n - (numBands - 1)] = pipe[numBands];
+    }
+
+    for (; n < numSamples + numBands - 1; ++n)
+    {
+        for (int k = numBands - 1; k > n - numSamples; --k)
+            pipe[k + 1] = processSection<ramping>(k, pipe[k]);
+        samples[n - (numBands - 1)] = pipe[numBands];
+    }
 }
@@ -32,21 +32,105 @@
 #include "JuceHeader.h"
 
 /**
- * This class implements a biquad parametric EQ section according
- * to the equations in the Reiss and McPherson text.
+ * This class implements a cascade of numBands biquad EQ sections (the
+ * peaking section according to the equations in the Reiss and McPherson
+ * text, the shelving and high/low-pass sections according to Robert
+ * Bristow-Johnson's "Audio EQ Cookbook"), for one channel.
+ *
+ * Each section is in transposed direct form II. The sections must be
+ * applied one after another, but not to the same sample: at each step,
+ * section k processes the sample section k-1 finished on the previous
+ * step. So all numBands sections do the same arithmetic, on different
+ * data, at every step, and the coefficients and state are stored with
+ * one array element (one SIMD lane) per section, so the compiler can
+ * vectorize the step. The pipeline is filled at the start of each block
+ * and emptied at the end, so there is no added latency.
+ *
+ * New coefficients do not take effect at once, which would click: each
+ * coefficient moves to its new value in equal steps, one per sample,
+ * over the ramp length. (Any straight line between two stable sets of
+ * biquad denominator coefficients stays inside the triangle of stable
+ * ones, so the filter stays stable throughout the ramp.) setBand() and
+ * the processing functions must all be called on the same thread, e.g.
+ * the audio thread, so no locking is needed.
  */
 
-class ParametricEQFilter : public IIRFilter
+class ParametricEQFilter
 {
 public:
-    ParametricEQFilter() : IIRFilter() {}
-
-	// Makes a parametric EQ section entirely from discrete-time parameters.
-    // Frequency here is specified from 0 to M_PI.
-	void makeParametric (const double discreteFrequency,
-                         const double Q,
-                         const double gainFactor) noexcept;
-	
+    enum BandType
+    {
+        kOff = 0,
+        kPeaking,
+        kLowShelf,
+        kHighShelf,
+        kHighPass,
+        kLowPass,
+        kNumBandTypes
+    };
+    static void populateBandTypeComboBox(ComboBox& cb);
+
+    static const int numBands = 8;
+
+    // Biquad coefficients, normalised so a0 = 1
+    struct Coefficients
+    {
+        double b0, b1, b2, a1, a2;
+    };
+
+    // Makes one EQ section entirely from discrete-time parameters.
+    // Frequency here is specified from 0 to M_PI. The high- and low-pass
+    // types ignore gainFactor, and kOff makes a section which does nothing.
+    static Coefficients makeBand (BandType type,
+                                  const double discreteFrequency,
+                                  const double Q,
+                                  const double gainFactor) noexcept;
+
+    ParametricEQFilter();
+
+    // Ramp length in samples; 0 (the default) makes new coefficients take effect at once
+    void setRampLength (int numSamples) noexcept { rampLength = numSamples; }
+
+    // Sets one section's new coefficients, to ramp to from the next sample, keeping its state
+    void setBand (int band, const Coefficients& coefficients) noexcept;
+
+    // Ends any ramp, with every section's coefficients at their new values, e.g. after
+    // setting up every band in prepareToPlay()
+    void jumpToTargets() noexcept;
+
+    void reset() noexcept;
+    void processSamples (float* samples, int numSamples) noexcept;
+
 private:
+    // Element k of each array belongs to section k
+    struct SectionArrays
+    {
+        float b0[numBands], b1[numBands], b2[numBands], a1[numBands], a2[numBands];
+    };
+    SectionArrays coefficients, targets, increments;
+    float s1[numBands], s2[numBands];
+
+    int rampLength, rampSamplesRemaining;
+    bool targetsChanged;
+
+    // One sample through section k, and one step along the ramp if there is one
+    template <bool ramping>
+    float processSection (int k, float x) noexcept
+    {
+        auto& c = coefficients;
+        const float y = c.b0[k] * x + s1[k];
+        s1[k] = c.b1[k] * x - c.a1[k] * y + s2[k];
+        s2[k] = c.b2[k] * x - c.a2[k] * y;
+        if (ramping)
+        {
+            c.b0[k] += increments.b0[k]; c.b1[k] += increments.b1[k]; c.b2[k] += increments.b2[k];
+            c.a1[k] += increments.a1[k]; c.a2[k] += increments.a2[k];
+        }
+        return y;
+    }
+
+    template <bool ramping>
+    void processPipeline (float* samples, int numSamples) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParametricEQFilter);
 };
@@ -2,92 +2,204 @@
 
 // Names are symbolic names used to tag AudioParameter objects and XML attributes
 // Labels are human-friendly identifiers for use in GUIs
-const String ParametricEQParameters::centreFreqID = "centreFreq";
-const String ParametricEQParameters::centreFreqName = TRANS("Centre Freq");
+// Band 1 keeps the IDs of the original single band, so saved states and automation still apply
+const String ParametricEQParameters::bandTypeID[] = { "bandType1", "bandType2", "bandType3", "bandType4",
+                                                      "bandType5", "bandType6", "bandType7", "bandType8" };
+const String ParametricEQParameters::bandTypeName[] = { TRANS("Band 1 Type"), TRANS("Band 2 Type"),
+                                                        TRANS("Band 3 Type"), TRANS("Band 4 Type"),
+                                                        TRANS("Band 5 Type"), TRANS("Band 6 Type"),
+                                                        TRANS("Band 7 Type"), TRANS("Band 8 Type") };
+const String ParametricEQParameters::bandTypeLabel = "";
+const String ParametricEQParameters::centreFreqID[] = { "centreFreq",  "centreFreq2", "centreFreq3", "centreFreq4",
+                                                        "centreFreq5", "centreFreq6", "centreFreq7", "centreFreq8" };
+const String ParametricEQParameters::centreFreqName[] = { TRANS("Band 1 Freq"), TRANS("Band 2 Freq"),
+                                                          TRANS("Band 3 Freq"), TRANS("Band 4 Freq"),
+                                                          TRANS("Band 5 Freq"), TRANS("Band 6 Freq"),
+                                                          TRANS("Band 7 Freq"), TRANS("Band 8 Freq") };
 const String ParametricEQParameters::centreFreqLabel = "Hz";
-const String ParametricEQParameters::filterQID = "filterQ";
-const String ParametricEQParameters::filterQName = TRANS("Q");
+// Every band starts as a flat peaking section, spread across the audio range
+const float ParametricEQParameters::centreFreqDefault[] = { 60.0f, 150.0f, 400.0f, 1000.0f,
+                                                            2500.0f, 5000.0f, 10000.0f, 16000.0f };
+const String ParametricEQParameters::filterQID[] = { "filterQ",  "filterQ2", "filterQ3", "filterQ4",
+                                                     "filterQ5", "filterQ6", "filterQ7", "filterQ8" };
+const String ParametricEQParameters::filterQName[] = { TRANS("Band 1 Q"), TRANS("Band 2 Q"),
+                                                       TRANS("Band 3 Q"), TRANS("Band 4 Q"),
+                                                       TRANS("Band 5 Q"), TRANS("Band 6 Q"),
+                                                       TRANS("Band 7 Q"), TRANS("Band 8 Q") };
 const String ParametricEQParameters::filterQLabel = "";
-const String ParametricEQParameters::gainID = "gain";
-const String ParametricEQParameters::gainName = TRANS("Gain");
+const String ParametricEQParameters::gainID[] = { "gain",  "gain2", "gain3", "gain4",
+                                                  "gain5", "gain6", "gain7", "gain8" };
+const String ParametricEQParameters::gainName[] = { TRANS("Band 1 Gain"), TRANS("Band 2 Gain"),
+                                                    TRANS("Band 3 Gain"), TRANS("Band 4 Gain"),
+                                                    TRANS("Band 5 Gain"), TRANS("Band 6 Gain"),
+                                                    TRANS("Band 7 Gain"), TRANS("Band 8 Gain") };
 const String ParametricEQParameters::gainLabel = "dB";
+const String ParametricEQParameters::phaseModeID = "phaseMode";
+const String ParametricEQParameters::phaseModeName = TRANS("Phase Mode");
+const String ParametricEQParameters::phaseModeLabel = "";
+const String ParametricEQParameters::firBlockSizeID = "firBlockSize";
+const String ParametricEQParameters::firBlockSizeName = TRANS("FIR Block Size");
+const String ParametricEQParameters::firBlockSizeLabel = "";
+
+namespace
+{
+    // Every band starts as a flat peaking section (see centreFreqDefault)
+    const ParametricEQFilter::BandType defaultBandType = ParametricEQFilter::kPeaking;
+    const float defaultFilterQ = 2.0f;
+
+    // The original IIR filters, with no latency
+    const LinearPhaseEQ::Mode defaultPhaseMode = LinearPhaseEQ::kModeIIR;
+    const LinearPhaseEQ::BlockSize defaultFirBlockSize = LinearPhaseEQ::kBlock512;
+}
 
 AudioProcessorValueTreeState::ParameterLayout ParametricEQParameters::createParameterLayout()
 {
     std::vector<std::unique_ptr<RangedAudioParameter>> params;
 
-    params.push_back(std::make_unique<AudioParameterFloat>(
-        centreFreqID, centreFreqName,
-        NormalisableRange<float>(10.0f, 20000.0f, 0.0f), 1000.0f,
-        centreFreqLabel,
-        AudioProcessorParameter::genericParameter,
-        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
-        [](const String& text) { return text.getFloatValue(); }));
-    params.push_back(std::make_unique<AudioParameterFloat>(
-        filterQID, filterQName,
-        NormalisableRange<float>(0.1f, 20.0f, 0.1f), 2.0f,
-        filterQLabel,
-        AudioProcessorParameter::genericParameter,
-        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
-        [](const String& text) { return text.getFloatValue(); }));
-    params.push_back(std::make_unique<AudioParameterFloat>(
-        gainID, gainName,
-        NormalisableRange<float>(-12.0f, 12.0f, 0.1f), 0.0f,
-        gainLabel,
-        AudioProcessorParameter::genericParameter,
-        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
-        [](const String& text) { return text.getFloatValue(); }));
+    auto addFreqQAndGain = [&params](int band)
+    {
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            centreFreqID[band], centreFreqName[band],
+            NormalisableRange<float>(10.0f, 20000.0f, 0.0f), centreFreqDefault[band],
+            centreFreqLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            filterQID[band], filterQName[band],
+            NormalisableRange<float>(0.1f, 20.0f, 0.1f), defaultFilterQ,
+            filterQLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            gainID[band], gainName[band],
+            NormalisableRange<float>(-12.0f, 12.0f, 0.1f), 0.0f,
+            gainLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+    };
+
+    // Band 1's frequency, Q and gain come first, where the original's three parameters were,
+    // so hosts which identify parameters by index find the same ones there
+    addFreqQAndGain(0);
+    for (int band = 0; band < numBands; ++band)
+    {
+        params.push_back(std::make_unique<AudioParameterInt>(
+            bandTypeID[band], bandTypeName[band],
+            0, int(ParametricEQFilter::kNumBandTypes) - 1, int(defaultBandType),
+            bandTypeLabel,
+            [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getIntValue(); }));
+        if (band > 0) addFreqQAndGain(band);
+    }
+
+    params.push_back(std::make_unique<AudioParameterInt>(
+        phaseModeID, phaseModeName,
+        0, int(LinearPhaseEQ::kNumModes) - 1, int(defaultPhaseMode),
+        phaseModeLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        firBlockSizeID, firBlockSizeName,
+        0, int(LinearPhaseEQ::kNumBlockSizes) - 1, int(defaultFirBlockSize),
+        firBlockSizeLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
 
     return { params.begin(), params.end() };
 }
 
 ParametricEQParameters::ParametricEQParameters(AudioProcessorValueTreeState& vts,
                                                AudioProcessorValueTreeState::Listener* processor)
-    : centreFreqHz(1000.0f)
-    , filterQ(2.0f)
-    , linearGain(1.0f)
+    : phaseMode(defaultPhaseMode)
+    , firBlockSize(defaultFirBlockSize)
     , valueTreeState(vts)
     , processorAsListener(processor)
-    , centreFreqListener(centreFreqHz)
-    , filterQListener(filterQ)
-    , gainListener(linearGain)
+    , phaseModeListener(phaseMode)
+    , firBlockSizeListener(firBlockSize)
 {
-    valueTreeState.addParameterListener(centreFreqID, &centreFreqListener);
-    valueTreeState.addParameterListener(filterQID, &filterQListener);
-    valueTreeState.addParameterListener(gainID, &gainListener);
-
-    // processor also needs to listen for parameter changes, in order to update filters
-    valueTreeState.addParameterListener(centreFreqID, processorAsListener);
-    valueTreeState.addParameterListener(filterQID, processorAsListener);
-    valueTreeState.addParameterListener(gainID, processorAsListener);
+    for (int band = 0; band < numBands; ++band)
+    {
+        bandType[band] = defaultBandType;
+        centreFreqHz[band] = centreFreqDefault[band];
+        filterQ[band] = defaultFilterQ;
+        linearGain[band] = 1.0f;
+
+        bandTypeListeners.add(new EnumListener<ParametricEQFilter::BandType>(bandType[band]));
+        centreFreqListeners.add(new FloatListener(centreFreqHz[band]));
+        filterQListeners.add(new FloatListener(filterQ[band]));
+        gainListeners.add(new FloatDecibelListener(linearGain[band]));
+
+        // processor also needs to listen for parameter changes, in order to update filters,
+        // and listeners are called in reverse order of adding, so it must be added first
+        valueTreeState.addParameterListener(bandTypeID[band], processorAsListener);
+        valueTreeState.addParameterListener(centreFreqID[band], processorAsListener);
+        valueTreeState.addParameterListener(filterQID[band], processorAsListener);
+        valueTreeState.addParameterListener(gainID[band], processorAsListener);
+
+        valueTreeState.addParameterListener(bandTypeID[band], bandTypeListeners[band]);
+        valueTreeState.addParameterListener(centreFreqID[band], centreFreqListeners[band]);
+        valueTreeState.addParameterListener(filterQID[band], filterQListeners[band]);
+        valueTreeState.addParameterListener(gainID[band], gainListeners[band]);
+    }
+
+    // these two change which filters the processor runs, and with what latency
+    valueTreeState.addParameterListener(phaseModeID, processorAsListener);
+    valueTreeState.addParameterListener(firBlockSizeID, processorAsListener);
+    valueTreeState.addParameterListener(phaseModeID, &phaseModeListener);
+    valueTreeState.addParameterListener(firBlockSizeID, &firBlockSizeListener);
 }
 
 ParametricEQParameters::~ParametricEQParameters()
 {
     detachControls();
-    valueTreeState.removeParameterListener(centreFreqID, &centreFreqListener);
-    valueTreeState.removeParameterListener(filterQID, &filterQListener);
-    valueTreeState.removeParameterListener(gainID, &gainListener);
-    valueTreeState.removeParameterListener(centreFreqID, processorAsListener);
-    valueTreeState.removeParameterListener(filterQID, processorAsListener);
-    valueTreeState.removeParameterListener(gainID, processorAsListener);
+    for (int band = 0; band < numBands; ++band)
+    {
+        valueTreeState.removeParameterListener(bandTypeID[band], bandTypeListeners[band]);
+        valueTreeState.removeParameterListener(centreFreqID[band], centreFreqListeners[band]);
+        valueTreeState.removeParameterListener(filterQID[band], filterQListeners[band]);
+        valueTreeState.removeParameterListener(gainID[band], gainListeners[band]);
+        valueTreeState.removeParameterListener(bandTypeID[band], processorAsListener);
+        valueTreeState.removeParameterListener(centreFreqID[band], processorAsListener);
+        valueTreeState.removeParameterListener(filterQID[band], processorAsListener);
+        valueTreeState.removeParameterListener(gainID[band], processorAsListener);
+    }
+    valueTreeState.removeParameterListener(phaseModeID, &phaseModeListener);
+    valueTreeState.removeParameterListener(firBlockSizeID, &firBlockSizeListener);
+    valueTreeState.removeParameterListener(phaseModeID, processorAsListener);
+    valueTreeState.removeParameterListener(firBlockSizeID, processorAsListener);
 }
 
 void ParametricEQParameters::detachControls()
 {
-    centreFreqAttachment.reset(nullptr);
-    filterQAttachment.reset(nullptr);
-    gainAttachment.reset(nullptr);
+    bandTypeAttachments.clear();
+    centreFreqAttachments.clear();
+    filterQAttachments.clear();
+    gainAttachments.clear();
+    phaseModeAttachment.reset(nullptr);
+    firBlockSizeAttachment.reset(nullptr);
 }
 
 void ParametricEQParameters::attachControls(
-    Slider& centreFreqKnob,
-    Slider& filterQKnob,
-    Slider& gainKnob )
+    const Array<ComboBox*>& bandTypeCombos,
+    const Array<Slider*>& centreFreqKnobs,
+    const Array<Slider*>& filterQKnobs,
+    const Array<Slider*>& gainKnobs,
+    ComboBox& phaseModeCombo,
+    ComboBox& firBlockSizeCombo )
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
-    centreFreqAttachment.reset(new SlAt(valueTreeState, centreFreqID, centreFreqKnob));
-    filterQAttachment.reset(new SlAt(valueTreeState, filterQID, filterQKnob));
-    gainAttachment.reset(new SlAt(valueTreeState, gainID, gainKnob));
-}
\ No newline at end of file
+    detachControls();
+    for (int band = 0; band < numBands; ++band)
+    {
+        bandTypeAttachments.add(new CbAt(valueTreeState, bandTypeID[band], *bandTypeCombos[band]));
+        centreFreqAttachments.add(new SlAt(valueTreeState, centreFreqID[band], *centreFreqKnobs[band]));
+        filterQAttachments.add(new SlAt(valueTreeState, filterQID[band], *filterQKnobs[band]));
+        gainAttachments.add(new SlAt(valueTreeState, gainID[band], *gainKnobs[band]));
+    }
+    phaseModeAttachment.reset(new CbAt(valueTreeState, phaseModeID, phaseModeCombo));
+    firBlockSizeAttachment.reset(new CbAt(valueTreeState, firBlockSizeID, firBlockSizeCombo));
+}
@@ -1,15 +1,23 @@
 #pragma once
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
+#include "ParametricEQFilter.h"
+#include "LinearPhaseEQ.h"
 
 class ParametricEQParameters
 {
 public:
     // Id's are symbolic names, Names are human-friendly names for GUI
     // Labels are supplementary, typically used for units of measure
-    static const String centreFreqID, centreFreqName, centreFreqLabel;
-    static const String filterQID, filterQName, filterQLabel;
-    static const String gainID, gainName, gainLabel;
+    // One of each per band
+    static const int numBands = ParametricEQFilter::numBands;
+    static const String bandTypeID[numBands], bandTypeName[numBands], bandTypeLabel;
+    static const String centreFreqID[numBands], centreFreqName[numBands], centreFreqLabel;
+    static const float centreFreqDefault[numBands];
+    static const String filterQID[numBands], filterQName[numBands], filterQLabel;
+    static const String gainID[numBands], gainName[numBands], gainLabel;
+    static const String phaseModeID, phaseModeName, phaseModeLabel;
+    static const String firBlockSizeID, firBlockSizeName, firBlockSizeLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
@@ -19,17 +27,25 @@ public:
 
     void detachControls();
     void attachControls(
-        Slider& centreFreqKnob,
-        Slider& filterQKnob,
-        Slider& gainKnob );
+        const Array<ComboBox*>& bandTypeCombos,
+        const Array<Slider*>& centreFreqKnobs,
+        const Array<Slider*>& filterQKnobs,
+        const Array<Slider*>& gainKnobs,
+        ComboBox& phaseModeCombo,
+        ComboBox& firBlockSizeCombo );
 
-    // working parameter values
-    float centreFreqHz;
-    float filterQ;
-    float linearGain;
+    // working parameter values, one per band
+    ParametricEQFilter::BandType bandType[numBands];
+    float centreFreqHz[numBands];
+    float filterQ[numBands];
+    float linearGain[numBands];
+
+    // working parameter values, for all bands
+    LinearPhaseEQ::Mode phaseMode;
+    LinearPhaseEQ::BlockSize firBlockSize;
 
     // derived value
-    float getBandwidthHz() { return centreFreqHz / filterQ; }
+    float getBandwidthHz(int band) { return centreFreqHz[band] / filterQ[band]; }
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -39,12 +55,18 @@ private:
     AudioProcessorValueTreeState::Listener* processorAsListener;
 
     // Attachment objects link GUI controls to parameters
-    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> centreFreqAttachment;
-    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> filterQAttachment;
-    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> gainAttachment;
+    OwnedArray<AudioProcessorValueTreeState::ComboBoxAttachment> bandTypeAttachments;
+    OwnedArray<AudioProcessorValueTreeState::SliderAttachment> centreFreqAttachments;
+    OwnedArray<AudioProcessorValueTreeState::SliderAttachment> filterQAttachments;
+    OwnedArray<AudioProcessorValueTreeState::SliderAttachment> gainAttachments;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> phaseModeAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> firBlockSizeAttachment;
 
     // Listener objects link parameters to working variables
-    FloatListener centreFreqListener;
-    FloatListener filterQListener;
-    FloatDecibelListener gainListener;
+    OwnedArray<EnumListener<ParametricEQFilter::BandType>> bandTypeListeners;
+    OwnedArray<FloatListener> centreFreqListeners;
+    OwnedArray<FloatListener> filterQListeners;
+    OwnedArray<FloatDecibelListener> gainListeners;
+    EnumListener<LinearPhaseEQ::Mode> phaseModeListener;
+    EnumListener<LinearPhaseEQ::BlockSize> firBlockSizeListener;
 };
\ No newline at end of file
@@ -21,7 +21,12 @@ ParametricEQProcessor::ParametricEQProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("ParametricEQ"), ParametricEQParameters::createParameterLayout())
     , parameters(valueTreeState, this)
+    , filtersNeedUpdate(false)
+    , currentPhaseMode(LinearPhaseEQ::kModeIIR)
+    , latencyReporter(*this)
 {
+    // Enough filters for the default layout, so prepareToPlay() need not allocate
+    filters.preallocate(getTotalNumInputChannels());
 }
 
 // Destructor
@@ -31,45 +36,92 @@ ParametricEQProcessor::~ParametricEQProcessor()
 
 void ParametricEQProcessor::parameterChanged(const String&, float)
 {
-    // all parameters affect the filters
-    updateFilters();
-
-    // inform our GUI that the filter bandwidth may have changed
-    sendChangeMessage();
+    // all parameters affect the filters, which only the audio thread touches
+    filtersNeedUpdate = true;
 }
 
 void ParametricEQProcessor::updateFilters()
 {
 #define TWOPI_D 6.283185307
 
-    for (auto& filter : filters)
+    // (no filters, and no sample rate, before prepareToPlay())
+    if (filters.size() == 0) return;
+
+    for (int band = 0; band < ParametricEQFilter::numBands; ++band)
     {
-        filter->makeParametric(TWOPI_D * parameters.centreFreqHz / sampleRateHz,
-                               parameters.filterQ, parameters.linearGain);
+        bandCoefficients[band] = ParametricEQFilter::makeBand(parameters.bandType[band],
+                                                              TWOPI_D * parameters.centreFreqHz[band] / sampleRateHz,
+                                                              parameters.filterQ[band], parameters.linearGain[band]);
+        for (auto& filter : filters)
+            filter->setBand(band, bandCoefficients[band]);
     }
+
+    // the linear-phase version is only designed while it is in use; switching to it asks for
+    // a design of the latest bands
+    if (parameters.phaseMode == LinearPhaseEQ::kModeLinearPhase)
+        requestLinearPhaseDesign();
+}
+
+void ParametricEQProcessor::requestLinearPhaseDesign()
+{
+    // designed on a background thread (see LinearPhaseEQ.h)
+    linearPhaseEQ.setBands(bandCoefficients, parameters.firBlockSize);
+}
+
+// The linear-phase filter delays the signal, by an amount which depends on the block size it
+// is actually running with, which may not be the one just asked for yet
+int ParametricEQProcessor::getCurrentLatencySamples() const
+{
+    if (currentPhaseMode == LinearPhaseEQ::kModeLinearPhase)
+        return linearPhaseEQ.getCurrentLatencySamples();
+    return 0;
 }
 
 // Prepare to process audio (always called at least once before processBlock)
 void ParametricEQProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     sampleRateHz = sampleRate;
 
-    // create as many identical filters as there are input channels
-    for (int i = 0; i < getTotalNumInputChannels(); i++)
-        filters.add(new ParametricEQFilter);
+    // use as many identical filters as there are input channels, whose coefficients
+    // ramp smoothly to new values when the parameters change, rather than jumping
+    const double kCoefficientRampSec = 0.02;
+    filters.prepare(getTotalNumInputChannels());
+    for (auto& filter : filters)
+        filter->setRampLength(roundToInt(kCoefficientRampSec * sampleRate));
+
+    // The linear-phase filter is as long as it needs to be for the sample rate
+    linearPhaseEQ.prepare(sampleRate, getTotalNumInputChannels());
 
-    // Update the filter settings to work with the current parameters and sample rate
+    // Update the filter settings to work with the current parameters and sample rate,
+    // starting with no ramp (or crossfade). The linear-phase filter is designed here even in
+    // IIR mode, so it has something to play if the mode changes before the next design is done.
+    filtersNeedUpdate = false;
     updateFilters();
+    for (auto& filter : filters)
+        filter->jumpToTargets();
+    requestLinearPhaseDesign();
+    linearPhaseEQ.designNow();
+
+    currentPhaseMode = parameters.phaseMode;
+    latencyReporter.setLatencySamplesNow(getCurrentLatencySamples());
 }
 
-// Audio processing finished; release any allocated memory
+// Audio processing finished; the filters are kept, for the next prepareToPlay()
 void ParametricEQProcessor::releaseResources()
 {
-    filters.clear();
 }
 
 // Process one buffer ("block") of data
 void ParametricEQProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void ParametricEQProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -78,12 +130,44 @@ void ParametricEQProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer
     int numOutputChannels = getTotalNumOutputChannels();
     int numSamples = buffer.getNumSamples();
 
+    if (filtersNeedUpdate.exchange(false))
+        updateFilters();
+
+    // A change of mode starts the newly-used filters from silence, and with their latest
+    // coefficients; the linear-phase filter needs designing for them
+    if (parameters.phaseMode != currentPhaseMode)
+    {
+        currentPhaseMode = parameters.phaseMode;
+        if (currentPhaseMode == LinearPhaseEQ::kModeLinearPhase)
+        {
+            requestLinearPhaseDesign();
+            linearPhaseEQ.reset();
+        }
+        else
+        {
+            for (auto& filter : filters)
+            {
+                filter->jumpToTargets();
+                filter->reset();
+            }
+        }
+    }
+
     int ch = 0;
-    for (; ch < jmin(numInputChannels, numFilters); ch++)
+    if (currentPhaseMode == LinearPhaseEQ::kModeLinearPhase)
     {
-        // Run the samples through the IIR filter whose coefficients define the parametric
-        // equaliser. See juce_IIRFilter.cpp for the implementation.
-        filters[ch]->processSamples(buffer.getWritePointer(ch), numSamples);
+        // All channels at once, in FFT-sized blocks. See LinearPhaseEQ.cpp.
+        ch = jmin(numInputChannels, numFilters);
+        linearPhaseEQ.processBlock(buffer, ch);
+    }
+    else
+    {
+        for (; ch < jmin(numInputChannels, numFilters); ch++)
+        {
+            // Run the samples through the cascade of IIR filters which make up the parametric
+            // equaliser. See ParametricEQFilter.cpp for the implementation.
+            filters[ch]->processSamples(buffer.getWritePointer(ch), numSamples);
+        }
     }
 
     // Go through the remaining channels. In case we have more outputs
@@ -93,6 +177,10 @@ void ParametricEQProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer
     {
         buffer.clear(ch++, 0, numSamples);
     }
+
+    // A new mode, or a new block size picked up by the linear-phase filter, changes the latency;
+    // the host hears about it (only if it has changed) from the message thread
+    latencyReporter.setLatencySamples(getCurrentLatencySamples());
 }
 
 // Called by the host when it needs to persist the current plugin state
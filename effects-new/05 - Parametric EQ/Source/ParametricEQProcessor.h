@@ -2,10 +2,14 @@
 #include "JuceHeader.h"
 #include "ParametricEQParameters.h"
 #include "ParametricEQFilter.h"
+#include "LinearPhaseEQ.h"
+#include "FilterBank.h"
+#include "AutomationScheduler.h"
+#include "LatencyReporter.h"
 
 class ParametricEQProcessor : public AudioProcessor
                             , public AudioProcessorValueTreeState::Listener
-                            , public ChangeBroadcaster
+                            , public AutomationScheduler::Owner
 {
 public:
     ParametricEQProcessor();
@@ -32,6 +36,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -52,10 +59,28 @@ public:
 
 protected:
 
+    // Called on the audio thread, at the next block after any parameter change
     void updateFilters();
+    std::atomic<bool> filtersNeedUpdate;
+
+    // Ask for a linear-phase filter with the latest bands, to be designed in the background
+    void requestLinearPhaseDesign();
 
 private:
-    OwnedArray<ParametricEQFilter> filters;
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    FilterBank<ParametricEQFilter> filters;
+
+    // The same bands as a linear-phase FIR filter, and which of the two is running
+    LinearPhaseEQ linearPhaseEQ;
+    LinearPhaseEQ::Mode currentPhaseMode;
+    ParametricEQFilter::Coefficients bandCoefficients[ParametricEQFilter::numBands];  // latest
+
+    // The latency of whichever is running, told to the host from the message thread
+    int getCurrentLatencySamples() const;
+    LatencyReporter latencyReporter;
 
     double sampleRateHz;
 
@@ -0,0 +1,139 @@
+#include "RealFFT.h"
+
+namespace
+{
+    // n butterflies, each making a + w b and a - w b of points a and b. The a points are
+    // followed by the b points, so none of the runs overlap, and saying so lets the compiler
+    // vectorize the loop.
+    void butterflies(float* __restrict ar, float* __restrict ai, float* __restrict br, float* __restrict bi,
+                     const float* __restrict wr, const float* __restrict wi, int n)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            const float tr = wr[j] * br[j] - wi[j] * bi[j];
+            const float ti = wr[j] * bi[j] + wi[j] * br[j];
+            br[j] = ar[j] - tr;     bi[j] = ai[j] - ti;
+            ar[j] += tr;            ai[j] += ti;
+        }
+    }
+}
+
+RealFFT::RealFFT(int order)
+    : size(1 << order)
+    , half(size / 2)
+    , bitReversed(half)
+    , twiddleRe(half)
+    , twiddleIm(half)
+    , unpackRe(half)
+    , unpackIm(half)
+    , workRe(half)
+    , workIm(half)
+{
+    jassert(order >= 2);
+
+    const int halfOrder = order - 1;
+    for (int k = 0; k < half; ++k)
+    {
+        int reversed = 0;
+        for (int bit = 0; bit < halfOrder; ++bit)
+            if (k & (1 << bit)) reversed |= 1 << (halfOrder - 1 - bit);
+        bitReversed[k] = reversed;
+    }
+
+    // Stage h's butterflies j (from 0 to h - 1) use exp(-pi i j / h)
+    for (int h = 1; h < half; h *= 2)
+        for (int j = 0; j < h; ++j)
+        {
+            const double w = MathConstants<double>::pi * j / h;
+            twiddleRe[h + j] = float(std::cos(w));
+            twiddleIm[h + j] = float(-std::sin(w));
+        }
+
+    for (int k = 0; k < half; ++k)
+    {
+        const double w = MathConstants<double>::twoPi * k / size;
+        unpackRe[k] = float(std::cos(w));
+        unpackIm[k] = float(-std::sin(w));
+    }
+}
+
+void RealFFT::performComplex(float* re, float* im) const noexcept
+{
+    // The first two stages' butterflies are too few per group to vectorize, but their twiddles
+    // are only 1 and -i, so they are done together, four points at a time, with no multiplies
+    int h = 1;
+    if (half >= 4)
+    {
+        for (int start = 0; start < half; start += 4)
+        {
+            float* r = re + start;
+            float* i = im + start;
+            const float r0 = r[0] + r[1], i0 = i[0] + i[1];
+            const float r1 = r[0] - r[1], i1 = i[0] - i[1];
+            const float r2 = r[2] + r[3], i2 = i[2] + i[3];
+            const float r3 = r[2] - r[3], i3 = i[2] - i[3];
+            r[0] = r0 + r2;     i[0] = i0 + i2;
+            r[2] = r0 - r2;     i[2] = i0 - i2;
+            r[1] = r1 + i3;     i[1] = i1 - r3;
+            r[3] = r1 - i3;     i[3] = i1 + r3;
+        }
+        h = 4;
+    }
+
+    for (; h < half; h *= 2)
+        for (int start = 0; start < half; start += 2 * h)
+            butterflies(re + start, im + start, re + start + h, im + start + h,
+                        twiddleRe + h, twiddleIm + h, h);
+}
+
+void RealFFT::performForward(const float* input, float* re, float* im) noexcept
+{
+    // z[k] = x[2k] + i x[2k + 1]
+    for (int k = 0; k < half; ++k)
+    {
+        workRe[bitReversed[k]] = input[2 * k];
+        workIm[bitReversed[k]] = input[2 * k + 1];
+    }
+    performComplex(workRe, workIm);
+
+    // Z[k] is E[k] + i O[k], E and O being the spectra of the even and odd samples, each
+    // with conjugate symmetry, so E[k] = (Z[k] + conj(Z[half - k])) / 2 and
+    // O[k] = (Z[k] - conj(Z[half - k])) / 2i, and X[k] = E[k] + exp(-2 pi i k / size) O[k]
+    re[0] = workRe[0] + workIm[0];      im[0] = 0.0f;
+    re[half] = workRe[0] - workIm[0];   im[half] = 0.0f;
+    for (int k = 1; k < half; ++k)
+    {
+        const float zr = workRe[k], zi = workIm[k];
+        const float cr = workRe[half - k], ci = -workIm[half - k];
+        const float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        const float or_ = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+        re[k] = er + unpackRe[k] * or_ - unpackIm[k] * oi;
+        im[k] = ei + unpackRe[k] * oi + unpackIm[k] * or_;
+    }
+}
+
+void RealFFT::performInverse(const float* re, const float* im, float* output) noexcept
+{
+    // The same relationships backwards: E[k] = X[k] + conj(X[half - k]) and
+    // O[k] = (X[k] - conj(X[half - k])) exp(2 pi i k / size), each twice its true value
+    for (int k = 0; k < half; ++k)
+    {
+        const float xr = re[k], xi = im[k];
+        const float cr = re[half - k], ci = -im[half - k];
+        const float er = xr + cr, ei = xi + ci;
+        const float dr = xr - cr, di = xi - ci;
+        const float or_ = dr * unpackRe[k] + di * unpackIm[k];
+        const float oi = di * unpackRe[k] - dr * unpackIm[k];
+        workRe[bitReversed[k]] = er - oi;
+        workIm[bitReversed[k]] = ei + or_;
+    }
+
+    // Swapping real and imaginary parts on the way in and out makes the FFT an inverse FFT
+    performComplex(workIm, workRe);
+
+    for (int k = 0; k < half; ++k)
+    {
+        output[2 * k] = workRe[k];
+        output[2 * k + 1] = workIm[k];
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  RealFFT: a fast Fourier transform of real signals, for the Parametric EQ's linear-phase mode.
+    (JUCE's own FFT lives in the juce_dsp module, which these projects do not use.)
+
+    A real signal of size samples is packed into a complex signal of half that size (even
+    samples as the real parts, odd ones as the imaginary parts), which is transformed by an
+    ordinary radix-2 FFT, and the result is then untangled into the size / 2 + 1 bins of the
+    real signal's spectrum; the inverse does the same steps backwards. Spectra are held as
+    separate arrays of real and imaginary parts, so code which multiplies them can be
+    vectorized. The Nyquist bin is held like any other (its imaginary part is always 0), so
+    such code needs no special cases.
+
+    All tables and working space are allocated in the constructor. The transforms use the
+    working space, so each thread needs its own RealFFT.
+*/
+
+class RealFFT
+{
+public:
+    // size = 2 to the power order
+    explicit RealFFT(int order);
+
+    int getSize() const { return size; }
+    int getNumBins() const { return size / 2 + 1; }
+
+    // size samples in, getNumBins() bins out
+    void performForward(const float* input, float* re, float* im) noexcept;
+
+    // getNumBins() bins in, size samples out. Not normalised: forward then inverse multiplies
+    // the signal by size.
+    void performInverse(const float* re, const float* im, float* output) noexcept;
+
+private:
+    // The half-size complex FFT, in place, on input already in bit-reversed order; called with
+    // re and im swapped, it is the inverse FFT
+    void performComplex(float* re, float* im) const noexcept;
+
+    int size, half;
+    HeapBlock<int> bitReversed;             // half entries
+    HeapBlock<float> twiddleRe, twiddleIm;  // for each stage of h butterflies, entries h to 2h - 1
+    HeapBlock<float> unpackRe, unpackIm;    // exp(-2 pi i k / size), k from 0 to half - 1
+    HeapBlock<float> workRe, workIm;        // half entries
+
+    JUCE_DECLARE_NON_COPYABLE(RealFFT)
+};
@@ -21,8 +21,11 @@ WahWahProcessor::WahWahProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("WahWah"), WahWahParameters::createParameterLayout())
     , parameters(valueTreeState, this)
+    , filtersNeedUpdate(false)
     , inverseSampleRate(1.0 / 44100.0)  // sensible default
 {
+    // Enough filters for the default layout, so prepareToPlay() need not allocate
+    filters.preallocate(getTotalNumInputChannels());
 }
 
 // Destructor
@@ -47,24 +50,39 @@ void WahWahProcessor::updateFilters()
 // Prepare to process audio (always called at least once before processBlock)
 void WahWahProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     inverseSampleRate = 1.0 / sampleRate;
 
-    // create as many identical filters as there are input channels
-    for (int i = 0; i < getTotalNumInputChannels(); i++)
-        filters.add(new ResonantLowpassFilter);
+    // use as many identical filters as there are input channels, whose coefficients
+    // ramp smoothly to new values when the parameters change, rather than jumping
+    const double kCoefficientRampSec = 0.02;
+    filters.prepare(getTotalNumInputChannels());
+    for (auto& filter : filters)
+        filter->setRampLength(roundToInt(kCoefficientRampSec * sampleRate));
 
-    // Update the filter settings to work with the current parameters and sample rate
+    // Update the filter settings to work with the current parameters and sample rate,
+    // starting with no ramp
+    filtersNeedUpdate = false;
     updateFilters();
+    for (auto& filter : filters)
+        filter->jumpToTarget();
 }
 
-// Audio processing finished; release any allocated memory
+// Audio processing finished; the filters are kept, for the next prepareToPlay()
 void WahWahProcessor::releaseResources()
 {
-    filters.clear();
 }
 
 // Process one buffer ("block") of data
 void WahWahProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void WahWahProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -73,11 +91,15 @@ void WahWahProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     int numOutputChannels = getTotalNumOutputChannels();
     int numSamples = buffer.getNumSamples();
 
+    // Parameters may have changed on another thread; only this one touches the filters
+    if (filtersNeedUpdate.exchange(false))
+        updateFilters();
+
     int ch = 0;
     for (; ch < jmin(numInputChannels, numFilters); ch++)
     {
-        // Run the samples through the IIR filter whose coefficients define the parametric
-        // equaliser. See juce_IIRFilter.cpp for the implementation.
+        // Run the samples through the IIR filter whose coefficients define the resonant
+        // lowpass. See ResonantLowpassFilter.cpp for the implementation.
         filters[ch]->processSamples(buffer.getWritePointer(ch), numSamples);
     }
 
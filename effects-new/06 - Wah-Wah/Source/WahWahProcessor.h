@@ -2,9 +2,12 @@
 #include "JuceHeader.h"
 #include "WahWahParameters.h"
 #include "ResonantLowpassFilter.h"
+#include "FilterBank.h"
+#include "AutomationScheduler.h"
 
 class WahWahProcessor   : public AudioProcessor
                         , public AudioProcessorValueTreeState::Listener
+                        , public AutomationScheduler::Owner
 {
 public:
     WahWahProcessor();
@@ -31,6 +34,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -43,13 +49,18 @@ public:
     WahWahParameters parameters;
 
 protected:
-    // Responding to parameter changes
-    void parameterChanged(const String&, float) override { updateFilters(); }
+    // Responding to parameter changes: the audio thread updates the filters at its next block
+    void parameterChanged(const String&, float) override { filtersNeedUpdate = true; }
 
     void updateFilters();
+    std::atomic<bool> filtersNeedUpdate;
 
 private:
-    OwnedArray<ResonantLowpassFilter> filters;
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    FilterBank<ResonantLowpassFilter> filters;
 
     double inverseSampleRate; // Save the inverse of the sample rate for faster calculation
 
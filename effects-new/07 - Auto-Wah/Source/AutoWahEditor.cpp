@@ -36,6 +36,27 @@ AutoWahEditor::AutoWahEditor (AutoWahProcessor& p)
     envWidthKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
     addAndMakeVisible(labeledEnvWidthKnob);
 
+    controlRateLabel.setText("Control Rate", dontSendNotification);
+    controlRateLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&controlRateLabel);
+
+    controlRateCombo.setEditableText(false);
+    controlRateCombo.setJustificationType(Justification::centredLeft);
+    AutoWahFilter::populateControlRateComboBox(controlRateCombo);
+    addAndMakeVisible(controlRateCombo);
+
+    detectorLabel.setText("Detector", dontSendNotification);
+    detectorLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&detectorLabel);
+
+    detectorCombo.setEditableText(false);
+    detectorCombo.setJustificationType(Justification::centredLeft);
+    AutoWahFilter::populateDetectorComboBox(detectorCombo);
+    addAndMakeVisible(detectorCombo);
+
+    linkToggle.setButtonText("Link Channels");
+    addAndMakeVisible(&linkToggle);
+
     processor.parameters.attachControls(
         centreFreqKnob,
         filterQKnob,
@@ -43,9 +64,12 @@ AutoWahEditor::AutoWahEditor (AutoWahProcessor& p)
         lfoWidthKnob,
         attackKnob,
         decayKnob,
-        envWidthKnob );
+        envWidthKnob,
+        controlRateCombo,
+        detectorCombo,
+        linkToggle );
 
-    setSize (860, 180);
+    setSize (860, 214);
 }
 
 AutoWahEditor::~AutoWahEditor()
@@ -58,6 +82,16 @@ void AutoWahEditor::resized()
 {
     auto bounds = getLocalBounds().reduced(20);
 
+    auto optionsArea = bounds.removeFromBottom(24);
+    controlRateLabel.setBounds(optionsArea.removeFromLeft(100));
+    controlRateCombo.setBounds(optionsArea.removeFromLeft(130));
+    optionsArea.removeFromLeft(20);
+    detectorLabel.setBounds(optionsArea.removeFromLeft(80));
+    detectorCombo.setBounds(optionsArea.removeFromLeft(80));
+    optionsArea.removeFromLeft(20);
+    linkToggle.setBounds(optionsArea.removeFromLeft(140));
+    bounds.removeFromBottom(10);
+
     filterGroup.setBounds(bounds.removeFromLeft(2 * 100 + 3 * 10));
     auto widgetsArea = filterGroup.getBounds().reduced(10);
     widgetsArea.removeFromTop(20);
@@ -26,6 +26,9 @@ private:
     BasicKnob attackKnob; LabeledKnob labeledAttackKnob;
     BasicKnob decayKnob; LabeledKnob labeledReleaseKnob;
     BasicKnob envWidthKnob; LabeledKnob labeledEnvWidthKnob;
+    ComboBox controlRateCombo; Label controlRateLabel;
+    ComboBox detectorCombo; Label detectorLabel;
+    ToggleButton linkToggle;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoWahEditor)
 };
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "AutoWahFilter.h"
+
+void AutoWahFilter::populateControlRateComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Every Sample", ++itemNumber);
+    for (int r = kEvery16Samples; r < kNumControlRates; ++r)
+        cb.addItem(String(getIntervalSamples(ControlRate(r))) + " Samples", ++itemNumber);
+}
+
+void AutoWahFilter::populateDetectorComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Peak", ++itemNumber);
+    cb.addItem("RMS", ++itemNumber);
+}
+
+AutoWahFilter::AutoWahFilter()
+    : numChannels(0), numGroups(0), numAllocatedGroups(0)
+    , interleaved(chunkSamples * numLanes)
+    , linkedEnvelope(0.0f)
+    , linkedEnvelopes(chunkSamples)
+{
+}
+
+void AutoWahFilter::prepare(int numChannelsToUse)
+{
+    numChannels = numChannelsToUse;
+    numGroups = (numChannels + numLanes - 1) / numLanes;
+    if (numGroups > numAllocatedGroups)
+    {
+        groups.allocate(numGroups, true);
+        numAllocatedGroups = numGroups;
+    }
+    reset();
+}
+
+void AutoWahFilter::reset()
+{
+    for (int i = 0; i < numGroups; ++i)
+    {
+        LaneGroup& group = groups[i];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            group.envelope[lane] = 0.0f;
+            group.ic1eq[lane] = group.ic2eq[lane] = 0.0f;
+            group.g[lane] = group.gIncrement[lane] = 0.0f;
+        }
+        group.samplesToControlPoint = 0;
+        group.gIsSet = false;
+    }
+    linkedEnvelope = 0.0f;
+}
+
+float AutoWahFilter::getLfoFrequency(const Sweep& sweep, float phase) noexcept
+{
+    const float TWOPI_F = 6.283185f;
+
+    // The centre frequency of the filter based on the LFO; each channel's envelope adds to it
+    float centreFrequency = sweep.centreFreqHz;
+    if (sweep.lfoWidthHz > 0.0f)
+        centreFrequency += sweep.lfoWidthHz * (0.5f + 0.5f * sinf(TWOPI_F * phase));
+    return centreFrequency;
+}
+
+float AutoWahFilter::getCutoffGain(const Sweep& sweep, float centreFrequency) noexcept
+{
+    // tan() goes to infinity at Nyquist, so stop just short of it
+    const float w = float(MathConstants<double>::pi * sweep.inverseSampleRate) * centreFrequency;
+    return tanf(jmin(w, 0.49f * MathConstants<float>::pi));
+}
+
+float AutoWahFilter::processSamples(float* const* channelData, int numChannelsToProcess, int numSamples,
+                                    const Sweep& sweep) noexcept
+{
+    jassert(numChannelsToProcess <= numChannels);
+    const int numGroupsToProcess = (numChannelsToProcess + numLanes - 1) / numLanes;
+    float phase = sweep.lfoPhase;
+
+    for (int start = 0; start < numSamples; start += chunkSamples)
+    {
+        const int count = jmin(chunkSamples, numSamples - start);
+        if (sweep.linked)
+            followLinkedEnvelope(channelData, numChannelsToProcess, start, count, sweep);
+
+        float endPhase = phase;
+        for (int groupIndex = 0; groupIndex < numGroupsToProcess; ++groupIndex)
+        {
+            const int firstChannel = groupIndex * numLanes;
+            const int numUsedLanes = jmin(numLanes, numChannelsToProcess - firstChannel);
+
+            // Unused lanes are zero, so their filters stay silent
+            if (numUsedLanes < numLanes)
+                FloatVectorOperations::clear(interleaved, count * numLanes);
+            for (int lane = 0; lane < numUsedLanes; ++lane)
+            {
+                const float* in = channelData[firstChannel + lane] + start;
+                for (int i = 0; i < count; ++i)
+                    interleaved[i * numLanes + lane] = in[i];
+            }
+
+            endPhase = processGroup(groups[groupIndex], numUsedLanes, count, sweep, phase);
+
+            for (int lane = 0; lane < numUsedLanes; ++lane)
+            {
+                float* out = channelData[firstChannel + lane] + start;
+                for (int i = 0; i < count; ++i)
+                    out[i] = interleaved[i * numLanes + lane];
+            }
+        }
+        phase = endPhase;
+    }
+
+    return phase;
+}
+
+void AutoWahFilter::followLinkedEnvelope(float* const* channelData, int numChannelsToProcess,
+                                         int startSample, int numSamples, const Sweep& sweep) noexcept
+{
+    // The loudest channel's level, or the mean square of all of them, at each sample
+    const bool rms = sweep.detector == kDetectorRMS;
+    FloatVectorOperations::clear(linkedEnvelopes, numSamples);
+    for (int ch = 0; ch < numChannelsToProcess; ++ch)
+    {
+        const float* in = channelData[ch] + startSample;
+        if (rms)
+        {
+            const float scale = 1.0f / numChannelsToProcess;
+            for (int i = 0; i < numSamples; ++i)
+                linkedEnvelopes[i] += scale * in[i] * in[i];
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                linkedEnvelopes[i] = jmax(linkedEnvelopes[i], std::abs(in[i]));
+        }
+    }
+
+    // The same envelope follower as processGroup()'s, for one "channel"
+    const float attackGain = float(1.0 - sweep.attackMultiplier);
+    const float decayGain = float(1.0 - sweep.decayMultiplier);
+    float envelope = linkedEnvelope;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float level = linkedEnvelopes[i];
+        if (level > envelope)
+            envelope += attackGain * (level - envelope);
+        else
+            envelope += decayGain * ((rms ? level : 0.0f) - envelope);
+        linkedEnvelopes[i] = envelope;
+    }
+    linkedEnvelope = envelope;
+}
+
+template <bool rms>
+void AutoWahFilter::followLaneEnvelopes(LaneGroup& __restrict group, const float* __restrict x, int numSamples,
+                                        float attackGain, float decayGain) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Peaks decay towards zero, as in the original code; mean squares decay towards the
+        // current level
+        const float* frame = x + i * numLanes;
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const float level = rms ? frame[lane] * frame[lane] : std::abs(frame[lane]);
+            const bool rising = level > group.envelope[lane];
+            const float target = (rising || rms) ? level : 0.0f;
+            group.envelope[lane] += (rising ? attackGain : decayGain) * (target - group.envelope[lane]);
+        }
+    }
+}
+
+void AutoWahFilter::filterLanes(LaneGroup& __restrict group, float* __restrict x, int numSamples, float k) noexcept
+{
+    const float kWahwahFilterGain = 0.5f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // One step of each lane's TPT state-variable filter; v2 is the lowpass output. The
+        // outputs go to a separate array, so the compiler can vectorize the loop.
+        float* frame = x + i * numLanes;
+        float output[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const float g = group.g[lane] + group.gIncrement[lane];
+            group.g[lane] = g;
+            const float a1 = 1.0f / (1.0f + g * (g + k));
+            const float a2 = g * a1;
+            const float a3 = g * a2;
+            const float ic1eq = group.ic1eq[lane], ic2eq = group.ic2eq[lane];
+            const float v3 = frame[lane] - ic2eq;
+            const float v1 = a1 * ic1eq + a2 * v3;
+            const float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+            group.ic1eq[lane] = 2.0f * v1 - ic1eq;
+            group.ic2eq[lane] = 2.0f * v2 - ic2eq;
+            output[lane] = kWahwahFilterGain * v2;
+        }
+        for (int lane = 0; lane < numLanes; ++lane)
+            frame[lane] = output[lane];
+    }
+}
+
+float AutoWahFilter::processGroup(LaneGroup& group, int numUsedLanes, int numSamples,
+                                  const Sweep& sweep, float phase) noexcept
+{
+    const float k = 1.0f / sweep.filterQ;
+    const bool rms = sweep.detector == kDetectorRMS;
+    const float attackGain = float(1.0 - sweep.attackMultiplier);
+    const float decayGain = float(1.0 - sweep.decayMultiplier);
+
+    // Calculate the envelope of each channel's signal. Do this even if we're not currently
+    // changing the frequency based on it, since it involves maintaining a history
+    // of the signal's behaviour.
+    auto followEnvelopes = [&](const float* x, int count)
+    {
+        if (sweep.linked || count <= 0) return;
+        if (rms) followLaneEnvelopes<true>(group, x, count, attackGain, decayGain);
+        else followLaneEnvelopes<false>(group, x, count, attackGain, decayGain);
+    };
+
+    // Each run of samples starts at a control point (or at the start of the block), and ends
+    // before the next one
+    for (int i = 0; i < numSamples;)
+    {
+        float* x = interleaved + i * numLanes;
+        int envelopeDone = 0;
+
+        // At each control point, head for the new cutoffs over the next interval
+        if (group.samplesToControlPoint <= 0)
+        {
+            followEnvelopes(x, 1);
+            envelopeDone = 1;
+
+            // Calculate the centre frequency of each channel's filter based on the LFO and the
+            // signal envelope
+            const float lfoFrequency = getLfoFrequency(sweep, phase);
+            auto getTarget = [&](float envelope)
+            {
+                float centreFrequency = lfoFrequency;
+                if (sweep.envWidthHz > 0.0f)
+                    centreFrequency += sweep.envWidthHz * (rms ? std::sqrt(envelope) : envelope);
+                return getCutoffGain(sweep, centreFrequency);
+            };
+
+            float target[numLanes] = {};
+            if (sweep.linked)
+            {
+                const float linkedTarget = getTarget(linkedEnvelopes[i]);
+                for (int lane = 0; lane < numUsedLanes; ++lane)
+                    target[lane] = linkedTarget;
+            }
+            else
+            {
+                for (int lane = 0; lane < numUsedLanes; ++lane)
+                    target[lane] = getTarget(group.envelope[lane]);
+            }
+
+            const bool jump = !group.gIsSet || sweep.intervalSamples == 1;
+            const float scale = 1.0f / float(sweep.intervalSamples);
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                if (jump) group.g[lane] = target[lane];
+                group.gIncrement[lane] = jump ? 0.0f : (target[lane] - group.g[lane]) * scale;
+            }
+            group.gIsSet = true;
+            group.samplesToControlPoint = sweep.intervalSamples;
+        }
+
+        const int count = jmin(numSamples - i, group.samplesToControlPoint);
+        followEnvelopes(x + envelopeDone * numLanes, count - envelopeDone);
+        filterLanes(group, x, count, k);
+        group.samplesToControlPoint -= count;
+        i += count;
+
+        // Update the LFO phase, keeping it in the range 0-1
+        for (int n = 0; n < count; ++n)
+        {
+            phase += sweep.lfoPhaseIncrement;
+            while (phase > 1.0f) phase -= 1.0f;
+        }
+    }
+
+    return phase;
+}
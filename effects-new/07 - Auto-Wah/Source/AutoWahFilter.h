@@ -0,0 +1,121 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  AutoWahFilter: the Auto-Wah's filters, for all channels. It follows the input's envelope,
+    sweeps a resonant lowpass filter's cutoff with that and the LFO, and filters the input.
+
+    The original code recomputed the filter's biquad coefficients (a sine, a cosine and a
+    division) for every sample, which cost more than everything else put together. This filter
+    is instead a "topology-preserving transform" state-variable filter (Andrew Simper's
+    version, from the Cytomic technical papers), whose lowpass output has exactly the same
+    response as the biquad, but whose cutoff is set by a single number, g = tan(pi fc / fs).
+    g is worked out only every few samples (the "control rate"), and stepped linearly from
+    each value to the next in between, so the sweep stays smooth; unlike a biquad's
+    coefficients, g can be interpolated like this because the filter is stable for every
+    positive g. One division per sample is left, for the filter's feedback gain.
+
+    The envelope follower either tracks the input's peaks, as the original did, or its mean
+    square (whose square root is only needed at control points), for a smoother, "RMS"
+    envelope. Unlinked, every channel has its own envelope, and so its own sweep. Linked, one
+    envelope, of the loudest channel's peaks or all channels' mean square, drives them all, so
+    a stereo image stays put as the filter moves.
+
+    Channels are processed numLanes at a time: each group of up to numLanes channels is copied
+    into a short block with every channel's samples side by side, so each step of the envelope
+    and filter is one loop over the lanes, which the compiler turns into SIMD instructions. A
+    group always does the work of numLanes channels, so with SSE or NEON (four lanes), up to
+    four channels cost about the same as one. AVX builds use eight lanes, but the compiler
+    only partly vectorizes the eight-lane loops, so eight channels still cost about twice
+    what two do there (against four times, one channel at a time).
+
+    The control points run on from one call to the next, so how the host splits the signal
+    into blocks makes no difference to the output.
+*/
+
+class AutoWahFilter
+{
+public:
+    // Channels processed side by side: as many floats as one SIMD register holds
+#if defined(__AVX__)
+    static const int numLanes = 8;
+#else
+    static const int numLanes = 4;
+#endif
+
+    enum ControlRate
+    {
+        kEverySample = 0,
+        kEvery16Samples,
+        kEvery32Samples,
+        kEvery64Samples,
+        kNumControlRates
+    };
+    static void populateControlRateComboBox(ComboBox& cb);
+    static int getIntervalSamples(ControlRate rate) { return rate == kEverySample ? 1 : 8 << int(rate); }
+
+    enum Detector
+    {
+        kDetectorPeak = 0,
+        kDetectorRMS,
+        kNumDetectors
+    };
+    static void populateDetectorComboBox(ComboBox& cb);
+
+    // Everything which moves the filter, for one block
+    struct Sweep
+    {
+        double inverseSampleRate;
+        float centreFreqHz, lfoWidthHz, envWidthHz, filterQ;
+        double attackMultiplier, decayMultiplier;   // 1st-order filter coefficients
+        float lfoPhase, lfoPhaseIncrement;          // at the block's first sample (0-1), per sample
+        int intervalSamples;                        // between control points
+        Detector detector;
+        bool linked;                                // one envelope for all channels
+    };
+
+    AutoWahFilter();
+
+    // Not on the audio thread: use numChannels channels, all reset. Only allocates if asked for
+    // more channels than ever before.
+    void prepare(int numChannels);
+    int getNumChannels() const { return numChannels; }
+
+    // Clear the signal history and the envelopes; the next sample is a control point
+    void reset();
+
+    // Filter numSamples samples of each of the first numChannels (no more than prepare() was
+    // given) channels in place; returns the LFO phase after the last sample
+    float processSamples(float* const* channelData, int numChannels, int numSamples,
+                         const Sweep& sweep) noexcept;
+
+private:
+    static const int chunkSamples = 64;     // interleaved at a time
+
+    // One group of numLanes channels. The control points are counted separately in each
+    // group, but always agree.
+    struct LaneGroup
+    {
+        float envelope[numLanes];           // peak, or mean square, of each channel's input
+        float ic1eq[numLanes], ic2eq[numLanes];     // the filters' two integrators
+        float g[numLanes], gIncrement[numLanes];    // cutoff gains now, and their steps per sample
+        int samplesToControlPoint;
+        bool gIsSet;                        // false until the first control point after reset()
+    };
+
+    void followLinkedEnvelope(float* const* channelData, int numChannels, int startSample,
+                              int numSamples, const Sweep& sweep) noexcept;
+    template <bool rms>
+    static void followLaneEnvelopes(LaneGroup& __restrict group, const float* __restrict x, int numSamples,
+                                    float attackGain, float decayGain) noexcept;
+    static void filterLanes(LaneGroup& __restrict group, float* __restrict x, int numSamples, float k) noexcept;
+    float processGroup(LaneGroup& group, int numUsedLanes, int numSamples, const Sweep& sweep,
+                       float phase) noexcept;
+    static float getLfoFrequency(const Sweep& sweep, float phase) noexcept;
+    static float getCutoffGain(const Sweep& sweep, float centreFrequency) noexcept;
+
+    int numChannels, numGroups, numAllocatedGroups;
+    HeapBlock<LaneGroup> groups;
+    HeapBlock<float> interleaved;           // chunkSamples frames of numLanes samples
+    float linkedEnvelope;                   // peak, or mean square, of all channels' input
+    HeapBlock<float> linkedEnvelopes;       // linkedEnvelope at each sample of the chunk
+};
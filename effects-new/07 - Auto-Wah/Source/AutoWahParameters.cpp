@@ -23,6 +23,23 @@ const String AutoWahParameters::decayLabel = "sec";
 const String AutoWahParameters::envWidthID = "modDepth";
 const String AutoWahParameters::envWidthName = TRANS("Env Width");
 const String AutoWahParameters::envWidthLabel = "Hz";
+const String AutoWahParameters::controlRateID = "controlRate";
+const String AutoWahParameters::controlRateName = TRANS("Control Rate");
+const String AutoWahParameters::controlRateLabel = "";
+const String AutoWahParameters::detectorID = "detector";
+const String AutoWahParameters::detectorName = TRANS("Detector");
+const String AutoWahParameters::detectorLabel = "";
+const String AutoWahParameters::linkID = "link";
+const String AutoWahParameters::linkName = TRANS("Link Channels");
+const String AutoWahParameters::linkLabel = "";
+
+namespace
+{
+    const AutoWahFilter::ControlRate defaultControlRate = AutoWahFilter::kEvery32Samples;
+    const AutoWahFilter::Detector defaultDetector = AutoWahFilter::kDetectorPeak;
+    const int linkEnumCount = 2;
+    const int linkDefault = 0;
+}
 
 AudioProcessorValueTreeState::ParameterLayout AutoWahParameters::createParameterLayout()
 {
@@ -77,6 +94,24 @@ AudioProcessorValueTreeState::ParameterLayout AutoWahParameters::createParameter
         AudioProcessorParameter::genericParameter,
         [](float value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        controlRateID, controlRateName,
+        0, int(AutoWahFilter::kNumControlRates) - 1, int(defaultControlRate),
+        controlRateLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        detectorID, detectorName,
+        0, int(AutoWahFilter::kNumDetectors) - 1, int(defaultDetector),
+        detectorLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        linkID, linkName,
+        0, linkEnumCount - 1, linkDefault,
+        linkLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
 
     return { params.begin(), params.end() };
 }
@@ -90,6 +125,9 @@ AutoWahParameters::AutoWahParameters(AudioProcessorValueTreeState& vts,
     , attackTimeSec(0.006f)
     , decayTimeSec(0.2f)
     , envWidthHz(0.0f)
+    , controlRate(defaultControlRate)
+    , detector(defaultDetector)
+    , linked(linkDefault != 0)
     , valueTreeState(vts)
     , processorAsListener(processor)
     , centreFreqListener(centreFreqHz)
@@ -99,6 +137,9 @@ AutoWahParameters::AutoWahParameters(AudioProcessorValueTreeState& vts,
     , attackListener(attackTimeSec)
     , releaseListener(decayTimeSec)
     , envWidthListener(envWidthHz)
+    , controlRateListener(controlRate)
+    , detectorListener(detector)
+    , linkListener(linked)
 {
     valueTreeState.addParameterListener(centreFreqID, &centreFreqListener);
     valueTreeState.addParameterListener(filterQID, &filterQListener);
@@ -107,6 +148,9 @@ AutoWahParameters::AutoWahParameters(AudioProcessorValueTreeState& vts,
     valueTreeState.addParameterListener(attackID, &attackListener);
     valueTreeState.addParameterListener(decayID, &releaseListener);
     valueTreeState.addParameterListener(envWidthID, &envWidthListener);
+    valueTreeState.addParameterListener(controlRateID, &controlRateListener);
+    valueTreeState.addParameterListener(detectorID, &detectorListener);
+    valueTreeState.addParameterListener(linkID, &linkListener);
     valueTreeState.addParameterListener(centreFreqID, processorAsListener);
     valueTreeState.addParameterListener(filterQID, processorAsListener);
     valueTreeState.addParameterListener(attackID, processorAsListener);
@@ -123,6 +167,9 @@ AutoWahParameters::~AutoWahParameters()
     valueTreeState.removeParameterListener(attackID, &attackListener);
     valueTreeState.removeParameterListener(decayID, &releaseListener);
     valueTreeState.removeParameterListener(envWidthID, &envWidthListener);
+    valueTreeState.removeParameterListener(controlRateID, &controlRateListener);
+    valueTreeState.removeParameterListener(detectorID, &detectorListener);
+    valueTreeState.removeParameterListener(linkID, &linkListener);
     valueTreeState.removeParameterListener(centreFreqID, processorAsListener);
     valueTreeState.removeParameterListener(filterQID, processorAsListener);
     valueTreeState.removeParameterListener(attackID, processorAsListener);
@@ -138,6 +185,9 @@ void AutoWahParameters::detachControls()
     attackAttachment.reset(nullptr);
     releaseAttachment.reset(nullptr);
     envWidthAttachment.reset(nullptr);
+    controlRateAttachment.reset(nullptr);
+    detectorAttachment.reset(nullptr);
+    linkAttachment.reset(nullptr);
 }
 
 void AutoWahParameters::attachControls(
@@ -147,7 +197,10 @@ void AutoWahParameters::attachControls(
     Slider& lfoWidthKnob,
     Slider& attackKnob,
     Slider& decayKnob,
-    Slider& envWidthKnob )
+    Slider& envWidthKnob,
+    ComboBox& controlRateCombo,
+    ComboBox& detectorCombo,
+    ToggleButton& linkToggle )
 {
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
     centreFreqAttachment.reset(new SlAt(valueTreeState, centreFreqID, centreFreqKnob));
@@ -157,4 +210,11 @@ void AutoWahParameters::attachControls(
     attackAttachment.reset(new SlAt(valueTreeState, attackID, attackKnob));
     releaseAttachment.reset(new SlAt(valueTreeState, decayID, decayKnob));
     envWidthAttachment.reset(new SlAt(valueTreeState, envWidthID, envWidthKnob));
+
+    using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
+    controlRateAttachment.reset(new CbAt(valueTreeState, controlRateID, controlRateCombo));
+    detectorAttachment.reset(new CbAt(valueTreeState, detectorID, detectorCombo));
+
+    using TbAt = AudioProcessorValueTreeState::ButtonAttachment;
+    linkAttachment.reset(new TbAt(valueTreeState, linkID, linkToggle));
 }
\ No newline at end of file
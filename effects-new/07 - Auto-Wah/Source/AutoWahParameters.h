@@ -1,6 +1,7 @@
 #pragma once
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
+#include "AutoWahFilter.h"
 
 class AutoWahParameters
 {
@@ -14,6 +15,9 @@ public:
     static const String attackID, attackName, attackLabel;
     static const String decayID, decayName, decayLabel;
     static const String envWidthID, envWidthName, envWidthLabel;
+    static const String controlRateID, controlRateName, controlRateLabel;
+    static const String detectorID, detectorName, detectorLabel;
+    static const String linkID, linkName, linkLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
@@ -29,7 +33,10 @@ public:
         Slider& lfoWidthKnob,
         Slider& attackKnob,
         Slider& decayKnob,
-        Slider& envWidthKnob );
+        Slider& envWidthKnob,
+        ComboBox& controlRateCombo,
+        ComboBox& detectorCombo,
+        ToggleButton& linkToggle );
 
     // working parameter values
     float centreFreqHz;
@@ -39,6 +46,9 @@ public:
     float attackTimeSec;
     float decayTimeSec;
     float envWidthHz;
+    AutoWahFilter::ControlRate controlRate;
+    AutoWahFilter::Detector detector;
+    bool linked;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -55,6 +65,9 @@ private:
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> attackAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> releaseAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> envWidthAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> controlRateAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> detectorAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ButtonAttachment> linkAttachment;
 
     // Listener objects link parameters to working variables
     FloatListener centreFreqListener;
@@ -64,4 +77,7 @@ private:
     FloatListener attackListener;
     FloatListener releaseListener;
     FloatListener envWidthListener;
+    EnumListener<AutoWahFilter::ControlRate> controlRateListener;
+    EnumListener<AutoWahFilter::Detector> detectorListener;
+    BoolListener linkListener;
 };
\ No newline at end of file
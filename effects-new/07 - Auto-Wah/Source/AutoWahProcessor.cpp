@@ -21,13 +21,15 @@ AutoWahProcessor::AutoWahProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("AutoWah"), AutoWahParameters::createParameterLayout())
     , parameters(valueTreeState, this)
-    , envelopes(nullptr), numEnvelopes(0)
     , lfoPhase(0.0f)
     , attackMultiplier(1.0f), decayMultiplier(0.0f)
     , inverseSampleRate(1.0 / 44100.0)  // sensible default
 {
     // force initializion of attackMultiplier, decayMultiplier
     parameterChanged("", 0.0f);
+
+    // Enough channels for the default layout, so prepareToPlay() need not allocate
+    filter.prepare(getTotalNumInputChannels());
 }
 
 // Destructor
@@ -53,88 +55,53 @@ void AutoWahProcessor::parameterChanged(const String&, float)
 // Prepare to process audio (always called at least once before processBlock)
 void AutoWahProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
 {
-    inverseSampleRate = 1.0 / sampleRate;
+    // Scheduled parameter changes are timed from here
+    automation.reset();
 
-    // create as many identical filters as there are input channels
-    for (int i = 0; i < getTotalNumInputChannels(); i++)
-        filters.add(new ResonantLowpassFilter);
+    inverseSampleRate = 1.0 / sampleRate;
 
-    // same for envelopes, setting them all to zero
-    if (envelopes) delete[] envelopes;
-    numEnvelopes = getTotalNumInputChannels();
-    envelopes = new double[numEnvelopes];
-    for (int i = 0; i < numEnvelopes; i++) envelopes[i] = 0.0;
+    // filter as many channels as there are inputs, with all envelopes at zero
+    filter.prepare(getTotalNumInputChannels());
 }
 
-// Audio processing finished; release any allocated memory
+// Audio processing finished; the filters and envelopes are kept, for the next prepareToPlay()
 void AutoWahProcessor::releaseResources()
 {
-    delete[] envelopes;
-    envelopes = nullptr;
-    numEnvelopes = 0;
-    filters.clear();
 }
 
 // Process one buffer ("block") of data
 void AutoWahProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void AutoWahProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
     int numInputChannels = getTotalNumInputChannels();
-    int numFilters = filters.size();    // should be the same
+    int numFilters = filter.getNumChannels();   // should be the same
     int numOutputChannels = getTotalNumOutputChannels();
     int numSamples = buffer.getNumSamples();
 
-    const float TWOPI_F = 6.283185f;
-    const double kWahwahFilterGain = 0.5;
-    float phi = lfoPhase;
-    float dphi = float(parameters.lfoFreqHz * inverseSampleRate);
-
-    int ch = 0;
-    for (; ch < jmin(numInputChannels, numFilters); ch++)
-    {
-        // channelData is an array of length numSamples which contains the audio for one channel
-        float* channelData = buffer.getWritePointer(ch);
-        phi = lfoPhase;
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            const float in = channelData[sample];
-            float centreFrequency = parameters.centreFreqHz;
-
-            // Calculate the envelope of the signal. Do this even if we're not currently
-            // changing the frequency based on it, since it involves maintaining a history
-            // of the signal's behaviour.
-            if (ch < numEnvelopes)   // Safety check
-            {
-                if (fabs(in) > envelopes[ch])
-                    envelopes[ch] += (1.0 - attackMultiplier) * (fabs(in) - envelopes[ch]);
-                else
-                    envelopes[ch] *= decayMultiplier;
-            }
-
-            // Calculate the centre frequency of the filter based on the LFO and the
-            // signal envelope
-            if (parameters.lfoWidthHz > 0.0f)
-                centreFrequency += parameters.lfoWidthHz * (0.5f + 0.5f * sinf(TWOPI_F * phi));
-            if (parameters.envWidthHz > 0.0f && ch < numEnvelopes)
-                centreFrequency += parameters.envWidthHz * float(envelopes[ch]);
-
-            // Update filter coefficients (see ResonantLowpassFilter.cpp for calculation)
-            filters[ch]->makeResonantLowpass(inverseSampleRate, centreFrequency,
-                parameters.filterQ, kWahwahFilterGain);
-
-            // Process one sample and store it back in place. See juce_IIRFilter.cpp for the
-            // application of the IIR filter.
-            channelData[sample] = filters[ch]->processSingleSampleRaw(in);
-
-            // Update the LFO phase, keeping it in the range 0-1
-            phi += dphi;
-            while (phi > 1.0f) phi -= 1.0f;
-        }
-    }
-
-    lfoPhase = phi;
+    AutoWahFilter::Sweep sweep;
+    sweep.inverseSampleRate = inverseSampleRate;
+    sweep.centreFreqHz = parameters.centreFreqHz;
+    sweep.lfoWidthHz = parameters.lfoWidthHz;
+    sweep.envWidthHz = parameters.envWidthHz;
+    sweep.filterQ = parameters.filterQ;
+    sweep.attackMultiplier = attackMultiplier;
+    sweep.decayMultiplier = decayMultiplier;
+    sweep.lfoPhase = lfoPhase;
+    sweep.lfoPhaseIncrement = float(parameters.lfoFreqHz * inverseSampleRate);
+    sweep.intervalSamples = AutoWahFilter::getIntervalSamples(parameters.controlRate);
+    sweep.detector = parameters.detector;
+    sweep.linked = parameters.linked;
+
+    // All channels are filtered together, and the LFO phase carries on from where they leave it
+    int ch = jmin(numInputChannels, numFilters);
+    lfoPhase = filter.processSamples(buffer.getArrayOfWritePointers(), ch, numSamples, sweep);
 
     // Go through the remaining channels. In case we have more outputs
     // than inputs, or there aren't enough filters, we'll clear any
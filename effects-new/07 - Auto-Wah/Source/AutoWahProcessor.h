@@ -1,10 +1,12 @@
 #pragma once
 #include "JuceHeader.h"
 #include "AutoWahParameters.h"
-#include "ResonantLowpassFilter.h"
+#include "AutoWahFilter.h"
+#include "AutomationScheduler.h"
 
 class AutoWahProcessor  : public AudioProcessor
                         , public AudioProcessorValueTreeState::Listener
+                        , public AutomationScheduler::Owner
 {
 public:
     AutoWahProcessor();
@@ -31,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -47,9 +52,12 @@ protected:
     void parameterChanged(const String&, float) override;
 
 private:
-    OwnedArray<ResonantLowpassFilter> filters;
-    double* envelopes;
-    int numEnvelopes;
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // Every channel's filter, and the envelope(s) of the input signal (see AutoWahFilter.h)
+    AutoWahFilter filter;
 
     float lfoPhase;   // Phase of the low-frequency oscillator
     double attackMultiplier, decayMultiplier; // attack/decay times converted to 1st-order filter coefficients
@@ -0,0 +1,237 @@
+#include "AllpassCascade.h"
+
+namespace
+{
+    // The coefficient for normalised frequencies w0 (centre frequency / sample rate, as
+    // makeAllpass() uses it) from 0 to pi, with a guard point at the end, so a linear
+    // interpolation never needs to go past it. The coefficient is a smooth function of w0
+    // (it is tan(pi/4 - w0/2)), so 2048 points give it to within about a millionth.
+    const int tableSize = 2048;
+    const double tableMaxW0 = MathConstants<double>::pi;
+    float table[tableSize + 1];
+
+    // The coefficient exactly as OnePoleAllpassFilter::makeAllpass() computes it
+    float computeCoefficient(double w0)
+    {
+        // Avoid passing pi/2 to the tan function...
+        w0 = jmin(w0, 0.99 * MathConstants<double>::pi);
+        const double tan_half_w0 = std::tan(0.5 * w0);
+        return float((1.0 - tan_half_w0) / (1.0 + tan_half_w0));
+    }
+
+    // Fills in the table during static initialisation, long before any audio thread needs it
+    struct TableInitialiser
+    {
+        TableInitialiser()
+        {
+            for (int i = 0; i <= tableSize; ++i)
+                table[i] = computeCoefficient(tableMaxW0 * i / tableSize);
+        }
+    };
+
+    TableInitialiser tableInitialiser;
+}
+
+float AllpassCascade::getCoefficient(double inverseSampleRate, float centreFrequency) noexcept
+{
+    const float scale = float(inverseSampleRate * tableSize / tableMaxW0);
+    const float x = jlimit(0.0f, float(tableSize) - 0.001f, centreFrequency * scale);
+    const int index = int(x);
+    const float fraction = x - float(index);
+    return table[index] + fraction * (table[index + 1] - table[index]);
+}
+
+AllpassCascade::AllpassCascade()
+    : numChannels(0), numGroups(0), numAllocatedGroups(0)
+    , interleaved(chunkSamples * numLanes)
+    , coefficients(chunkSamples * numLanes)
+    , firstCoefficients(chunkSamples)
+    , otherCoefficients(chunkSamples)
+{
+}
+
+void AllpassCascade::prepare(int numChannelsToUse)
+{
+    numChannels = numChannelsToUse;
+    numGroups = (numChannels + numLanes - 1) / numLanes;
+    if (numGroups > numAllocatedGroups)
+    {
+        groups.allocate(numGroups, true);
+        numAllocatedGroups = numGroups;
+    }
+    reset();
+}
+
+void AllpassCascade::reset()
+{
+    for (int i = 0; i < numGroups; ++i)
+    {
+        LaneGroup& group = groups[i];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            for (int stage = 0; stage < maxStages; ++stage)
+                group.state[stage][lane] = 0.0f;
+        }
+        group.numStagesInUse = maxStages;
+    }
+}
+
+void AllpassCascade::processSamples(float* const* channelData, int numChannelsToProcess, int numSamples,
+                                    const Sweep& sweep) noexcept
+{
+    jassert(numChannelsToProcess <= numChannels);
+    const int numGroupsToProcess = (numChannelsToProcess + numLanes - 1) / numLanes;
+    jassert(sweep.numStages % 2 == 0);
+    const int numStages = jlimit(0, int(maxStages), sweep.numStages) & ~1;
+
+    // Stages which have just been switched back on start from silence
+    for (int groupIndex = 0; groupIndex < numGroupsToProcess; ++groupIndex)
+    {
+        LaneGroup& group = groups[groupIndex];
+        for (int stage = group.numStagesInUse; stage < numStages; ++stage)
+            for (int lane = 0; lane < numLanes; ++lane)
+                group.state[stage][lane] = 0.0f;
+        group.numStagesInUse = numStages;
+    }
+
+    for (int start = 0; start < numSamples; start += chunkSamples)
+    {
+        const int count = jmin(chunkSamples, numSamples - start);
+
+        // Every channel but the first follows the same LFO, so each LFO's coefficients need
+        // only be looked up once
+        for (int i = 0; i < count; ++i)
+        {
+            firstCoefficients[i] = getCoefficient(sweep.inverseSampleRate,
+                                                  sweep.baseFreqHz + sweep.sweepWidthHz * sweep.lfo[start + i]);
+            otherCoefficients[i] = getCoefficient(sweep.inverseSampleRate,
+                                                  sweep.baseFreqHz + sweep.sweepWidthHz * sweep.otherChannelsLfo[start + i]);
+        }
+
+        for (int groupIndex = 0; groupIndex < numGroupsToProcess; ++groupIndex)
+        {
+            const int firstChannel = groupIndex * numLanes;
+            const int numUsedLanes = jmin(numLanes, numChannelsToProcess - firstChannel);
+
+            // Unused lanes are zero, so their filters stay silent
+            if (numUsedLanes < numLanes)
+                FloatVectorOperations::clear(interleaved, count * numLanes);
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const float* a = (firstChannel + lane == 0) ? firstCoefficients : otherCoefficients;
+                for (int i = 0; i < count; ++i)
+                    coefficients[i * numLanes + lane] = a[i];
+            }
+            for (int lane = 0; lane < numUsedLanes; ++lane)
+            {
+                const float* in = channelData[firstChannel + lane] + start;
+                for (int i = 0; i < count; ++i)
+                    interleaved[i * numLanes + lane] = in[i];
+            }
+
+            filterLanes(groups[groupIndex], interleaved, coefficients, count,
+                        numStages, sweep.feedback, sweep.depth);
+
+            for (int lane = 0; lane < numUsedLanes; ++lane)
+            {
+                float* out = channelData[firstChannel + lane] + start;
+                for (int i = 0; i < count; ++i)
+                    out[i] = interleaved[i * numLanes + lane];
+            }
+        }
+    }
+}
+
+void AllpassCascade::filterLanes(LaneGroup& __restrict group, float* __restrict x, const float* __restrict a,
+                                 int numSamples, int numStages, float feedback, float depth) noexcept
+{
+    // Add the allpass signal to the output, though maintaining constant level
+    // depth = 0 --> input only ; depth = 1 --> evenly balanced input and output
+    const float wetGain = 0.5f * depth;
+    const float dryGain = 1.0f - wetGain;
+
+    // The part of each stage's input which comes from the states before it, this sample
+    float inputStatePart[maxStages][numLanes];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // This sample's coefficients, copied so the compiler can see that nothing changes them
+        float* frame = x + i * numLanes;
+        float coefficient[numLanes], coefficientSquared[numLanes], statePart[numLanes], stateGain[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+            coefficient[lane] = a[i * numLanes + lane];
+        for (int lane = 0; lane < numLanes; ++lane)
+            coefficientSquared[lane] = coefficient[lane] * coefficient[lane];
+        for (int lane = 0; lane < numLanes; ++lane)
+            stateGain[lane] = -1.0f - coefficient[lane];
+
+        // Each stage is a TPT one-pole lowpass, with state s, turned into an allpass by
+        // y = x - 2 lp, which comes to y = a x - (1 + a) s. So every stage's output is a times
+        // its input, plus a part which depends only on the states. First, find that part of
+        // every stage's input (what it would be if the cascade's input were zero), and of the
+        // last stage's output, S; the cascade's output is then a^N u + S, for an input u.
+        // Two stages at a time: the second one's part is a^2 times the first one's, plus
+        // -(1 + a)(a s0 + s1), and the bracket can be worked out before the first is known.
+        // (Each step is a separate loop over the lanes, which the compiler vectorizes reliably.)
+        float totalGain[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            statePart[lane] = 0.0f;
+            totalGain[lane] = 1.0f;
+        }
+        for (int stage = 0; stage < numStages; stage += 2)
+        {
+            const float* state0 = group.state[stage];
+            const float* state1 = group.state[stage + 1];
+            float* input0 = inputStatePart[stage];
+            float* input1 = inputStatePart[stage + 1];
+            float t[numLanes];
+            for (int lane = 0; lane < numLanes; ++lane)
+                t[lane] = coefficient[lane] * state0[lane] + state1[lane];
+            for (int lane = 0; lane < numLanes; ++lane)
+                input0[lane] = statePart[lane];
+            for (int lane = 0; lane < numLanes; ++lane)
+                input1[lane] = coefficient[lane] * statePart[lane] + stateGain[lane] * state0[lane];
+            for (int lane = 0; lane < numLanes; ++lane)
+                statePart[lane] = coefficientSquared[lane] * statePart[lane] + stateGain[lane] * t[lane];
+            for (int lane = 0; lane < numLanes; ++lane)
+                totalGain[lane] *= coefficientSquared[lane];
+        }
+
+        // The feedback loop has no delay in it: the cascade's input is u = in + k y, and its
+        // output is y = a^N u + S, so u = (in + k S) / (1 - k a^N). |a| < 1 and k < 1, so
+        // the denominator is never zero.
+        float loopInput[numLanes], output[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+            loopInput[lane] = (frame[lane] + feedback * statePart[lane]) / (1.0f - feedback * totalGain[lane]);
+        for (int lane = 0; lane < numLanes; ++lane)
+            output[lane] = totalGain[lane] * loopInput[lane] + statePart[lane];
+
+        // Now every stage's input is known, without running the stages in turn, so all their
+        // states can be updated at once: s += (1 - a)(x - s), i.e. by twice the lowpass's v
+        float inputGain[numLanes], stateStep[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            inputGain[lane] = 1.0f;
+            stateStep[lane] = 1.0f - coefficient[lane];
+        }
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            float* state = group.state[stage];
+            const float* inputPart = inputStatePart[stage];
+            float input[numLanes];
+            for (int lane = 0; lane < numLanes; ++lane)
+                input[lane] = inputGain[lane] * loopInput[lane] + inputPart[lane];
+            for (int lane = 0; lane < numLanes; ++lane)
+                state[lane] += stateStep[lane] * (input[lane] - state[lane]);
+            for (int lane = 0; lane < numLanes; ++lane)
+                inputGain[lane] *= coefficient[lane];
+        }
+
+        // The outputs go to a separate array, so the compiler can vectorize the loop
+        for (int lane = 0; lane < numLanes; ++lane)
+            output[lane] = dryGain * frame[lane] + wetGain * output[lane];
+        for (int lane = 0; lane < numLanes; ++lane)
+            frame[lane] = output[lane];
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  AllpassCascade: the Phaser's chain of first-order allpass filters, for all channels.
+
+    The original code kept one OnePoleAllpassFilter object per stage per channel, reached each
+    one through an array of pointers (with a bounds check) on every sample, and recalculated
+    every stage's coefficient, a double-precision tan() and a division, every 8 samples, even
+    though all the stages of a channel always share the same coefficient.
+
+    Here, the coefficient for each centre frequency is looked up (with linear interpolation) in
+    a table, computed once, of exactly what OnePoleAllpassFilter::makeAllpass() would give, so
+    it costs so little that it is updated on every sample, and only once per channel rather
+    than once per stage. Each stage is a "topology-preserving transform" (TPT) one-pole filter,
+    with a single state variable, which has the same response as the original's, but keeps
+    behaving like the analog circuit it models while its coefficient moves.
+
+    The original fed the last sample's output back to the input, so the loop had one sample of
+    delay in it, which shifts the notches, more so the higher they are, and makes the feedback
+    sound less like an analog phaser's. Here the loop is delay-free: every stage's output is
+    its coefficient times its input, plus a part which depends only on its state, so the whole
+    cascade's output is a^N times its input plus a known part, and the equation for the input,
+    with feedback, can be solved exactly on every sample, at the cost of one division (see
+    filterLanes()). Once the input is known, so is every stage's, and all the states can be
+    updated at once, rather than one stage after another.
+
+    Channels are processed numLanes at a time, much as in the Auto-Wah's filter: each group of
+    up to numLanes channels is copied into a short block with every channel's samples side by
+    side, and every stage's state is an array with one value per lane ("structure of arrays"),
+    so the work of a stage, for all the channels of a group, is a few loops over the lanes,
+    which the compiler turns into SIMD instructions. Finding each sample's input still means
+    going through the stages in turn, so channels are the only thing which can go in the lanes
+    without adding latency. A phaser is rarely used on more than two channels, so the lanes
+    are always four floats wide (SSE, NEON, and the lower half of an AVX register): wider
+    lanes would only carry more silence, and the compiler vectorizes eight-lane versions of
+    these loops much less reliably. A group costs the same however many of its lanes are
+    used, so stereo costs the same as mono.
+
+    Solving the loop costs about half as much again as the one-sample delay did, but the
+    cascade is still faster than the original code for any number of stages: 16 cost less
+    than the original's 8 (see the phaser kernel benchmark).
+*/
+
+class AllpassCascade
+{
+public:
+    // Channels processed side by side
+    static const int numLanes = 4;
+
+    static const int maxStages = 32;
+
+    // Everything which affects the filters, for one block
+    struct Sweep
+    {
+        double inverseSampleRate;
+        float baseFreqHz, sweepWidthHz;
+        const float* lfo;                   // per sample (0-1), for the first channel
+        const float* otherChannelsLfo;      // ditto for all the others
+        int numStages;                      // even, up to maxStages
+        float feedback;                     // 0-1
+        float depth;                        // 0 (dry) to 1 (even mix of dry and filtered)
+    };
+
+    // What OnePoleAllpassFilter::makeAllpass() gives for the given centre frequency
+    static float getCoefficient(double inverseSampleRate, float centreFrequency) noexcept;
+
+    AllpassCascade();
+
+    // Not on the audio thread: use numChannels channels, all reset. Only allocates if asked for
+    // more channels than ever before.
+    void prepare(int numChannels);
+    int getNumChannels() const { return numChannels; }
+
+    // Clear the filters' states
+    void reset();
+
+    // Filter numSamples samples of each of the first numChannels (no more than prepare() was
+    // given) channels in place
+    void processSamples(float* const* channelData, int numChannels, int numSamples,
+                        const Sweep& sweep) noexcept;
+
+private:
+    static const int chunkSamples = 64;     // interleaved at a time
+
+    // One group of numLanes channels
+    struct LaneGroup
+    {
+        float state[maxStages][numLanes];   // each stage's single state variable, per lane
+        int numStagesInUse;                 // states above this are stale
+    };
+
+    static void filterLanes(LaneGroup& __restrict group, float* __restrict x, const float* __restrict a,
+                            int numSamples, int numStages, float feedback, float depth) noexcept;
+
+    int numChannels, numGroups, numAllocatedGroups;
+    HeapBlock<LaneGroup> groups;
+    HeapBlock<float> interleaved;           // chunkSamples frames of numLanes samples
+    HeapBlock<float> coefficients;          // ditto, of each lane's coefficient
+    HeapBlock<float> firstCoefficients, otherCoefficients;  // chunkSamples of each LFO's
+};
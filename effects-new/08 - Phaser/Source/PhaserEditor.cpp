@@ -39,12 +39,19 @@ PhaserEditor::PhaserEditor (PhaserProcessor& p)
     lfoWaveformCombo.setJustificationType(Justification::centredLeft);
     PhaserLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
+    lfoSyncLabel.setText("LFO Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
     numFiltersLabel.setText("Number of Filters", dontSendNotification);
     numFiltersLabel.setJustificationType(Justification::right);
     addAndMakeVisible(&numFiltersLabel);
     numFiltersCombo.setEditableText(false);
     numFiltersCombo.setJustificationType(Justification::centredLeft);
-    for (int i = 2; i <= 10; i += 2)
+    for (int i = 2; i <= 2 * PhaserParameters::numFiltersEnumCount; i += 2)
         numFiltersCombo.addItem(String(i), i);
     addAndMakeVisible(numFiltersCombo);
 
@@ -56,9 +63,10 @@ PhaserEditor::PhaserEditor (PhaserProcessor& p)
         lfoFreqKnob,
         stereoButton,
         lfoWaveformCombo,
+        lfoSyncCombo,
         numFiltersCombo);
 
-    setSize (60 + 100 * 8 + 10 * (8 - 1), 180);
+    setSize (60 + 100 * 8 + 10 * (8 - 1), 214);
 }
 
 PhaserEditor::~PhaserEditor()
@@ -97,6 +105,11 @@ void PhaserEditor::resized()
     lfoWaveformCombo.setBounds(rowArea);
     widgetsArea.removeFromTop(10);
     rowArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(rowArea.removeFromLeft(120));
+    rowArea.removeFromLeft(10);
+    lfoSyncCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
     numFiltersLabel.setBounds(rowArea.removeFromLeft(120));
     rowArea.removeFromLeft(10);
     numFiltersCombo.setBounds(rowArea);
@@ -1,4 +1,5 @@
 #include "PhaserParameters.h"
+#include "AllpassCascade.h"
 
 // Base Frequency
 const String PhaserParameters::baseFreqID = "baseFreq";
@@ -52,11 +53,17 @@ const String PhaserParameters::lfoWaveformName = TRANS("LFO");
 const String PhaserParameters::lfoWaveformLabel = "";
 const int PhaserParameters::lfoWaveformEnumCount = 4;
 const int PhaserParameters::lfoWaveformDefault = 0;
+// LFO Sync
+const String PhaserParameters::lfoSyncID = "lfoSync";
+const String PhaserParameters::lfoSyncName = TRANS("LFO Sync");
+const String PhaserParameters::lfoSyncLabel = "";
+const int PhaserParameters::lfoSyncEnumCount = BlockLFO::kNumSyncs;
+const int PhaserParameters::lfoSyncDefault = 0;
 // Number of Filters
 const String PhaserParameters::numFiltersID = "numFilters";
 const String PhaserParameters::numFiltersName = TRANS("Number of Filters");
 const String PhaserParameters::numFiltersLabel = "";
-const int PhaserParameters::numFiltersEnumCount = 5;
+const int PhaserParameters::numFiltersEnumCount = AllpassCascade::maxStages / 2;     // 2, 4, ... 32
 const int PhaserParameters::numFiltersDefault = 1;
 
 AudioProcessorValueTreeState::ParameterLayout PhaserParameters::createParameterLayout()
@@ -110,6 +117,12 @@ AudioProcessorValueTreeState::ParameterLayout PhaserParameters::createParameterL
         lfoWaveformLabel,
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, lfoSyncEnumCount - 1, lfoSyncDefault,
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
     params.push_back(std::make_unique<AudioParameterInt>(
         numFiltersID, numFiltersName,
         0, numFiltersEnumCount - 1, numFiltersDefault,
@@ -120,8 +133,7 @@ AudioProcessorValueTreeState::ParameterLayout PhaserParameters::createParameterL
     return { params.begin(), params.end() };
 }
 
-PhaserParameters::PhaserParameters(AudioProcessorValueTreeState& vts,
-                                   AudioProcessorValueTreeState::Listener* processor)
+PhaserParameters::PhaserParameters(AudioProcessorValueTreeState& vts)
     : baseFreqHz(baseFreqDefault)
     , sweepWidthHz(sweepWidthDefault)
     , depth(depthDefault)
@@ -129,9 +141,9 @@ PhaserParameters::PhaserParameters(AudioProcessorValueTreeState& vts,
     , lfoFreqHz(lfoFreqDefault)
     , stereoMode(stereoDefault)
     , lfoWaveform((PhaserLFO::Waveform)lfoWaveformDefault)
+    , lfoSync((BlockLFO::Sync)lfoSyncDefault)
     , numFilters(numFiltersDefault)
     , valueTreeState(vts)
-    , processorAsListener(processor)
     , baseFreqListener(baseFreqHz)
     , sweepWidthListener(sweepWidthHz)
     , depthListener(depth, 0.01f)
@@ -139,6 +151,7 @@ PhaserParameters::PhaserParameters(AudioProcessorValueTreeState& vts,
     , lfoFreqListener(lfoFreqHz)
     , stereoListener(stereoMode)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , numFiltersListener(numFilters, 2, 2)
 {
     valueTreeState.addParameterListener(baseFreqID, &baseFreqListener);
@@ -148,8 +161,8 @@ PhaserParameters::PhaserParameters(AudioProcessorValueTreeState& vts,
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(stereoID, &stereoListener);
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.addParameterListener(numFiltersID, &numFiltersListener);
-    valueTreeState.addParameterListener(numFiltersID, processorAsListener);
 
     depth = 1.0f;
     numFilters = 4;
@@ -165,8 +178,8 @@ PhaserParameters::~PhaserParameters()
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(stereoID, &stereoListener);
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.removeParameterListener(numFiltersID, &numFiltersListener);
-    valueTreeState.removeParameterListener(numFiltersID, processorAsListener);
 }
 
 void PhaserParameters::detachControls()
@@ -178,6 +191,7 @@ void PhaserParameters::detachControls()
     lfoFreqAttachment.reset(nullptr);
     stereoAttachment.reset(nullptr);
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     numFiltersAttachment.reset(nullptr);
 }
 
@@ -189,6 +203,7 @@ void PhaserParameters::attachControls(
     Slider& lfoFreqKnob,
     ToggleButton& stereoButton,
     ComboBox& lfoWaveformCombo,
+    ComboBox& lfoSyncCombo,
     ComboBox& numFiltersCombo )
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -201,5 +216,6 @@ void PhaserParameters::attachControls(
     lfoFreqAttachment.reset(new SlAt(valueTreeState, lfoFreqID, lfoFreqKnob));
     stereoAttachment.reset(new TbAt(valueTreeState, stereoID, stereoButton));
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
     numFiltersAttachment.reset(new CbAt(valueTreeState, numFiltersID, numFiltersCombo));
 }
\ No newline at end of file
@@ -22,13 +22,14 @@ public:
     static const int stereoEnumCount, stereoDefault;
     static const String lfoWaveformID, lfoWaveformName, lfoWaveformLabel;
     static const int lfoWaveformEnumCount, lfoWaveformDefault;
+    static const String lfoSyncID, lfoSyncName, lfoSyncLabel;
+    static const int lfoSyncEnumCount, lfoSyncDefault;
     static const String numFiltersID, numFiltersName, numFiltersLabel;
     static const int numFiltersEnumCount, numFiltersDefault;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
-    PhaserParameters(AudioProcessorValueTreeState& vts,
-                     AudioProcessorValueTreeState::Listener* processor);
+    PhaserParameters(AudioProcessorValueTreeState& vts);
     ~PhaserParameters();
 
     void detachControls();
@@ -40,6 +41,7 @@ public:
         Slider& lfoFreqKnob,
         ToggleButton& stereoButton,
         ComboBox& lfoWaveformCombo,
+        ComboBox& lfoSyncCombo,
         ComboBox& numFiltersCombo );
 
     // working parameter values
@@ -50,15 +52,13 @@ public:
     float lfoFreqHz;
     bool stereoMode;
     PhaserLFO::Waveform lfoWaveform;
+    BlockLFO::Sync lfoSync;
     int numFilters;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
     AudioProcessorValueTreeState& valueTreeState;
 
-    // Pointer to processor as an AudioProcessorValueTreeState::Listener
-    AudioProcessorValueTreeState::Listener* processorAsListener;
-
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> baseFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> sweepWidthAttachment;
@@ -67,6 +67,7 @@ private:
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ButtonAttachment> stereoAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoSyncAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> numFiltersAttachment;
 
     // Listener objects link parameters to working variables
@@ -77,5 +78,6 @@ private:
     FloatListener lfoFreqListener;
     BoolListener stereoListener;
     EnumListener<PhaserLFO::Waveform> lfoWaveformListener;
+    EnumListener<BlockLFO::Sync> lfoSyncListener;
     IntegerListener numFiltersListener;
 };
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 #include "JuceHeader.h"
 #include "PhaserParameters.h"
-#include "OnePoleAllpassFilter.h"
+#include "AllpassCascade.h"
+#include "AutomationScheduler.h"
+#include "BlockLFO.h"
 
 class PhaserProcessor : public AudioProcessor
-                      , public AudioProcessorValueTreeState::Listener
+                      , public AutomationScheduler::Owner
 {
 public:
     PhaserProcessor();
@@ -31,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -42,24 +47,17 @@ public:
     // Application's view of the AudioProcessorValueTreeState, including working parameter values
     PhaserParameters parameters;
 
-    // Responding to parameter changes
-    void parameterChanged(const String&, float) override;
-
-protected:
-    void allocateFilters(int numFilters);
-
 private:
-    float lfoPhase;             // Phase of the low-frequency oscillator
-    double inverseSampleRate;   // Cache inverse of sample rate (more efficient to multiply than divide)
-    unsigned int filterUpdateInterval;  // How often to update filter coefficients (samples)
-    unsigned int sampleCount;   // counts samples up to filterUpdateInterval
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
 
-    // Bank of allpass filters that do the phasing; N filters x M channels
-    OwnedArray<OnePoleAllpassFilter> allpassFilters;
+    BlockLFO lfo;               // Renders each block's modulation once (twice for stereo)
+    double inverseSampleRate;   // Cache inverse of sample rate (more efficient to multiply than divide)
 
-    // Storage of the last output sample from each bank of filters, for use in feedback loop
-    float *lastFilterOutputs;
-    int numLastFilterOutputs;
+    // The allpass filters that do the phasing, up to AllpassCascade::maxStages per channel,
+    // with each channel's feedback loop
+    AllpassCascade filters;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PhaserProcessor)
 };
\ No newline at end of file
@@ -12,6 +12,22 @@ DelayEditor::DelayEditor (DelayProcessor& p)
     , labeledDryLevelKnob(DelayParameters::dryLevelName, dryLevelKnob)
     , wetLevelKnob(DelayParameters::wetLevelMin, DelayParameters::wetLevelMax, DelayParameters::wetLevelLabel)
     , labeledWetLevelKnob(DelayParameters::wetLevelName, wetLevelKnob)
+    , tapTimeKnob(DelayParameters::delayTimeMin, DelayParameters::delayTimeMax, DelayParameters::tapTimeLabel)
+    , labeledTapTimeKnob("Time", tapTimeKnob)
+    , tapLevelKnob(0.0f, 100.0f, DelayParameters::tapLevelLabel)
+    , labeledTapLevelKnob("Level", tapLevelKnob)
+    , tapPanKnob(-100.0f, 100.0f, DelayParameters::tapPanLabel)
+    , labeledTapPanKnob("Pan", tapPanKnob)
+    , tapFeedbackKnob(DelayParameters::feedbackMin, DelayParameters::feedbackMax, DelayParameters::tapFeedbackLabel)
+    , labeledTapFeedbackKnob("Feedback", tapFeedbackKnob)
+    , saturationKnob(DelayParameters::saturationMin, DelayParameters::saturationMax, DelayParameters::saturationLabel)
+    , labeledSaturationKnob(DelayParameters::saturationName, saturationKnob)
+    , lowCutKnob(DelayParameters::lowCutMin, DelayParameters::lowCutMax, DelayParameters::lowCutLabel)
+    , labeledLowCutKnob(DelayParameters::lowCutName, lowCutKnob)
+    , highCutKnob(DelayParameters::highCutMin, DelayParameters::highCutMax, DelayParameters::highCutLabel)
+    , labeledHighCutKnob(DelayParameters::highCutName, highCutKnob)
+    , wowFlutterKnob(DelayParameters::wowFlutterMin, DelayParameters::wowFlutterMax, DelayParameters::wowFlutterLabel)
+    , labeledWowFlutterKnob(DelayParameters::wowFlutterName, wowFlutterKnob)
 {
     setLookAndFeel(lookAndFeel);
 
@@ -27,40 +43,196 @@ DelayEditor::DelayEditor (DelayProcessor& p)
     wetLevelKnob.setDoubleClickReturnValue(true, double(DelayParameters::wetLevelDefault), ModifierKeys::noModifiers);
     addAndMakeVisible(labeledWetLevelKnob);
 
+    delayModeLabel.setText("Mode", dontSendNotification);
+    delayModeLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&delayModeLabel);
+    delayModeCombo.setEditableText(false);
+    delayModeCombo.setJustificationType(Justification::centredLeft);
+    MultiTapDelay::populateModeComboBox(delayModeCombo);
+    addAndMakeVisible(delayModeCombo);
+
+    timeSyncLabel.setText("Tempo Sync", dontSendNotification);
+    timeSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&timeSyncLabel);
+    timeSyncCombo.setEditableText(false);
+    timeSyncCombo.setJustificationType(Justification::centredLeft);
+    MultiTapDelay::populateSyncComboBox(timeSyncCombo);
+    addAndMakeVisible(timeSyncCombo);
+
+    timeChangeLabel.setText("Time Change", dontSendNotification);
+    timeChangeLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&timeChangeLabel);
+    timeChangeCombo.setEditableText(false);
+    timeChangeCombo.setJustificationType(Justification::centredLeft);
+    MultiTapDelay::populateTimeChangeComboBox(timeChangeCombo);
+    addAndMakeVisible(timeChangeCombo);
+
+    tapsGroup.setText("Taps");
+    addAndMakeVisible(&tapsGroup);
+
+    addAndMakeVisible(labeledTapTimeKnob);
+    addAndMakeVisible(labeledTapLevelKnob);
+    tapPanKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledTapPanKnob);
+    tapFeedbackKnob.setDoubleClickReturnValue(true, 0.0, ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledTapFeedbackKnob);
+
+    numTapsLabel.setText("Number of Taps", dontSendNotification);
+    numTapsLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&numTapsLabel);
+    numTapsCombo.setEditableText(false);
+    numTapsCombo.setJustificationType(Justification::centredLeft);
+    for (int i = 1; i <= DelayParameters::numTapsEnumCount; ++i)
+        numTapsCombo.addItem(String(i), i);
+    addAndMakeVisible(numTapsCombo);
+
+    tapSelectLabel.setText("Edit Tap", dontSendNotification);
+    tapSelectLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&tapSelectLabel);
+    tapSelectCombo.setEditableText(false);
+    tapSelectCombo.setJustificationType(Justification::centredLeft);
+    for (int i = 1; i <= DelayParameters::maxTaps; ++i)
+        tapSelectCombo.addItem(String(i), i);
+    tapSelectCombo.onChange = [this] { selectTap(tapSelectCombo.getSelectedItemIndex()); };
+    addAndMakeVisible(tapSelectCombo);
+
+    feedbackPathGroup.setText("Feedback Path");
+    addAndMakeVisible(&feedbackPathGroup);
+
+    saturationKnob.setDoubleClickReturnValue(true, double(DelayParameters::saturationDefault), ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledSaturationKnob);
+    lowCutKnob.setDoubleClickReturnValue(true, double(DelayParameters::lowCutDefault), ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledLowCutKnob);
+    highCutKnob.setDoubleClickReturnValue(true, double(DelayParameters::highCutDefault), ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledHighCutKnob);
+    wowFlutterKnob.setDoubleClickReturnValue(true, double(DelayParameters::wowFlutterDefault), ModifierKeys::noModifiers);
+    addAndMakeVisible(labeledWowFlutterKnob);
+
     processor.parameters.attachControls(
         delayTimeKnob,
         feedbackKnob,
         dryLevelKnob,
-        wetLevelKnob );
+        wetLevelKnob,
+        delayModeCombo,
+        timeSyncCombo,
+        timeChangeCombo,
+        numTapsCombo,
+        saturationKnob,
+        lowCutKnob,
+        highCutKnob,
+        wowFlutterKnob );
+    tapSelectCombo.setSelectedItemIndex(0, dontSendNotification);
+    selectTap(0);
 
-    setSize (60 + 100 * 4 + 10 * (4 - 1), 180);
+    // Keep the controls' enablement up to date with the mode, starting now
+    timerCallback();
+    startTimerHz(10);
+
+    setSize (60 + 100 * 4 + 10 * (4 - 1) + 15 + 250, 3 * 160 + 2 * 10 + 40);
 }
 
 DelayEditor::~DelayEditor()
 {
+    stopTimer();
     processor.parameters.detachControls();
     setLookAndFeel(nullptr);
 }
 
+void DelayEditor::selectTap(int tap)
+{
+    processor.parameters.attachTapControls(tap, tapTimeKnob, tapLevelKnob, tapPanKnob, tapFeedbackKnob);
+}
+
 void DelayEditor::resized()
 {
     auto bounds = getLocalBounds().reduced(20);
+    const int groupHeight = (bounds.getHeight() - 2 * 10) / 3;
+    auto feedbackPathBounds = bounds.removeFromBottom(groupHeight);
+    bounds.removeFromBottom(10);
+    auto tapsBounds = bounds.removeFromBottom(groupHeight);
+    bounds.removeFromBottom(10);
 
+    // Each group has four knobs on the left; the first two then have a column of labelled combo boxes
     mainGroup.setBounds(bounds);
     auto widgetsArea = bounds.reduced(10);
     widgetsArea.removeFromTop(20);
-    int width = (widgetsArea.getWidth() - (4 - 1) * 10) / 4;
-    labeledDelayTimeKnob.setBounds(widgetsArea.removeFromLeft(width));
+    int knobWidth = 100;
+    labeledDelayTimeKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledFeedbackKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledDryLevelKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledWetLevelKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(15);
+
+    widgetsArea.removeFromTop(6);
+    auto rowArea = widgetsArea.removeFromTop(24);
+    delayModeLabel.setBounds(rowArea.removeFromLeft(110));
+    rowArea.removeFromLeft(10);
+    delayModeCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
+    timeSyncLabel.setBounds(rowArea.removeFromLeft(110));
+    rowArea.removeFromLeft(10);
+    timeSyncCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
+    timeChangeLabel.setBounds(rowArea.removeFromLeft(110));
+    rowArea.removeFromLeft(10);
+    timeChangeCombo.setBounds(rowArea);
+
+    tapsGroup.setBounds(tapsBounds);
+    widgetsArea = tapsBounds.reduced(10);
+    widgetsArea.removeFromTop(20);
+    labeledTapTimeKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledTapLevelKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledTapPanKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(10);
+    labeledTapFeedbackKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
+    widgetsArea.removeFromLeft(15);
+
+    widgetsArea.removeFromTop(6);
+    rowArea = widgetsArea.removeFromTop(24);
+    numTapsLabel.setBounds(rowArea.removeFromLeft(110));
+    rowArea.removeFromLeft(10);
+    numTapsCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
+    tapSelectLabel.setBounds(rowArea.removeFromLeft(110));
+    rowArea.removeFromLeft(10);
+    tapSelectCombo.setBounds(rowArea);
+
+    feedbackPathGroup.setBounds(feedbackPathBounds);
+    widgetsArea = feedbackPathBounds.reduced(10);
+    widgetsArea.removeFromTop(20);
+    labeledSaturationKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
     widgetsArea.removeFromLeft(10);
-    labeledFeedbackKnob.setBounds(widgetsArea.removeFromLeft(width));
+    labeledLowCutKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
     widgetsArea.removeFromLeft(10);
-    labeledDryLevelKnob.setBounds(widgetsArea.removeFromLeft(width));
+    labeledHighCutKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
     widgetsArea.removeFromLeft(10);
-    labeledWetLevelKnob.setBounds(widgetsArea);
+    labeledWowFlutterKnob.setBounds(widgetsArea.removeFromLeft(knobWidth));
 }
 
 void DelayEditor::paint (Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll(lookAndFeel->findColour(ResizableWindow::backgroundColourId));
+}
+
+void DelayEditor::timerCallback()
+{
+    // The single delay's time and feedback, or the taps
+    const bool multiTap = processor.parameters.delayMode == MultiTapDelay::kModeMultiTap;
+    labeledDelayTimeKnob.setEnabled(!multiTap);
+    labeledFeedbackKnob.setEnabled(!multiTap);
+    labeledTapTimeKnob.setEnabled(multiTap);
+    labeledTapLevelKnob.setEnabled(multiTap);
+    labeledTapPanKnob.setEnabled(multiTap);
+    labeledTapFeedbackKnob.setEnabled(multiTap);
+    numTapsCombo.setEnabled(multiTap);
+    tapSelectCombo.setEnabled(multiTap);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "LabeledKnob.h"
 
 class DelayEditor  : public AudioProcessorEditor
+                   , protected Timer
 {
 public:
     DelayEditor (DelayProcessor&);
@@ -13,6 +14,10 @@ public:
     void paint (Graphics&) override;
     void resized() override;
 
+protected:
+    // Timer: polls the delay mode, to enable the controls which apply to it
+    void timerCallback() override;
+
 private:
     SharedResourcePointer<BasicLookAndFeel> lookAndFeel;
     DelayProcessor& processor;
@@ -23,6 +28,29 @@ private:
     BasicKnob feedbackKnob; LabeledKnob labeledFeedbackKnob;
     BasicKnob dryLevelKnob; LabeledKnob labeledDryLevelKnob;
     BasicKnob wetLevelKnob; LabeledKnob labeledWetLevelKnob;
+    ComboBox delayModeCombo; Label delayModeLabel;
+    ComboBox timeSyncCombo; Label timeSyncLabel;
+    ComboBox timeChangeCombo; Label timeChangeLabel;
+
+    // Multi-Tap mode: the knobs show whichever tap tapSelectCombo picks
+    GroupComponent tapsGroup;
+
+    BasicKnob tapTimeKnob; LabeledKnob labeledTapTimeKnob;
+    BasicKnob tapLevelKnob; LabeledKnob labeledTapLevelKnob;
+    BasicKnob tapPanKnob; LabeledKnob labeledTapPanKnob;
+    BasicKnob tapFeedbackKnob; LabeledKnob labeledTapFeedbackKnob;
+    ComboBox numTapsCombo; Label numTapsLabel;
+    ComboBox tapSelectCombo; Label tapSelectLabel;
+
+    // The stages in the feedback loop
+    GroupComponent feedbackPathGroup;
+
+    BasicKnob saturationKnob; LabeledKnob labeledSaturationKnob;
+    BasicKnob lowCutKnob; LabeledKnob labeledLowCutKnob;
+    BasicKnob highCutKnob; LabeledKnob labeledHighCutKnob;
+    BasicKnob wowFlutterKnob; LabeledKnob labeledWowFlutterKnob;
+
+    void selectTap(int tap);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayEditor)
 };
\ No newline at end of file
@@ -32,6 +32,112 @@ const float DelayParameters::wetLevelMin = 0.0f;
 const float DelayParameters::wetLevelMax = 100.0f;
 const float DelayParameters::wetLevelDefault = 50.0f;
 const float DelayParameters::wetLevelStep = 1.0f;
+// Delay Mode
+const String DelayParameters::delayModeID = "delayMode";
+const String DelayParameters::delayModeName = TRANS("Delay Mode");
+const String DelayParameters::delayModeLabel = "";
+const int DelayParameters::delayModeEnumCount = MultiTapDelay::kNumModes;
+const int DelayParameters::delayModeDefault = MultiTapDelay::kModeSingle;
+// Tempo Sync
+const String DelayParameters::timeSyncID = "timeSync";
+const String DelayParameters::timeSyncName = TRANS("Tempo Sync");
+const String DelayParameters::timeSyncLabel = "";
+const int DelayParameters::timeSyncEnumCount = MultiTapDelay::kNumSyncs;
+const int DelayParameters::timeSyncDefault = MultiTapDelay::kSyncOff;
+// Time Change
+const String DelayParameters::timeChangeID = "timeChange";
+const String DelayParameters::timeChangeName = TRANS("Time Change");
+const String DelayParameters::timeChangeLabel = "";
+const int DelayParameters::timeChangeEnumCount = MultiTapDelay::kNumTimeChanges;
+const int DelayParameters::timeChangeDefault = MultiTapDelay::kTimeChangeGlide;
+// Number of Taps
+const String DelayParameters::numTapsID = "numTaps";
+const String DelayParameters::numTapsName = TRANS("Number of Taps");
+const String DelayParameters::numTapsLabel = "";
+const int DelayParameters::numTapsEnumCount = MultiTapDelay::maxTaps;     // 1, 2, ... 16
+const int DelayParameters::numTapsDefault = 3;
+// Saturation
+const String DelayParameters::saturationID = "saturation";
+const String DelayParameters::saturationName = TRANS("Saturation");
+const String DelayParameters::saturationLabel = "%";
+const float DelayParameters::saturationMin = 0.0f;
+const float DelayParameters::saturationMax = 100.0f;
+const float DelayParameters::saturationDefault = 0.0f;
+const float DelayParameters::saturationStep = 1.0f;
+// Low Cut (off at the minimum)
+const String DelayParameters::lowCutID = "lowCut";
+const String DelayParameters::lowCutName = TRANS("Low Cut");
+const String DelayParameters::lowCutLabel = "Hz";
+const float DelayParameters::lowCutMin = 20.0f;
+const float DelayParameters::lowCutMax = 2000.0f;
+const float DelayParameters::lowCutDefault = 20.0f;
+const float DelayParameters::lowCutStep = 1.0f;
+// High Cut (off at the maximum)
+const String DelayParameters::highCutID = "highCut";
+const String DelayParameters::highCutName = TRANS("High Cut");
+const String DelayParameters::highCutLabel = "Hz";
+const float DelayParameters::highCutMin = 500.0f;
+const float DelayParameters::highCutMax = 20000.0f;
+const float DelayParameters::highCutDefault = 20000.0f;
+const float DelayParameters::highCutStep = 10.0f;
+// Wow & Flutter
+const String DelayParameters::wowFlutterID = "wowFlutter";
+const String DelayParameters::wowFlutterName = TRANS("Wow & Flutter");
+const String DelayParameters::wowFlutterLabel = "%";
+const float DelayParameters::wowFlutterMin = 0.0f;
+const float DelayParameters::wowFlutterMax = 100.0f;
+const float DelayParameters::wowFlutterDefault = 0.0f;
+const float DelayParameters::wowFlutterStep = 1.0f;
+// Tap Time, one of each per tap
+const String DelayParameters::tapTimeID[] = { "tap1Time", "tap2Time", "tap3Time", "tap4Time",
+                                              "tap5Time", "tap6Time", "tap7Time", "tap8Time",
+                                              "tap9Time", "tap10Time", "tap11Time", "tap12Time",
+                                              "tap13Time", "tap14Time", "tap15Time", "tap16Time" };
+const String DelayParameters::tapTimeName[] = { TRANS("Tap 1 Time"), TRANS("Tap 2 Time"), TRANS("Tap 3 Time"), TRANS("Tap 4 Time"),
+                                                TRANS("Tap 5 Time"), TRANS("Tap 6 Time"), TRANS("Tap 7 Time"), TRANS("Tap 8 Time"),
+                                                TRANS("Tap 9 Time"), TRANS("Tap 10 Time"), TRANS("Tap 11 Time"), TRANS("Tap 12 Time"),
+                                                TRANS("Tap 13 Time"), TRANS("Tap 14 Time"), TRANS("Tap 15 Time"), TRANS("Tap 16 Time") };
+const String DelayParameters::tapTimeLabel = "sec";
+// Tap Level, one of each per tap
+const String DelayParameters::tapLevelID[] = { "tap1Level", "tap2Level", "tap3Level", "tap4Level",
+                                               "tap5Level", "tap6Level", "tap7Level", "tap8Level",
+                                               "tap9Level", "tap10Level", "tap11Level", "tap12Level",
+                                               "tap13Level", "tap14Level", "tap15Level", "tap16Level" };
+const String DelayParameters::tapLevelName[] = { TRANS("Tap 1 Level"), TRANS("Tap 2 Level"), TRANS("Tap 3 Level"), TRANS("Tap 4 Level"),
+                                                 TRANS("Tap 5 Level"), TRANS("Tap 6 Level"), TRANS("Tap 7 Level"), TRANS("Tap 8 Level"),
+                                                 TRANS("Tap 9 Level"), TRANS("Tap 10 Level"), TRANS("Tap 11 Level"), TRANS("Tap 12 Level"),
+                                                 TRANS("Tap 13 Level"), TRANS("Tap 14 Level"), TRANS("Tap 15 Level"), TRANS("Tap 16 Level") };
+const String DelayParameters::tapLevelLabel = "%";
+// Tap Pan (percent left or right), one of each per tap
+const String DelayParameters::tapPanID[] = { "tap1Pan", "tap2Pan", "tap3Pan", "tap4Pan",
+                                             "tap5Pan", "tap6Pan", "tap7Pan", "tap8Pan",
+                                             "tap9Pan", "tap10Pan", "tap11Pan", "tap12Pan",
+                                             "tap13Pan", "tap14Pan", "tap15Pan", "tap16Pan" };
+const String DelayParameters::tapPanName[] = { TRANS("Tap 1 Pan"), TRANS("Tap 2 Pan"), TRANS("Tap 3 Pan"), TRANS("Tap 4 Pan"),
+                                               TRANS("Tap 5 Pan"), TRANS("Tap 6 Pan"), TRANS("Tap 7 Pan"), TRANS("Tap 8 Pan"),
+                                               TRANS("Tap 9 Pan"), TRANS("Tap 10 Pan"), TRANS("Tap 11 Pan"), TRANS("Tap 12 Pan"),
+                                               TRANS("Tap 13 Pan"), TRANS("Tap 14 Pan"), TRANS("Tap 15 Pan"), TRANS("Tap 16 Pan") };
+const String DelayParameters::tapPanLabel = "%";
+// Tap Feedback, one of each per tap
+const String DelayParameters::tapFeedbackID[] = { "tap1Feedback", "tap2Feedback", "tap3Feedback", "tap4Feedback",
+                                                  "tap5Feedback", "tap6Feedback", "tap7Feedback", "tap8Feedback",
+                                                  "tap9Feedback", "tap10Feedback", "tap11Feedback", "tap12Feedback",
+                                                  "tap13Feedback", "tap14Feedback", "tap15Feedback", "tap16Feedback" };
+const String DelayParameters::tapFeedbackName[] = { TRANS("Tap 1 Feedback"), TRANS("Tap 2 Feedback"), TRANS("Tap 3 Feedback"), TRANS("Tap 4 Feedback"),
+                                                    TRANS("Tap 5 Feedback"), TRANS("Tap 6 Feedback"), TRANS("Tap 7 Feedback"), TRANS("Tap 8 Feedback"),
+                                                    TRANS("Tap 9 Feedback"), TRANS("Tap 10 Feedback"), TRANS("Tap 11 Feedback"), TRANS("Tap 12 Feedback"),
+                                                    TRANS("Tap 13 Feedback"), TRANS("Tap 14 Feedback"), TRANS("Tap 15 Feedback"), TRANS("Tap 16 Feedback") };
+const String DelayParameters::tapFeedbackLabel = "%";
+
+namespace
+{
+    // Four taps, an eighth of a second apart and each a little quieter than the last, alternately
+    // left and right; the rest continue the pattern
+    float getDefaultTapTimeSec(int tap) { return 0.125f * (tap + 1); }
+    float getDefaultTapLevel(int tap) { return 100.0f - 6.0f * tap; }
+    float getDefaultTapPan(int tap) { return tap % 2 == 0 ? -50.0f : 50.0f; }
+    const float defaultTapFeedback = 0.0f;
+}
 
 AudioProcessorValueTreeState::ParameterLayout DelayParameters::createParameterLayout()
 {
@@ -65,32 +171,154 @@ AudioProcessorValueTreeState::ParameterLayout DelayParameters::createParameterLa
         AudioProcessorParameter::genericParameter,
         [](float value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        delayModeID, delayModeName,
+        0, delayModeEnumCount - 1, delayModeDefault,
+        delayModeLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        timeSyncID, timeSyncName,
+        0, timeSyncEnumCount - 1, timeSyncDefault,
+        timeSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        timeChangeID, timeChangeName,
+        0, timeChangeEnumCount - 1, timeChangeDefault,
+        timeChangeLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        numTapsID, numTapsName,
+        0, numTapsEnumCount - 1, numTapsDefault,
+        numTapsLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterFloat>(
+        saturationID, saturationName,
+        NormalisableRange<float>(saturationMin, saturationMax, saturationStep), saturationDefault,
+        saturationLabel,
+        AudioProcessorParameter::genericParameter,
+        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterFloat>(
+        lowCutID, lowCutName,
+        NormalisableRange<float>(lowCutMin, lowCutMax, lowCutStep), lowCutDefault,
+        lowCutLabel,
+        AudioProcessorParameter::genericParameter,
+        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterFloat>(
+        highCutID, highCutName,
+        NormalisableRange<float>(highCutMin, highCutMax, highCutStep), highCutDefault,
+        highCutLabel,
+        AudioProcessorParameter::genericParameter,
+        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getFloatValue(); }));
+    params.push_back(std::make_unique<AudioParameterFloat>(
+        wowFlutterID, wowFlutterName,
+        NormalisableRange<float>(wowFlutterMin, wowFlutterMax, wowFlutterStep), wowFlutterDefault,
+        wowFlutterLabel,
+        AudioProcessorParameter::genericParameter,
+        [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getFloatValue(); }));
+
+    // The taps' times have the same range as the single delay time, so the buffer is the same
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            tapTimeID[tap], tapTimeName[tap],
+            NormalisableRange<float>(delayTimeMin, delayTimeMax, 0.001f), getDefaultTapTimeSec(tap),
+            tapTimeLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            tapLevelID[tap], tapLevelName[tap],
+            NormalisableRange<float>(0.0f, 100.0f, 1.0f), getDefaultTapLevel(tap),
+            tapLevelLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            tapPanID[tap], tapPanName[tap],
+            NormalisableRange<float>(-100.0f, 100.0f, 1.0f), getDefaultTapPan(tap),
+            tapPanLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+        params.push_back(std::make_unique<AudioParameterFloat>(
+            tapFeedbackID[tap], tapFeedbackName[tap],
+            NormalisableRange<float>(feedbackMin, feedbackMax, feedbackStep), defaultTapFeedback,
+            tapFeedbackLabel,
+            AudioProcessorParameter::genericParameter,
+            [](float value, int maxLength) { return String(value).substring(0, maxLength); },
+            [](const String& text) { return text.getFloatValue(); }));
+    }
 
     return { params.begin(), params.end() };
 }
 
-DelayParameters::DelayParameters(AudioProcessorValueTreeState& vts,
-                                 AudioProcessorValueTreeState::Listener* processor)
+DelayParameters::DelayParameters(AudioProcessorValueTreeState& vts)
     : delaySec(delayTimeDefault)
-    , feedback(feedbackDefault)
-    , dryLevel(dryLevelDefault)
-    , wetLevel(wetLevelDefault)
+    , feedback(0.01f * feedbackDefault, 0.02f)
+    , dryLevel(0.01f * dryLevelDefault, 0.02f)
+    , wetLevel(0.01f * wetLevelDefault, 0.02f)
+    , delayMode(MultiTapDelay::Mode(delayModeDefault))
+    , timeSync(MultiTapDelay::Sync(timeSyncDefault))
+    , timeChange(MultiTapDelay::TimeChange(timeChangeDefault))
+    , numTaps(numTapsDefault + 1)
+    , saturation(0.01f * saturationDefault, 0.05f)
+    , lowCutHz(lowCutDefault, 0.05f, SmoothedParameter::kMultiplicative)
+    , highCutHz(highCutDefault, 0.05f, SmoothedParameter::kMultiplicative)
+    , wowFlutter(0.01f * wowFlutterDefault, 0.05f)
     , valueTreeState(vts)
-    , processorAsListener(processor)
     , delayTimeListener(delaySec)
     , feedbackListener(feedback, 0.01f)
     , dryLevelListener(dryLevel, 0.01f)
     , wetLevelListener(wetLevel, 0.01f)
+    , delayModeListener(delayMode)
+    , timeSyncListener(timeSync)
+    , timeChangeListener(timeChange)
+    , numTapsListener(numTaps, 1)
+    , saturationListener(saturation, 0.01f)
+    , lowCutListener(lowCutHz)
+    , highCutListener(highCutHz)
+    , wowFlutterListener(wowFlutter, 0.01f)
 {
     valueTreeState.addParameterListener(delayTimeID, &delayTimeListener);
     valueTreeState.addParameterListener(feedbackID, &feedbackListener);
     valueTreeState.addParameterListener(dryLevelID, &dryLevelListener);
     valueTreeState.addParameterListener(wetLevelID, &wetLevelListener);
-    valueTreeState.addParameterListener(delayTimeID, processorAsListener);
+    valueTreeState.addParameterListener(delayModeID, &delayModeListener);
+    valueTreeState.addParameterListener(timeSyncID, &timeSyncListener);
+    valueTreeState.addParameterListener(timeChangeID, &timeChangeListener);
+    valueTreeState.addParameterListener(numTapsID, &numTapsListener);
+    valueTreeState.addParameterListener(saturationID, &saturationListener);
+    valueTreeState.addParameterListener(lowCutID, &lowCutListener);
+    valueTreeState.addParameterListener(highCutID, &highCutListener);
+    valueTreeState.addParameterListener(wowFlutterID, &wowFlutterListener);
 
-    feedback *= 0.01f;
-    dryLevel *= 0.01f;
-    wetLevel *= 0.01f;
+    // Levels, pans and feedback are converted from percentages to fractions, here for the
+    // initial values, since the listeners aren't called until the values change
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        tapTimeSec[tap] = getDefaultTapTimeSec(tap);
+        tapLevel.add(new SmoothedParameter(0.01f * getDefaultTapLevel(tap), 0.02f));
+        tapPan.add(new SmoothedParameter(0.01f * getDefaultTapPan(tap), 0.02f));
+        tapFeedback.add(new SmoothedParameter(0.01f * defaultTapFeedback, 0.02f));
+
+        tapTimeListeners.add(new FloatListener(tapTimeSec[tap]));
+        tapLevelListeners.add(new SmoothedFloatListener(*tapLevel[tap], 0.01f));
+        tapPanListeners.add(new SmoothedFloatListener(*tapPan[tap], 0.01f));
+        tapFeedbackListeners.add(new SmoothedFloatListener(*tapFeedback[tap], 0.01f));
+
+        valueTreeState.addParameterListener(tapTimeID[tap], tapTimeListeners[tap]);
+        valueTreeState.addParameterListener(tapLevelID[tap], tapLevelListeners[tap]);
+        valueTreeState.addParameterListener(tapPanID[tap], tapPanListeners[tap]);
+        valueTreeState.addParameterListener(tapFeedbackID[tap], tapFeedbackListeners[tap]);
+    }
 }
 
 DelayParameters::~DelayParameters()
@@ -100,7 +328,38 @@ DelayParameters::~DelayParameters()
     valueTreeState.removeParameterListener(feedbackID, &feedbackListener);
     valueTreeState.removeParameterListener(dryLevelID, &dryLevelListener);
     valueTreeState.removeParameterListener(wetLevelID, &wetLevelListener);
-    valueTreeState.removeParameterListener(delayTimeID, processorAsListener);
+    valueTreeState.removeParameterListener(delayModeID, &delayModeListener);
+    valueTreeState.removeParameterListener(timeSyncID, &timeSyncListener);
+    valueTreeState.removeParameterListener(timeChangeID, &timeChangeListener);
+    valueTreeState.removeParameterListener(numTapsID, &numTapsListener);
+    valueTreeState.removeParameterListener(saturationID, &saturationListener);
+    valueTreeState.removeParameterListener(lowCutID, &lowCutListener);
+    valueTreeState.removeParameterListener(highCutID, &highCutListener);
+    valueTreeState.removeParameterListener(wowFlutterID, &wowFlutterListener);
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        valueTreeState.removeParameterListener(tapTimeID[tap], tapTimeListeners[tap]);
+        valueTreeState.removeParameterListener(tapLevelID[tap], tapLevelListeners[tap]);
+        valueTreeState.removeParameterListener(tapPanID[tap], tapPanListeners[tap]);
+        valueTreeState.removeParameterListener(tapFeedbackID[tap], tapFeedbackListeners[tap]);
+    }
+}
+
+void DelayParameters::prepare(double sampleRate, int maxSamplesPerBlock)
+{
+    feedback.prepare(sampleRate, maxSamplesPerBlock);
+    dryLevel.prepare(sampleRate, maxSamplesPerBlock);
+    wetLevel.prepare(sampleRate, maxSamplesPerBlock);
+    saturation.prepare(sampleRate, maxSamplesPerBlock);
+    lowCutHz.prepare(sampleRate, maxSamplesPerBlock);
+    highCutHz.prepare(sampleRate, maxSamplesPerBlock);
+    wowFlutter.prepare(sampleRate, maxSamplesPerBlock);
+    for (int tap = 0; tap < maxTaps; ++tap)
+    {
+        tapLevel[tap]->prepare(sampleRate, maxSamplesPerBlock);
+        tapPan[tap]->prepare(sampleRate, maxSamplesPerBlock);
+        tapFeedback[tap]->prepare(sampleRate, maxSamplesPerBlock);
+    }
 }
 
 void DelayParameters::detachControls()
@@ -109,13 +368,30 @@ void DelayParameters::detachControls()
     feedbackAttachment.reset(nullptr);
     dryLevelAttachment.reset(nullptr);
     wetLevelAttachment.reset(nullptr);
+    delayModeAttachment.reset(nullptr);
+    timeSyncAttachment.reset(nullptr);
+    timeChangeAttachment.reset(nullptr);
+    numTapsAttachment.reset(nullptr);
+    saturationAttachment.reset(nullptr);
+    lowCutAttachment.reset(nullptr);
+    highCutAttachment.reset(nullptr);
+    wowFlutterAttachment.reset(nullptr);
+    detachTapControls();
 }
 
 void DelayParameters::attachControls(
     Slider& delayTimeKnob,
     Slider& feedbackKnob,
     Slider& dryLevelKnob,
-    Slider& wetLevelKnob )
+    Slider& wetLevelKnob,
+    ComboBox& delayModeCombo,
+    ComboBox& timeSyncCombo,
+    ComboBox& timeChangeCombo,
+    ComboBox& numTapsCombo,
+    Slider& saturationKnob,
+    Slider& lowCutKnob,
+    Slider& highCutKnob,
+    Slider& wowFlutterKnob )
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
     using SlAt = AudioProcessorValueTreeState::SliderAttachment;
@@ -123,4 +399,35 @@ void DelayParameters::attachControls(
     feedbackAttachment.reset(new SlAt(valueTreeState, feedbackID, feedbackKnob));
     dryLevelAttachment.reset(new SlAt(valueTreeState, dryLevelID, dryLevelKnob));
     wetLevelAttachment.reset(new SlAt(valueTreeState, wetLevelID, wetLevelKnob));
+    delayModeAttachment.reset(new CbAt(valueTreeState, delayModeID, delayModeCombo));
+    timeSyncAttachment.reset(new CbAt(valueTreeState, timeSyncID, timeSyncCombo));
+    timeChangeAttachment.reset(new CbAt(valueTreeState, timeChangeID, timeChangeCombo));
+    numTapsAttachment.reset(new CbAt(valueTreeState, numTapsID, numTapsCombo));
+    saturationAttachment.reset(new SlAt(valueTreeState, saturationID, saturationKnob));
+    lowCutAttachment.reset(new SlAt(valueTreeState, lowCutID, lowCutKnob));
+    highCutAttachment.reset(new SlAt(valueTreeState, highCutID, highCutKnob));
+    wowFlutterAttachment.reset(new SlAt(valueTreeState, wowFlutterID, wowFlutterKnob));
+}
+
+void DelayParameters::detachTapControls()
+{
+    tapTimeAttachment.reset(nullptr);
+    tapLevelAttachment.reset(nullptr);
+    tapPanAttachment.reset(nullptr);
+    tapFeedbackAttachment.reset(nullptr);
+}
+
+void DelayParameters::attachTapControls(
+    int tap,
+    Slider& tapTimeKnob,
+    Slider& tapLevelKnob,
+    Slider& tapPanKnob,
+    Slider& tapFeedbackKnob )
+{
+    using SlAt = AudioProcessorValueTreeState::SliderAttachment;
+    detachTapControls();
+    tapTimeAttachment.reset(new SlAt(valueTreeState, tapTimeID[tap], tapTimeKnob));
+    tapLevelAttachment.reset(new SlAt(valueTreeState, tapLevelID[tap], tapLevelKnob));
+    tapPanAttachment.reset(new SlAt(valueTreeState, tapPanID[tap], tapPanKnob));
+    tapFeedbackAttachment.reset(new SlAt(valueTreeState, tapFeedbackID[tap], tapFeedbackKnob));
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
+#include "MultiTapDelay.h"
 
 class DelayParameters
 {
@@ -15,42 +16,120 @@ public:
     static const float dryLevelMin, dryLevelMax, dryLevelDefault, dryLevelStep;
     static const String wetLevelID, wetLevelName, wetLevelLabel;
     static const float wetLevelMin, wetLevelMax, wetLevelDefault, wetLevelStep;
+    static const String delayModeID, delayModeName, delayModeLabel;
+    static const int delayModeEnumCount, delayModeDefault;
+    static const String timeSyncID, timeSyncName, timeSyncLabel;
+    static const int timeSyncEnumCount, timeSyncDefault;
+    static const String timeChangeID, timeChangeName, timeChangeLabel;
+    static const int timeChangeEnumCount, timeChangeDefault;
+    static const String numTapsID, numTapsName, numTapsLabel;
+    static const int numTapsEnumCount, numTapsDefault;
+    static const String saturationID, saturationName, saturationLabel;
+    static const float saturationMin, saturationMax, saturationDefault, saturationStep;
+    static const String lowCutID, lowCutName, lowCutLabel;
+    static const float lowCutMin, lowCutMax, lowCutDefault, lowCutStep;
+    static const String highCutID, highCutName, highCutLabel;
+    static const float highCutMin, highCutMax, highCutDefault, highCutStep;
+    static const String wowFlutterID, wowFlutterName, wowFlutterLabel;
+    static const float wowFlutterMin, wowFlutterMax, wowFlutterDefault, wowFlutterStep;
+    // One of each per tap
+    static const int maxTaps = MultiTapDelay::maxTaps;
+    static const String tapTimeID[maxTaps], tapTimeName[maxTaps], tapTimeLabel;
+    static const String tapLevelID[maxTaps], tapLevelName[maxTaps], tapLevelLabel;
+    static const String tapPanID[maxTaps], tapPanName[maxTaps], tapPanLabel;
+    static const String tapFeedbackID[maxTaps], tapFeedbackName[maxTaps], tapFeedbackLabel;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 public:
-    DelayParameters(AudioProcessorValueTreeState& vts,
-                    AudioProcessorValueTreeState::Listener* processor);
+    DelayParameters(AudioProcessorValueTreeState& vts);
     ~DelayParameters();
 
+    // Prepare all the smoothed parameters
+    void prepare(double sampleRate, int maxSamplesPerBlock);
+
     void detachControls();
     void attachControls(
         Slider& delayTimeKnob,
         Slider& feedbackKnob,
         Slider& dryLevelKnob,
-        Slider& wetLevelKnob );
+        Slider& wetLevelKnob,
+        ComboBox& delayModeCombo,
+        ComboBox& timeSyncCombo,
+        ComboBox& timeChangeCombo,
+        ComboBox& numTapsCombo,
+        Slider& saturationKnob,
+        Slider& lowCutKnob,
+        Slider& highCutKnob,
+        Slider& wowFlutterKnob );
+
+    // The editor shows one tap's controls at a time
+    void detachTapControls();
+    void attachTapControls(
+        int tap,
+        Slider& tapTimeKnob,
+        Slider& tapLevelKnob,
+        Slider& tapPanKnob,
+        Slider& tapFeedbackKnob );
 
     // working parameter values
     float delaySec;
-    float feedback;
-    float dryLevel;
-    float wetLevel;
+    SmoothedParameter feedback;
+    SmoothedParameter dryLevel;
+    SmoothedParameter wetLevel;
+    MultiTapDelay::Mode delayMode;
+    MultiTapDelay::Sync timeSync;
+    MultiTapDelay::TimeChange timeChange;
+    int numTaps;
+
+    // working parameter values for the feedback path; each stage is off at the end of its range
+    SmoothedParameter saturation;
+    SmoothedParameter lowCutHz;
+    SmoothedParameter highCutHz;
+    SmoothedParameter wowFlutter;
+
+    // working parameter values, one per tap (pans are -1 to +1)
+    float tapTimeSec[maxTaps];
+    OwnedArray<SmoothedParameter> tapLevel;
+    OwnedArray<SmoothedParameter> tapPan;
+    OwnedArray<SmoothedParameter> tapFeedback;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
     AudioProcessorValueTreeState& valueTreeState;
 
-    // Pointer to processor as an AudioProcessorValueTreeState::Listener
-    AudioProcessorValueTreeState::Listener* processorAsListener;
-
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> delayTimeAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> feedbackAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> dryLevelAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> wetLevelAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> delayModeAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> timeSyncAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> timeChangeAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> numTapsAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> saturationAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lowCutAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> highCutAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> wowFlutterAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> tapTimeAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> tapLevelAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> tapPanAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> tapFeedbackAttachment;
 
     // Listener objects link parameters to working variables
     FloatListener delayTimeListener;
-    FloatListener feedbackListener;
-    FloatListener dryLevelListener;
-    FloatListener wetLevelListener;
+    SmoothedFloatListener feedbackListener;
+    SmoothedFloatListener dryLevelListener;
+    SmoothedFloatListener wetLevelListener;
+    EnumListener<MultiTapDelay::Mode> delayModeListener;
+    EnumListener<MultiTapDelay::Sync> timeSyncListener;
+    EnumListener<MultiTapDelay::TimeChange> timeChangeListener;
+    IntegerListener numTapsListener;
+    SmoothedFloatListener saturationListener;
+    SmoothedFloatListener lowCutListener;
+    SmoothedFloatListener highCutListener;
+    SmoothedFloatListener wowFlutterListener;
+    OwnedArray<FloatListener> tapTimeListeners;
+    OwnedArray<SmoothedFloatListener> tapLevelListeners;
+    OwnedArray<SmoothedFloatListener> tapPanListeners;
+    OwnedArray<SmoothedFloatListener> tapFeedbackListeners;
 };
\ No newline at end of file
@@ -20,9 +20,8 @@ DelayProcessor::DelayProcessor()
                      .withOutput ("Output", AudioChannelSet::stereo(), true)
                      )
     , valueTreeState(*this, nullptr, Identifier("Delay"), DelayParameters::createParameterLayout())
-    , parameters(valueTreeState, this)
-    , delayReadPosition(0)
-    , delayWritePosition(0)
+    , parameters(valueTreeState)
+    , hostBpm(0.0)
 {
 }
 
@@ -31,27 +30,17 @@ DelayProcessor::~DelayProcessor()
 {
 }
 
-void DelayProcessor::parameterChanged(const String&, float)
-{
-    delayReadPosition = (int)(delayWritePosition - (parameters.delaySec * getSampleRate())
-                                                 + delayBufferLength) % delayBufferLength;
-}
-
 // Prepare to process audio (always called at least once before processBlock)
-void DelayProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void DelayProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
-    // Allocate and zero the delay buffer (size will depend on current sample rate)
-    // Sanity check the result so we don't end up with any zero-length calculations
-    delayBufferLength = (int)(2.0*sampleRate);
-    if (delayBufferLength < 1) delayBufferLength = 1;
-    delayBuffer.setSize(2, delayBufferLength);
-    delayBuffer.clear();
-
-    // This method gives us the sample rate. Use this to figure out what the delay position
-    // offset should be (since it is specified in seconds, and we need to convert it to a number
-    // of samples)
-    delayReadPosition = (int)(delayWritePosition - (parameters.delaySec * getSampleRate())
-                                                 + delayBufferLength) % delayBufferLength;
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
+    // Allocate and zero the delay buffer (size will depend on current sample rate), long enough
+    // for the longest time any tap can be set to
+    delay.prepare(getTotalNumInputChannels(), sampleRate, DelayParameters::delayTimeMax, maxSamplesPerBlock);
+
+    parameters.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -61,6 +50,17 @@ void DelayProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void DelayProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo at the start of each block
+    AudioPlayHead::CurrentPositionInfo position;
+    AudioPlayHead* playHead = getPlayHead();
+    hostBpm = (playHead != nullptr && playHead->getCurrentPosition(position)) ? position.bpm : 0.0;
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void DelayProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -69,53 +69,68 @@ void DelayProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     const int numOutputChannels = getTotalNumOutputChannels();  // How many output channels for our effect?
     const int numSamples = buffer.getNumSamples();              // How many samples in the buffer for this block?
 
-    int channel, dpr, dpw; // dpr = delay read pointer; dpw = delay write pointer
-
-    // Go through each channel of audio that's passed in. In this example we apply identical
-    // effects to each channel, regardless of how many input channels there are. For some effects, like
-    // a stereo chorus or panner, you might do something different for each channel.
-    for (channel = 0; channel < numInputChannels; ++channel)
+    // Smoothed parameter values, for every sample of this block
+    const float* feedback = parameters.feedback.getNextBlock(numSamples);
+    const float* dryLevel = parameters.dryLevel.getNextBlock(numSamples);
+    const float* wetLevel = parameters.wetLevel.getNextBlock(numSamples);
+
+    // Each tap's time in samples (rounded to the tempo, if synced), and its levels. In Single
+    // mode, the original delay is one tap, at full level, in the centre.
+    const double sampleRate = getSampleRate();
+    MultiTapDelay::Settings settings;
+    settings.timeChange = parameters.timeChange;
+    settings.dryLevel = dryLevel;
+    settings.wetLevel = wetLevel;
+    settings.isSteady = parameters.dryLevel.isSteady() && parameters.wetLevel.isSteady();
+    if (parameters.delayMode == MultiTapDelay::kModeMultiTap)
     {
-        // channelData is an array of length numSamples which contains the audio for one channel
-        float* channelData = buffer.getWritePointer(channel);
-
-        // delayData is the circular buffer for implementing delay on this channel
-        float* delayData = delayBuffer.getWritePointer(jmin(channel, delayBuffer.getNumChannels() - 1));
-
-        // Make a temporary copy of any state variables declared in PluginProcessor.h which need to be
-        // maintained between calls to processBlock(). Each channel needs to be processed identically
-        // which means that the activity of processing one channel can't affect the state variable for
-        // the next channel.
-        dpr = delayReadPosition;
-        dpw = delayWritePosition;
-
-        for (int i = 0; i < numSamples; ++i)
+        settings.numTaps = parameters.numTaps;
+        for (int tap = 0; tap < settings.numTaps; ++tap)
         {
-            const float in = channelData[i];
-            float out = 0.0;
-
-            // In this example, the output is the input plus the contents of the delay buffer (weighted by delayMix)
-            // The last term implements a tremolo (variable amplitude) on the whole thing.
-
-            out = (parameters.dryLevel * in + parameters.wetLevel * delayData[dpr]);
-
-            // Store the current information in the delay buffer. delayData[dpr] is the delay sample we just read,
-            // i.e. what came out of the buffer. delayData[dpw] is what we write to the buffer, i.e. what goes in
-
-            delayData[dpw] = in + (delayData[dpr] * parameters.feedback);
-
-            if (++dpr >= delayBufferLength) dpr = 0;
-            if (++dpw >= delayBufferLength) dpw = 0;
-
-            // Store the output sample in the buffer, replacing the input
-            channelData[i] = out;
+            MultiTapDelay::Tap& t = settings.taps[tap];
+            t.delaySamples = MultiTapDelay::getDelaySamples(parameters.tapTimeSec[tap], parameters.timeSync,
+                                                            hostBpm, sampleRate, delay.getMaxDelaySamples());
+            t.level = parameters.tapLevel[tap]->getNextBlock(numSamples);
+            t.pan = parameters.tapPan[tap]->getNextBlock(numSamples);
+            t.feedback = parameters.tapFeedback[tap]->getNextBlock(numSamples);
+            settings.isSteady = settings.isSteady && parameters.tapLevel[tap]->isSteady()
+                && parameters.tapPan[tap]->isSteady() && parameters.tapFeedback[tap]->isSteady();
         }
     }
+    else
+    {
+        settings.numTaps = 1;
+        MultiTapDelay::Tap& t = settings.taps[0];
+        t.delaySamples = MultiTapDelay::getDelaySamples(parameters.delaySec, parameters.timeSync,
+                                                        hostBpm, sampleRate, delay.getMaxDelaySamples());
+        t.level = nullptr;
+        t.pan = nullptr;
+        t.feedback = feedback;
+        settings.isSteady = settings.isSteady && parameters.feedback.isSteady();
+    }
 
-    // Having made a local copy of the state variables for each channel, now transfer the result
-    // back to the main state variable so they will be preserved for the next call of processBlock()
-    delayReadPosition = dpr;
-    delayWritePosition = dpw;
+    // The feedback path's stages, each off at the end of its range, as is wow and flutter,
+    // once its depth has settled at zero. The stages take where their settings will be at the
+    // end of the block, and the delay ramps its coefficients there, across the block.
+    parameters.saturation.getNextBlock(numSamples);
+    parameters.lowCutHz.getNextBlock(numSamples);
+    parameters.highCutHz.getNextBlock(numSamples);
+    const float lowCutHz = parameters.lowCutHz.getCurrentValue();
+    const float highCutHz = parameters.highCutHz.getCurrentValue();
+    const float* wowFlutter = parameters.wowFlutter.getNextBlock(numSamples);
+    MultiTapDelay::FeedbackPath& path = settings.feedbackPath;
+    path.saturation = parameters.saturation.getCurrentValue();
+    path.lowCutHz = lowCutHz > DelayParameters::lowCutMin ? lowCutHz : 0.0f;
+    path.highCutHz = highCutHz < DelayParameters::highCutMax ? highCutHz : 0.0f;
+    const bool wowFlutterOff = parameters.wowFlutter.isSteady() && parameters.wowFlutter.getCurrentValue() == 0.0f;
+    path.wowFlutter = wowFlutterOff ? nullptr : wowFlutter;
+
+    // Go through each channel of audio that's passed in, all with the same taps. The output is
+    // the input plus the taps' outputs; what goes into the buffer is the input plus some of
+    // each tap's output (the feedback). While nothing is ramping or moving, this is done a
+    // whole tap at a time, rather than a sample at a time (see MultiTapDelay.h).
+    int numChannels = jmin(numInputChannels, delay.getNumChannels());   // should be the same
+    delay.processSamples(buffer.getArrayOfWritePointers(), numChannels, numSamples, settings);
 
     // In case we have more outputs than inputs, we'll clear any output
     // channels that didn't contain input data, (because these aren't
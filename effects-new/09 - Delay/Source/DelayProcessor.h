@@ -1,9 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "DelayParameters.h"
+#include "MultiTapDelay.h"
+#include "AutomationScheduler.h"
 
 class DelayProcessor    : public AudioProcessor
-                        , public AudioProcessorValueTreeState::Listener
+                        , public AutomationScheduler::Owner
 {
 public:
     DelayProcessor();
@@ -30,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -41,14 +46,16 @@ public:
     // Application's view of the AudioProcessorValueTreeState, including working parameter values
     DelayParameters parameters;
 
-    // Responding to parameter changes
-    void parameterChanged(const String&, float) override;
-
 private:
-    // Circular buffer variables for implementing delay
-    AudioSampleBuffer delayBuffer;
-    int delayBufferLength;
-    int delayReadPosition, delayWritePosition;
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // The delay buffer and its taps (one, in Single mode)
+    MultiTapDelay delay;
+
+    // The host's tempo at the start of the current block, or 0 if it isn't known
+    double hostBpm;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,526 @@
+#include "MultiTapDelay.h"
+
+const float MultiTapDelay::glideTimeSec = 0.1f;
+const float MultiTapDelay::maxGlideRate = 0.5f;
+const float MultiTapDelay::crossfadeSec = 0.05f;
+const float MultiTapDelay::wowFreqHz = 0.6f;
+const float MultiTapDelay::wowDepthSec = 0.002f;
+const float MultiTapDelay::flutterFreqHz = 7.3f;
+const float MultiTapDelay::flutterDepthSec = 0.0001f;
+const float MultiTapDelay::maxDrive = 5.0f;
+const float MultiTapDelay::minDrive = 0.01f;
+
+namespace
+{
+    // Quarter notes in each sync setting's note value
+    const double quarterNotes[MultiTapDelay::kNumSyncs] =
+        { 0.0, 0.125, 1.0 / 6.0, 0.25, 1.0 / 3.0, 0.5, 0.75, 1.0, 1.5, 2.0 };
+
+    // The taps' feedback, all together, is scaled back to this if need be, so however the taps
+    // are set, the loop gain stays below 1 and the echoes always die away
+    const float maxTotalFeedback = 0.995f;
+
+    // A smooth clipper: a Pade approximation to tanh(), which reaches exactly +/-1, with zero
+    // slope, at x = +/-3, and has a slope of 1 at 0
+    inline float softClip(float x) noexcept
+    {
+        x = jlimit(-3.0f, 3.0f, x);
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    // The gain G of a TPT one-pole filter with the given cutoff
+    float getOnePoleGain(float cutoffHz, double sampleRate) noexcept
+    {
+        const double g = std::tan(MathConstants<double>::pi * jmin(double(cutoffHz), 0.45 * sampleRate) / sampleRate);
+        return float(g / (1.0 + g));
+    }
+}
+
+void MultiTapDelay::populateModeComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Single", ++itemNumber);
+    cb.addItem("Multi-Tap", ++itemNumber);
+}
+
+void MultiTapDelay::populateTimeChangeComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Glide", ++itemNumber);
+    cb.addItem("Crossfade", ++itemNumber);
+}
+
+void MultiTapDelay::populateSyncComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Off", ++itemNumber);
+    cb.addItem("1/32", ++itemNumber);
+    cb.addItem("1/16T", ++itemNumber);
+    cb.addItem("1/16", ++itemNumber);
+    cb.addItem("1/8T", ++itemNumber);
+    cb.addItem("1/8", ++itemNumber);
+    cb.addItem("1/8D", ++itemNumber);
+    cb.addItem("1/4", ++itemNumber);
+    cb.addItem("1/4D", ++itemNumber);
+    cb.addItem("1/2", ++itemNumber);
+}
+
+float MultiTapDelay::getDelaySamples(float timeSec, Sync sync, double bpm, double sampleRate,
+                                     float maxDelaySamples) noexcept
+{
+    double delaySamples = timeSec * sampleRate;
+    if (sync != kSyncOff && bpm > 0.0)
+    {
+        // The nearest whole number of note values, or if that is too long, the most that fit
+        const double noteSamples = quarterNotes[sync] * 60.0 / bpm * sampleRate;
+        double notes = jmax(1.0, std::round(delaySamples / noteSamples));
+        if (notes * noteSamples > maxDelaySamples)
+            notes = std::floor(maxDelaySamples / noteSamples);
+        if (notes >= 1.0)
+            delaySamples = notes * noteSamples;
+    }
+    return jlimit(float(DelayInterpolation::minDelaySamples), maxDelaySamples, float(delaySamples));
+}
+
+MultiTapDelay::MultiTapDelay()
+    : sampleRate(44100.0)
+    , maxDelaySamples(float(DelayInterpolation::minDelaySamples))
+    , maxModulationSamples(0.0f)
+    , glideCoefficient(1.0f)
+    , fadeSamples(1)
+    , maxBlockSize(0)
+    , coefficientsAreSet(false)
+    , coefficientsAreMoving(false)
+    , isModulating(false)
+{
+    // Every stage starts where it does nothing
+    stageCoefficients.lowCutGain = 0.0f;
+    stageCoefficients.highCutGain = 1.0f;
+    stageCoefficients.drive = minDrive;
+    stageCoefficients.inverseDrive = 1.0f / minDrive;
+    targetCoefficients = stageCoefficients;
+
+    for (auto& state : tapStates)
+    {
+        state.delaySamples = state.previousDelaySamples = 0.0f;
+        state.fadeSamplesDone = fadeSamples;
+        state.isSet = false;
+    }
+}
+
+void MultiTapDelay::prepare(int numChannels, double newSampleRate, float maxDelaySec, int maxSamplesPerBlock)
+{
+    // Wow and flutter can read a little further back than the longest delay
+    sampleRate = newSampleRate;
+    maxDelaySamples = float(maxDelaySec * sampleRate);
+    maxModulationSamples = float((wowDepthSec + flutterDepthSec) * sampleRate);
+    delayLine.prepare(numChannels, int(std::ceil(maxDelaySamples + maxModulationSamples)) + 1, maxSamplesPerBlock);
+
+    glideCoefficient = float(1.0 / (glideTimeSec * sampleRate));
+    fadeSamples = jmax(1, roundToInt(crossfadeSec * sampleRate));
+
+    maxBlockSize = maxSamplesPerBlock;
+    tapDelays.allocate(size_t(maxTaps * maxBlockSize), true);
+    previousTapDelays.allocate(size_t(maxTaps * maxBlockSize), true);
+    newTapGains.allocate(size_t(maxTaps * maxBlockSize), true);
+    oldTapGains.allocate(size_t(maxTaps * maxBlockSize), true);
+    feedbackScale.allocate(size_t(maxBlockSize), true);
+    tapOutput.allocate(size_t(maxBlockSize), true);
+    wetSum.allocate(size_t(maxBlockSize), true);
+    feedbackSum.allocate(size_t(maxBlockSize), true);
+
+    filterStates.allocate(size_t(delayLine.getNumChannels()), true);
+    wowLFO.prepare(sampleRate, maxBlockSize);
+    flutterLFO.prepare(sampleRate, maxBlockSize);
+    modulation.allocate(size_t(maxBlockSize), true);
+
+    reset();
+}
+
+void MultiTapDelay::reset()
+{
+    delayLine.clear();
+    for (auto& state : tapStates)
+    {
+        state.delaySamples = state.previousDelaySamples = 0.0f;
+        state.fadeSamplesDone = fadeSamples;
+        state.isSet = false;
+    }
+
+    for (int channel = 0; channel < delayLine.getNumChannels(); ++channel)
+        filterStates[channel].lowCut = filterStates[channel].highCut = 0.0f;
+    coefficientsAreSet = false;
+
+    // The two wobbles start out of step, so they don't line up at the start of every cycle
+    wowLFO.reset();
+    flutterLFO.reset(0.25f);
+}
+
+void MultiTapDelay::planTap(TapState& state, float targetDelaySamples, TimeChange timeChange, int numSamples,
+                            float* delays, float* previousDelays, float* newGains, float* oldGains) noexcept
+{
+    if (!state.isSet)
+    {
+        state.delaySamples = targetDelaySamples;
+        state.fadeSamplesDone = fadeSamples;
+        state.isSet = true;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // A crossfade, once started, always finishes, before the tap heads for a newer target
+        if (state.fadeSamplesDone >= fadeSamples && state.delaySamples != targetDelaySamples)
+        {
+            if (timeChange == kTimeChangeCrossfade)
+            {
+                state.previousDelaySamples = state.delaySamples;
+                state.delaySamples = targetDelaySamples;
+                state.fadeSamplesDone = 0;
+            }
+            else
+            {
+                // Glide: approach the target exponentially, but no faster than maxGlideRate
+                const float step = glideCoefficient * (targetDelaySamples - state.delaySamples);
+                state.delaySamples += jlimit(-maxGlideRate, maxGlideRate, step);
+                if (std::abs(targetDelaySamples - state.delaySamples) < 0.001f)
+                    state.delaySamples = targetDelaySamples;
+            }
+        }
+
+        delays[i] = state.delaySamples;
+        previousDelays[i] = state.previousDelaySamples;
+        if (state.fadeSamplesDone < fadeSamples)
+        {
+            // Linear, so the faded signal is never louder than the louder of the two, and the
+            // feedback loop can't gain anything while a tap is crossfading
+            const float x = (float(state.fadeSamplesDone) + 0.5f) / float(fadeSamples);
+            newGains[i] = x;
+            oldGains[i] = 1.0f - x;
+            ++state.fadeSamplesDone;
+        }
+        else
+        {
+            newGains[i] = 1.0f;
+            oldGains[i] = 0.0f;
+        }
+    }
+}
+
+bool MultiTapDelay::tapsAreSettled(const Settings& settings, int numTaps) const noexcept
+{
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const TapState& state = tapStates[tap];
+        if (!state.isSet || state.fadeSamplesDone < fadeSamples
+            || state.delaySamples != settings.taps[tap].delaySamples)
+            return false;
+    }
+    return true;
+}
+
+int MultiTapDelay::prepareFeedbackPath(const FeedbackPath& path, int numSamples) noexcept
+{
+    // Where the coefficients should be by the end of the block. A stage which is off is set
+    // where it does nothing: a low cut gain of 0 and a high cut gain of 1 pass everything,
+    // and at minDrive, the soft clipper is all but a straight line.
+    StageCoefficients& target = targetCoefficients;
+    target.drive = jmax(minDrive, maxDrive * path.saturation);
+    target.inverseDrive = 1.0f / target.drive;
+    target.lowCutGain = path.lowCutHz > 0.0f ? getOnePoleGain(path.lowCutHz, sampleRate) : 0.0f;
+    target.highCutGain = path.highCutHz > 0.0f ? getOnePoleGain(path.highCutHz, sampleRate) : 1.0f;
+
+    // After reset() they go straight there; otherwise they ramp there across the block
+    if (!coefficientsAreSet)
+    {
+        stageCoefficients = target;
+        coefficientsAreSet = true;
+    }
+    coefficientsAreMoving = stageCoefficients.drive != target.drive
+        || stageCoefficients.lowCutGain != target.lowCutGain
+        || stageCoefficients.highCutGain != target.highCutGain;
+
+    // A stage is on while it does anything at either end of the ramp
+    int stages = 0;
+    if (stageCoefficients.drive > minDrive || target.drive > minDrive)
+        stages |= kStageSaturation;
+    if (stageCoefficients.lowCutGain > 0.0f || target.lowCutGain > 0.0f)
+        stages |= kStageLowCut;
+    if (stageCoefficients.highCutGain < 1.0f || target.highCutGain < 1.0f)
+        stages |= kStageHighCut;
+
+    // Filters which are off start from silence when they come back on
+    for (int channel = 0; channel < delayLine.getNumChannels(); ++channel)
+    {
+        if ((stages & kStageLowCut) == 0) filterStates[channel].lowCut = 0.0f;
+        if ((stages & kStageHighCut) == 0) filterStates[channel].highCut = 0.0f;
+    }
+
+    // Wow and flutter: how far each sample's read positions move, the same for every tap
+    isModulating = path.wowFlutter != nullptr;
+    if (isModulating)
+    {
+        wowLFO.advance(numSamples, wowFreqHz);
+        flutterLFO.advance(numSamples, flutterFreqHz);
+        const float* wow = wowLFO.render(0, BlockLFO::kWaveformSine, numSamples);
+        const float* flutter = flutterLFO.render(0, BlockLFO::kWaveformSine, numSamples);
+        const float wowDepth = float(wowDepthSec * sampleRate);
+        const float flutterDepth = float(flutterDepthSec * sampleRate);
+        for (int i = 0; i < numSamples; ++i)
+            modulation[i] = path.wowFlutter[i] * (wowDepth * (2.0f * wow[i] - 1.0f)
+                                                  + flutterDepth * (2.0f * flutter[i] - 1.0f));
+    }
+
+    return stages;
+}
+
+template <int stages>
+inline float MultiTapDelay::shapeFeedback(float x, FilterState& state, const StageCoefficients& c) noexcept
+{
+    // Saturation first, so the filters take the edge off what it adds
+    if (stages & kStageSaturation)
+        x = softClip(c.drive * x) * c.inverseDrive;
+
+    // Each filter is a TPT one-pole lowpass; the low cut keeps what its lowpass takes out
+    if (stages & kStageLowCut)
+    {
+        const float v = c.lowCutGain * (x - state.lowCut);
+        const float lowpass = v + state.lowCut;
+        state.lowCut = lowpass + v;
+        x -= lowpass;
+    }
+    if (stages & kStageHighCut)
+    {
+        const float v = c.highCutGain * (x - state.highCut);
+        const float lowpass = v + state.highCut;
+        state.highCut = lowpass + v;
+        x = lowpass;
+    }
+    return x;
+}
+
+void MultiTapDelay::processSamples(float* const* channelData, int numChannels, int numSamples,
+                                   const Settings& settings) noexcept
+{
+    jassert(numSamples <= maxBlockSize);
+    const int numTaps = jlimit(0, int(maxTaps), settings.numTaps);
+
+    // processBlock() is compiled for each combination of stages without any switches
+    switch (prepareFeedbackPath(settings.feedbackPath, numSamples))
+    {
+    case 0:
+        processBlock<0>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageSaturation:
+        processBlock<kStageSaturation>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageLowCut:
+        processBlock<kStageLowCut>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageLowCut | kStageSaturation:
+        processBlock<kStageLowCut | kStageSaturation>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageHighCut:
+        processBlock<kStageHighCut>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageHighCut | kStageSaturation:
+        processBlock<kStageHighCut | kStageSaturation>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageHighCut | kStageLowCut:
+        processBlock<kStageHighCut | kStageLowCut>(channelData, numChannels, numSamples, settings, numTaps);
+        break;
+    case kStageHighCut | kStageLowCut | kStageSaturation:
+    default:
+        processBlock<kStageHighCut | kStageLowCut | kStageSaturation>(channelData, numChannels, numSamples,
+                                                                      settings, numTaps);
+        break;
+    }
+}
+
+template <int stages>
+void MultiTapDelay::processBlock(float* const* channelData, int numChannels, int numSamples,
+                                 const Settings& settings, int numTaps) noexcept
+{
+    if (settings.isSteady && !isModulating && !coefficientsAreMoving && tapsAreSettled(settings, numTaps))
+        processSteadyBlock<stages>(channelData, numChannels, numSamples, settings, numTaps);
+    else
+        processEachSample<stages>(channelData, numChannels, numSamples, settings, numTaps);
+}
+
+template <int stages>
+void MultiTapDelay::processEachSample(float* const* channelData, int numChannels, int numSamples,
+                                      const Settings& settings, int numTaps) noexcept
+{
+    // Where every tap reads, at each sample, shared by all channels, and moved by wow and
+    // flutter, if they're on (as far as the buffer allows)
+    const float longestDelay = maxDelaySamples + maxModulationSamples;
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const int offset = tap * maxBlockSize;
+        float* delays = tapDelays + offset;
+        float* previousDelays = previousTapDelays + offset;
+        planTap(tapStates[tap], settings.taps[tap].delaySamples, settings.timeChange, numSamples,
+                delays, previousDelays, newTapGains + offset, oldTapGains + offset);
+
+        if (isModulating)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                delays[i] = jlimit(float(DelayInterpolation::minDelaySamples), longestDelay,
+                                   delays[i] + modulation[i]);
+                previousDelays[i] = jlimit(float(DelayInterpolation::minDelaySamples), longestDelay,
+                                           previousDelays[i] + modulation[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float totalFeedback = 0.0f;
+        for (int tap = 0; tap < numTaps; ++tap)
+            totalFeedback += std::abs(settings.taps[tap].feedback[i]);
+        feedbackScale[i] = totalFeedback > maxTotalFeedback ? maxTotalFeedback / totalFeedback : 1.0f;
+    }
+
+    // While the feedback path's coefficients are moving, each channel ramps them from where
+    // they were to their targets, reaching them at the last sample
+    const StageCoefficients start = stageCoefficients;
+    const StageCoefficients& end = targetCoefficients;
+    const float rampStep = 1.0f / float(numSamples);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* data = channelData[channel];
+
+        // delayChannel is the channel of the circular buffer for implementing delay on this channel
+        const int delayChannel = jmin(channel, delayLine.getNumChannels() - 1);
+        FilterState filterState = filterStates[delayChannel];
+        StageCoefficients coefficients = start;
+
+        // Pan is a balance control, which only means something in stereo: each side is turned
+        // down as the tap moves towards the other
+        const float side = numChannels != 2 ? 0.0f : (channel == 0 ? -1.0f : 1.0f);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float in = data[i];
+            float wet = 0.0f, feedback = 0.0f;
+
+            if (coefficientsAreMoving)
+            {
+                const float t = float(i + 1) * rampStep;
+                coefficients.lowCutGain = start.lowCutGain + t * (end.lowCutGain - start.lowCutGain);
+                coefficients.highCutGain = start.highCutGain + t * (end.highCutGain - start.highCutGain);
+                if (stages & kStageSaturation)
+                {
+                    coefficients.drive = start.drive + t * (end.drive - start.drive);
+                    coefficients.inverseDrive = 1.0f / coefficients.drive;
+                }
+            }
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                const Tap& t = settings.taps[tap];
+                const int offset = tap * maxBlockSize + i;
+
+                float delayed = delayLine.read<DelayInterpolation::Cubic>(delayChannel, i, tapDelays[offset]);
+                if (oldTapGains[offset] > 0.0f)
+                {
+                    const float old = delayLine.read<DelayInterpolation::Cubic>(delayChannel, i,
+                                                                                previousTapDelays[offset]);
+                    delayed = newTapGains[offset] * delayed + oldTapGains[offset] * old;
+                }
+
+                float gain = t.level != nullptr ? t.level[i] : 1.0f;
+                if (t.pan != nullptr && side != 0.0f)
+                    gain *= jmin(1.0f, 1.0f + side * t.pan[i]);
+
+                wet += gain * delayed;
+                feedback += t.feedback[i] * delayed;
+            }
+
+            // Store the input plus the feedback from every tap in the delay buffer, once,
+            // through the feedback path's stages
+            delayLine.write(delayChannel, i, shapeFeedback<stages>(in + feedbackScale[i] * feedback,
+                                                                   filterState, coefficients));
+
+            // Store the output sample in the buffer, replacing the input
+            data[i] = settings.dryLevel[i] * in + settings.wetLevel[i] * wet;
+        }
+
+        filterStates[delayChannel] = filterState;
+    }
+    stageCoefficients = targetCoefficients;
+
+    // Each channel has been processed from the same starting position; now move on
+    delayLine.advance(numSamples);
+}
+
+template <int stages>
+void MultiTapDelay::processSteadyBlock(float* const* channelData, int numChannels, int numSamples,
+                                       const Settings& settings, int numTaps) noexcept
+{
+    // Nothing changes during the block, so the first sample's values do for all of them
+    float totalFeedback = 0.0f;
+    for (int tap = 0; tap < numTaps; ++tap)
+        totalFeedback += std::abs(settings.taps[tap].feedback[0]);
+    const float scale = totalFeedback > maxTotalFeedback ? maxTotalFeedback / totalFeedback : 1.0f;
+    const float dryLevel = settings.dryLevel[0];
+    const float wetLevel = settings.wetLevel[0];
+    const StageCoefficients coefficients = stageCoefficients;
+
+    // Each part of the block must be short enough that no tap reads what the part writes
+    int longestPart = numSamples;
+    for (int tap = 0; tap < numTaps; ++tap)
+        longestPart = jmin(longestPart,
+                           DelayLine::getLongestBlock<DelayInterpolation::Cubic>(settings.taps[tap].delaySamples));
+    jassert(longestPart > 0);
+
+    for (int start = 0; start < numSamples; start += longestPart)
+    {
+        const int count = jmin(longestPart, numSamples - start);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* data = channelData[channel] + start;
+            const int delayChannel = jmin(channel, delayLine.getNumChannels() - 1);
+            const float side = numChannels != 2 ? 0.0f : (channel == 0 ? -1.0f : 1.0f);
+
+            FloatVectorOperations::clear(wetSum, count);
+            FloatVectorOperations::clear(feedbackSum, count);
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                const Tap& t = settings.taps[tap];
+                float gain = t.level != nullptr ? t.level[0] : 1.0f;
+                if (t.pan != nullptr && side != 0.0f)
+                    gain *= jmin(1.0f, 1.0f + side * t.pan[0]);
+
+                delayLine.readBlock<DelayInterpolation::Cubic>(delayChannel, t.delaySamples, tapOutput, count);
+                FloatVectorOperations::addWithMultiply(wetSum, tapOutput, gain, count);
+                FloatVectorOperations::addWithMultiply(feedbackSum, tapOutput, t.feedback[0], count);
+            }
+
+            // The input plus the feedback, through the feedback path's stages (the filters a
+            // sample at a time, since each depends on the last), into the buffer; then the
+            // output in place of the input
+            FloatVectorOperations::multiply(feedbackSum, scale, count);
+            FloatVectorOperations::add(feedbackSum, data, count);
+            if (stages != 0)
+            {
+                FilterState filterState = filterStates[delayChannel];
+                for (int i = 0; i < count; ++i)
+                    feedbackSum[i] = shapeFeedback<stages>(feedbackSum[i], filterState, coefficients);
+                filterStates[delayChannel] = filterState;
+            }
+            delayLine.writeBlock(delayChannel, feedbackSum, count);
+
+            FloatVectorOperations::multiply(data, dryLevel, count);
+            FloatVectorOperations::addWithMultiply(data, wetSum, wetLevel, count);
+        }
+
+        // Each part starts where the last one finished
+        delayLine.advance(count);
+    }
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include "JuceHeader.h"
+#include "DelayLine.h"
+#include "BlockLFO.h"
+
+/*  MultiTapDelay: the Delay's delay line and taps, for all channels.
+
+    Every tap reads the same DelayLine, in one pass through each channel: at each sample, all
+    the taps are read (with cubic interpolation, so a tap's time need not be a whole number of
+    samples), their outputs are summed, and the input plus each tap's share of feedback is
+    written back, once. The single delay of the original effect is just the one-tap case.
+
+    A tap's time never jumps. When its target changes, either the read position glides to the
+    new time, at no more than maxGlideRate samples per sample, so the echoes bend in pitch
+    like a tape delay's (kTimeChangeGlide), or the tap fades out at the old time while fading
+    in at the new one, over crossfadeSec, with no change of pitch (kTimeChangeCrossfade).
+
+    Times can also follow the host's tempo: with a sync setting other than kSyncOff,
+    getDelaySamples() rounds each time to the nearest whole number of that note value, at the
+    tempo the play head reports.
+
+    The buffer is allocated in prepare(), long enough for the longest time any tap can be set
+    to, since it can't be resized on the audio thread.
+
+    Most of the time, nothing is moving: no tap is gliding or crossfading, and the caller says
+    (with Settings::isSteady) that none of its per-sample values are ramping. Every tap then
+    reads at the same fractional delay for the whole block, so instead of reading each tap, a
+    sample at a time, in one loop, each tap is read as a block, by DelayLine::readBlock() at a
+    fixed delay (a few multiply-adds over straight runs of the buffer), and summed in with one
+    more; the sum going back into the buffer is written as a block too, in at most two runs,
+    either side of the end of the buffer. A block can only be done this way if none of its
+    reads reaches a sample it writes, so one shorter than the shortest tap is split up.
+
+    Everything written into the buffer can also be shaped on the way in, as a tape or
+    bucket-brigade delay would: saturated (a soft clipper, driven harder as saturation goes
+    up, whose gain for small signals is 1, so the loop gain is unchanged), and filtered by a
+    one-pole highpass (low cut) and lowpass (high cut), so each echo is duller and thinner
+    than the one before. These stages are inside the feedback loop, so every repeat goes
+    through them again. Each combination of them is a template argument of both ways of
+    processing, chosen by one switch per block, so a stage which is off costs nothing at all,
+    and one which is on is compiled straight into the loop. Wow and flutter (a slow and a
+    fast wobble of the tape speed) move every tap's read position, by the same amount, which
+    the per-sample path already reads from an array, so they need no stage of their own;
+    while they are on, nothing is steady. Nor is it while a stage's settings are changing,
+    when the per-sample path ramps its coefficients, so a turned knob glides instead of
+    stepping at each block.
+*/
+
+class MultiTapDelay
+{
+public:
+    static const int maxTaps = 16;
+
+    enum Mode
+    {
+        kModeSingle = 0,
+        kModeMultiTap,
+        kNumModes
+    };
+    static void populateModeComboBox(ComboBox& cb);
+
+    enum TimeChange
+    {
+        kTimeChangeGlide = 0,
+        kTimeChangeCrossfade,
+        kNumTimeChanges
+    };
+    static void populateTimeChangeComboBox(ComboBox& cb);
+
+    enum Sync
+    {
+        kSyncOff = 0,
+        kSyncThirtySecondNote,
+        kSyncSixteenthTriplet,
+        kSyncSixteenthNote,
+        kSyncEighthTriplet,
+        kSyncEighthNote,
+        kSyncDottedEighthNote,
+        kSyncQuarterNote,
+        kSyncDottedQuarterNote,
+        kSyncHalfNote,
+        kNumSyncs
+    };
+    static void populateSyncComboBox(ComboBox& cb);
+
+    // The delay in samples for timeSec, rounded to a whole number (at least one) of the sync
+    // setting's note value if bpm is known (> 0), and kept between the shortest delay the
+    // interpolation can read and maxDelaySamples
+    static float getDelaySamples(float timeSec, Sync sync, double bpm, double sampleRate,
+                                 float maxDelaySamples) noexcept;
+
+    // The optional stages in the feedback path; processSamples() picks the combination for
+    // each block from the FeedbackPath settings
+    enum FeedbackStage
+    {
+        kStageSaturation = 1,
+        kStageLowCut = 2,
+        kStageHighCut = 4
+    };
+
+    // What is done to everything written into the buffer, for one block. The stages' settings
+    // are where they should be by the end of the block; their coefficients ramp there from
+    // where the last block left them.
+    struct FeedbackPath
+    {
+        float saturation;                   // 0 (none) to 1
+        float lowCutHz;                     // highpass cutoff, or 0 for none
+        float highCutHz;                    // lowpass cutoff, or 0 for none
+        const float* wowFlutter;            // per sample, 0 to 1, or null for none
+    };
+
+    // One tap, for one block. The level, pan (-1 left to +1 right, for stereo) and feedback
+    // are given for every sample; a null level means 1, and a null pan means centre.
+    struct Tap
+    {
+        float delaySamples;                 // target
+        const float* level;
+        const float* pan;
+        const float* feedback;
+    };
+
+    // Everything which affects the delay, for one block
+    struct Settings
+    {
+        int numTaps;
+        Tap taps[maxTaps];
+        TimeChange timeChange;
+        const float* dryLevel;              // per sample
+        const float* wetLevel;              // ditto
+        bool isSteady;                      // all the per-sample values are the same all block
+        FeedbackPath feedbackPath;
+    };
+
+    MultiTapDelay();
+
+    // Not on the audio thread: allocate for numChannels channels, delays up to maxDelaySec
+    // (plus wow and flutter), and blocks of up to maxBlockSize samples, all cleared
+    void prepare(int numChannels, double sampleRate, float maxDelaySec, int maxBlockSize);
+    int getNumChannels() const { return delayLine.getNumChannels(); }
+    float getMaxDelaySamples() const { return maxDelaySamples; }
+
+    // Clear the buffer; the next targets are reached at once
+    void reset();
+
+    // Delay numSamples samples of each of the first numChannels channels in place
+    void processSamples(float* const* channelData, int numChannels, int numSamples,
+                        const Settings& settings) noexcept;
+
+private:
+    // Glides slow down as they near the target (with time constant glideTimeSec), and are
+    // limited to maxGlideRate samples per sample, i.e. a pitch change of at most 50%
+    static const float glideTimeSec, maxGlideRate, crossfadeSec;
+
+    // At full depth, wow moves the read positions up to wowDepthSec either way, at wowFreqHz,
+    // and flutter up to flutterDepthSec, at flutterFreqHz: pitch changes of 0.75% and 0.45%
+    static const float wowFreqHz, wowDepthSec, flutterFreqHz, flutterDepthSec;
+
+    // Saturation: the soft clipper's input gain is maxDrive at full saturation, and falls with
+    // it, to minDrive, so that light saturation only touches the loudest echoes
+    static const float maxDrive, minDrive;
+
+    // Each buffer channel's one-pole filter states, and the filters' and saturation's settings
+    struct FilterState
+    {
+        float lowCut, highCut;
+    };
+    struct StageCoefficients
+    {
+        float lowCutGain, highCutGain;      // G = g / (1 + g), with g = tan(pi fc / fs)
+        float drive, inverseDrive;
+    };
+
+    // The feedback path's stages, for one sample
+    template <int stages>
+    static inline float shapeFeedback(float x, FilterState& state, const StageCoefficients& c) noexcept;
+
+    // Where a tap is reading
+    struct TapState
+    {
+        float delaySamples;
+        float previousDelaySamples;         // while crossfading
+        int fadeSamplesDone;                // of fadeSamples; fadeSamples when not fading
+        bool isSet;                         // false until the first block after reset()
+    };
+
+    // Fill in the tap's delay at each sample, and while crossfading, the gains of the new and
+    // old read positions, and the old delay
+    void planTap(TapState& state, float targetDelaySamples, TimeChange timeChange, int numSamples,
+                 float* delays, float* previousDelays, float* newGains, float* oldGains) noexcept;
+
+    // True if every tap will stay exactly where it is for the whole block
+    bool tapsAreSettled(const Settings& settings, int numTaps) const noexcept;
+
+    // The two ways of processing a block: one sample at a time, with every tap read at its
+    // own delay for each one, or a tap at a time, when nothing is moving; both compiled for
+    // each combination of feedback stages
+    template <int stages>
+    void processBlock(float* const* channelData, int numChannels, int numSamples,
+                      const Settings& settings, int numTaps) noexcept;
+    template <int stages>
+    void processEachSample(float* const* channelData, int numChannels, int numSamples,
+                           const Settings& settings, int numTaps) noexcept;
+    template <int stages>
+    void processSteadyBlock(float* const* channelData, int numChannels, int numSamples,
+                            const Settings& settings, int numTaps) noexcept;
+
+    // Work out this block's stages and their coefficients, and wow and flutter; returns the stages
+    int prepareFeedbackPath(const FeedbackPath& path, int numSamples) noexcept;
+
+    DelayLine delayLine;
+    TapState tapStates[maxTaps];
+    double sampleRate;
+    float maxDelaySamples;
+    float maxModulationSamples;             // the most wow and flutter add to a delay
+    float glideCoefficient;
+    int fadeSamples;
+    int maxBlockSize;
+
+    // maxTaps blocks of each, and one of the overall feedback scale
+    HeapBlock<float> tapDelays, previousTapDelays, newTapGains, oldTapGains;
+    HeapBlock<float> feedbackScale;
+
+    // One block of each, for processSteadyBlock(): one tap's output, and all the taps' outputs
+    // and feedback, summed
+    HeapBlock<float> tapOutput, wetSum, feedbackSum;
+
+    // The feedback path: one FilterState per buffer channel, the coefficients reached at the
+    // end of the last block and the ones this block ramps to, and while wow and flutter are
+    // on, how far they move the read positions at each sample
+    HeapBlock<FilterState> filterStates;
+    StageCoefficients stageCoefficients, targetCoefficients;
+    bool coefficientsAreSet;                // false until the first block after reset()
+    bool coefficientsAreMoving;             // this block ramps them
+    BlockLFO wowLFO, flutterLFO;
+    HeapBlock<float> modulation;
+    bool isModulating;
+
+    JUCE_DECLARE_NON_COPYABLE(MultiTapDelay)
+};
@@ -71,25 +71,19 @@ AudioProcessorValueTreeState::ParameterLayout PingPongDelayParameters::createPar
 
 PingPongDelayParameters::PingPongDelayParameters(AudioProcessorValueTreeState& vts,
                                                  AudioProcessorValueTreeState::Listener* processor)
-    : delaySecL(delayTimeLDefault)
-    , delaySecR(delayTimeRDefault)
-    , feedback(feedbackDefault)
+    : feedback(feedbackDefault)
     , wetLevel(wetLevelDefault)
     , reverseChannels(false)
     , linkDelays(false)
     , valueTreeState(vts)
     , processorAsListener(processor)
-    , delayTimeLListener(delaySecL)
-    , delayTimeRListener(delaySecR)
     , feedbackListener(feedback, 0.01f)
     , wetLevelListener(wetLevel, 0.01f)
 {
-    valueTreeState.addParameterListener(delayTimeLID, &delayTimeLListener);
-    valueTreeState.addParameterListener(delayTimeRID, &delayTimeRListener);
-    valueTreeState.addParameterListener(feedbackID, &feedbackListener);
-    valueTreeState.addParameterListener(wetLevelID, &wetLevelListener);
     valueTreeState.addParameterListener(delayTimeLID, processorAsListener);
     valueTreeState.addParameterListener(delayTimeRID, processorAsListener);
+    valueTreeState.addParameterListener(feedbackID, &feedbackListener);
+    valueTreeState.addParameterListener(wetLevelID, &wetLevelListener);
 
     feedback *= 0.01f;
     wetLevel *= 0.01f;
@@ -98,8 +92,6 @@ PingPongDelayParameters::PingPongDelayParameters(AudioProcessorValueTreeState& v
 PingPongDelayParameters::~PingPongDelayParameters()
 {
     detachControls();
-    valueTreeState.removeParameterListener(delayTimeLID, &delayTimeLListener);
-    valueTreeState.removeParameterListener(delayTimeRID, &delayTimeRListener);
     valueTreeState.removeParameterListener(feedbackID, &feedbackListener);
     valueTreeState.removeParameterListener(wetLevelID, &wetLevelListener);
     valueTreeState.removeParameterListener(delayTimeLID, processorAsListener);
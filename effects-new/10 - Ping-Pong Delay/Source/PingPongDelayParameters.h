@@ -29,9 +29,7 @@ public:
         Slider& feedbackKnob,
         Slider& wetLevelKnob );
 
-    // working parameter values
-    float delaySecL;
-    float delaySecR;
+    // working parameter values (the delay times go straight to the processor)
     float feedback;
     float wetLevel;
     bool reverseChannels;
@@ -51,8 +49,6 @@ private:
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> wetLevelAttachment;
 
     // Listener objects link parameters to working variables
-    FloatListener delayTimeLListener;
-    FloatListener delayTimeRListener;
     FloatListener feedbackListener;
     FloatListener wetLevelListener;
 };
\ No newline at end of file
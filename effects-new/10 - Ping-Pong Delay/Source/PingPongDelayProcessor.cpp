@@ -21,8 +21,10 @@ PingPongDelayProcessor::PingPongDelayProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("PingPongDelay"), PingPongDelayParameters::createParameterLayout())
     , parameters(valueTreeState, this)
-    , delayReadPositionLeft(0), delayReadPositionRight(0)
-    , delayWritePosition(0)
+    , delaySamplesLeft(1), delaySamplesRight(1)
+    , delaySecLeftTarget(PingPongDelayParameters::delayTimeLDefault)
+    , delaySecRightTarget(PingPongDelayParameters::delayTimeRDefault)
+    , maxBlockSize(0)
 {
 }
 
@@ -31,32 +33,41 @@ PingPongDelayProcessor::~PingPongDelayProcessor()
 {
 }
 
-void PingPongDelayProcessor::parameterChanged(const String&, float)
+void PingPongDelayProcessor::parameterChanged(const String& parameterID, float newValue)
 {
-    delayReadPositionLeft = (int)(delayWritePosition - (parameters.delaySecL * getSampleRate())
-                                                     + delayBufferLength) % delayBufferLength;
+    if (parameterID == PingPongDelayParameters::delayTimeLID)
+        delaySecLeftTarget.store(newValue);
+    else if (parameterID == PingPongDelayParameters::delayTimeRID)
+        delaySecRightTarget.store(newValue);
+}
 
-    delayReadPositionRight = (int)(delayWritePosition - (parameters.delaySecR * getSampleRate())
-                                                      + delayBufferLength) % delayBufferLength;
+// Convert the latest delay times to samples (at least 1, since we read before writing)
+void PingPongDelayProcessor::updateDelayTimes()
+{
+    const double sampleRate = getSampleRate();
+    delaySamplesLeft = jlimit(1, int(PingPongDelayParameters::delayTimeLMax * sampleRate),
+                              roundToInt(delaySecLeftTarget.load() * sampleRate));
+    delaySamplesRight = jlimit(1, int(PingPongDelayParameters::delayTimeRMax * sampleRate),
+                               roundToInt(delaySecRightTarget.load() * sampleRate));
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void PingPongDelayProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void PingPongDelayProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     // Allocate and zero the delay buffer (size will depend on current sample rate)
-    // Sanity check the result so we don't end up with any zero-length calculations
-    delayBufferLength = (int)(2.0*sampleRate);
-    if (delayBufferLength < 1) delayBufferLength = 1;
-    delayBuffer.setSize(2, delayBufferLength);
-    delayBuffer.clear();
-
-    // This method gives us the sample rate. Use this to figure out what the delay position
-    // offset should be (since it is specified in seconds, and we need to convert it to a number
-    // of samples)
-    delayReadPositionLeft = (int)(delayWritePosition - (parameters.delaySecL * sampleRate)
-                                                     + delayBufferLength) % delayBufferLength;
-    delayReadPositionRight = (int)(delayWritePosition - (parameters.delaySecR * sampleRate)
-                                                      + delayBufferLength) % delayBufferLength;
+    double maxDelaySec = jmax(PingPongDelayParameters::delayTimeLMax, PingPongDelayParameters::delayTimeRMax);
+    delayLine.prepare(2, int(maxDelaySec * sampleRate) + 1, maxSamplesPerBlock);
+    maxBlockSize = jmax(1, maxSamplesPerBlock);
+    delayedLeft.allocate(size_t(maxBlockSize), true);
+    delayedRight.allocate(size_t(maxBlockSize), true);
+    delayInput.allocate(size_t(maxBlockSize), true);
+
+    // This method gives us the sample rate. Use this to figure out what the delays
+    // should be in samples (since they are specified in seconds)
+    updateDelayTimes();
 }
 
 // Audio processing finished; release any allocated memory
@@ -66,6 +77,12 @@ void PingPongDelayProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void PingPongDelayProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void PingPongDelayProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -79,6 +96,9 @@ void PingPongDelayProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffe
     if (buffer.getNumChannels() < 2)
         return;
 
+    // Pick up any change to the delay times, whichever thread made it
+    updateDelayTimes();
+
     // If there is one input only, the second channel may not contain anything useful.
     // start with a blank buffer in this case
     if (numInputChannels < 2)
@@ -89,39 +109,41 @@ void PingPongDelayProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffe
     float *channelDataL = buffer.getWritePointer(0);
     float *channelDataR = buffer.getWritePointer(1);
 
-    // delayDataL and delayDataR are the circular buffers for implementing delay
-    float* delayDataL = delayBuffer.getWritePointer(0);
-    float* delayDataR = delayBuffer.getWritePointer(1);
-
-    for (int i = 0; i < numSamples; ++i)
+    // delayLine channels 0 and 1 are the circular buffers for implementing delay. Nothing
+    // changes during a sub-block (the delay times are whole numbers of samples, and the levels
+    // aren't smoothed), so rather than going a sample at a time, each part of the block is
+    // done as a few block operations: each delay is read as one run (see DelayLine.h), and
+    // written back in at most two, either side of the end of the buffer. A part can't be
+    // longer than the shorter delay, or it would read samples it hasn't written yet.
+    const int delayL = delaySamplesLeft;
+    const int delayR = delaySamplesRight;
+    const float feedback = parameters.feedback;
+    const float wetLevel = parameters.wetLevel;
+    const bool reverse = parameters.reverseChannels;
+    const int longestPart = jmin(delayL, delayR, maxBlockSize);
+
+    for (int start = 0; start < numSamples; start += longestPart)
     {
-        const float inL = channelDataL[i];
-        const float inR = channelDataR[i];
-        float outL, outR;
-
-        if (parameters.reverseChannels)
-        {
-            outL = (inL + parameters.wetLevel * delayDataR[delayReadPositionLeft]);
-            outR = (inR + parameters.wetLevel * delayDataL[delayReadPositionRight]);
-        }
-        else
-        {
-            outL = (inL + parameters.wetLevel * delayDataL[delayReadPositionLeft]);
-            outR = (inR + parameters.wetLevel * delayDataR[delayReadPositionRight]);
-        }
+        const int count = jmin(longestPart, numSamples - start);
+        float* dataL = channelDataL + start;
+        float* dataR = channelDataR + start;
+        delayLine.readBlock(0, delayL, delayedLeft, count);
+        delayLine.readBlock(1, delayR, delayedRight, count);
 
         // Store the output of one delay buffer into the other, producing
         // the ping-pong effect
-        delayDataR[delayWritePosition] = inR + (delayDataL[delayReadPositionLeft] * parameters.feedback);
-        delayDataL[delayWritePosition] = inL + (delayDataR[delayReadPositionRight] * parameters.feedback);
-
-        if (++delayReadPositionLeft >= delayBufferLength) delayReadPositionLeft = 0;
-        if (++delayReadPositionRight >= delayBufferLength) delayReadPositionRight = 0;
-        if (++delayWritePosition >= delayBufferLength) delayWritePosition = 0;
+        FloatVectorOperations::copy(delayInput, dataR, count);
+        FloatVectorOperations::addWithMultiply(delayInput, delayedLeft, feedback, count);
+        delayLine.writeBlock(1, delayInput, count);
+        FloatVectorOperations::copy(delayInput, dataL, count);
+        FloatVectorOperations::addWithMultiply(delayInput, delayedRight, feedback, count);
+        delayLine.writeBlock(0, delayInput, count);
 
         // Store the output samples in the buffer, replacing the input
-        channelDataL[i] = outL;
-        channelDataR[i] = outR;
+        FloatVectorOperations::addWithMultiply(dataL, reverse ? delayedRight : delayedLeft, wetLevel, count);
+        FloatVectorOperations::addWithMultiply(dataR, reverse ? delayedLeft : delayedRight, wetLevel, count);
+
+        delayLine.advance(count);
     }
 
     // Clear any channels above 2 (stereo)
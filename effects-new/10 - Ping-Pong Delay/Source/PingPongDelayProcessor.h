@@ -1,9 +1,12 @@
 #pragma once
 #include "JuceHeader.h"
 #include "PingPongDelayParameters.h"
+#include "DelayLine.h"
+#include "AutomationScheduler.h"
 
 class PingPongDelayProcessor    : public AudioProcessor
                                 , public AudioProcessorValueTreeState::Listener
+                                , public AutomationScheduler::Owner
 {
 public:
     PingPongDelayProcessor();
@@ -30,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -45,11 +51,23 @@ public:
     void parameterChanged(const String&, float) override;
 
 private:
-    // Circular buffer variables for implementing delay
-    AudioSampleBuffer delayBuffer;
-    int delayBufferLength;
-    int delayReadPositionLeft, delayReadPositionRight;
-    int delayWritePosition;
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // Circular buffer for implementing delay, and the delay times in samples
+    DelayLine delayLine;
+    int delaySamplesLeft, delaySamplesRight;
+
+    // The delay times in seconds, as last set by parameterChanged() on any thread; they are
+    // converted to samples at the start of each sub-block
+    std::atomic<float> delaySecLeftTarget, delaySecRightTarget;
+
+    // One block each of the samples read from each side of the delay, and of what is written
+    HeapBlock<float> delayedLeft, delayedRight, delayInput;
+    int maxBlockSize;
+
+    void updateDelayTimes();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PingPongDelayProcessor)
 };
\ No newline at end of file
@@ -26,30 +26,41 @@ VibratoEditor::VibratoEditor (VibratoProcessor& p)
     lfoWaveformCombo.setJustificationType(Justification::centredLeft);
     VibratoLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
+    lfoSyncLabel.setText("LFO Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
 
     interpTypeLabel.setText("Interpolation Type", dontSendNotification);
     interpTypeLabel.setJustificationType(Justification::right);
     addAndMakeVisible(&interpTypeLabel);
     interpTypeCombo.setEditableText(false);
     interpTypeCombo.setJustificationType(Justification::centredLeft);
-    VibratoInterpolation::populateInterpolationComboBox(interpTypeCombo);
+    DelayInterpolation::populateInterpolationComboBox(interpTypeCombo);
     addAndMakeVisible(interpTypeCombo);
 
     addAndMakeVisible(pitchShiftDescriptionLabel);
 
-    processor.addChangeListener(this);
     processor.parameters.attachControls(
         lfoWaveformCombo,
+        lfoSyncCombo,
         lfoFreqKnob,
         sweepWidthKnob,
         interpTypeCombo );
 
-    setSize (600, 220);
+    // Keep pitchShiftDescriptionLabel up to date, starting now
+    timerCallback();
+    startTimerHz(10);
+
+    setSize (600, 254);
 }
 
 VibratoEditor::~VibratoEditor()
 {
-    processor.removeChangeListener(this);
+    stopTimer();
     processor.parameters.detachControls();
     setLookAndFeel(nullptr);
 }
@@ -79,6 +90,11 @@ void VibratoEditor::resized()
     lfoWaveformCombo.setBounds(rowArea);
     widgetsArea.removeFromTop(10);
     rowArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(rowArea.removeFromLeft(120));
+    rowArea.removeFromLeft(10);
+    lfoSyncCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
     interpTypeLabel.setBounds(rowArea.removeFromLeft(120));
     rowArea.removeFromLeft(10);
     interpTypeCombo.setBounds(rowArea);
@@ -90,7 +106,7 @@ void VibratoEditor::paint (Graphics& g)
     g.fillAll(lookAndFeel->findColour(ResizableWindow::backgroundColourId));
 }
 
-void VibratoEditor::changeListenerCallback(ChangeBroadcaster*)
+void VibratoEditor::timerCallback()
 {
-    pitchShiftDescriptionLabel.setText(processor.pitchShiftDescription, dontSendNotification);
+    pitchShiftDescriptionLabel.setText(processor.getPitchShiftDescription(), dontSendNotification);
 }
@@ -4,7 +4,7 @@
 #include "LabeledKnob.h"
 
 class VibratoEditor : public AudioProcessorEditor
-                    , public ChangeListener
+                    , protected Timer
 {
 public:
     VibratoEditor (VibratoProcessor&);
@@ -14,8 +14,9 @@ public:
     void paint (Graphics&) override;
     void resized() override;
 
-    // ChangeListener
-    void changeListenerCallback(ChangeBroadcaster*) override;
+protected:
+    // Timer: polls the processor's pitch shift description
+    void timerCallback() override;
 
 private:
     SharedResourcePointer<BasicLookAndFeel> lookAndFeel;
@@ -26,6 +27,7 @@ private:
     BasicKnob lfoFreqKnob; LabeledKnob labeledLfoFreqKnob;
     BasicKnob sweepWidthKnob; LabeledKnob labeledSweepWidthKnob;
     ComboBox lfoWaveformCombo; Label lfoWaveformLabel;
+    ComboBox lfoSyncCombo; Label lfoSyncLabel;
     ComboBox interpTypeCombo; Label interpTypeLabel;
     Label pitchShiftDescriptionLabel;
 
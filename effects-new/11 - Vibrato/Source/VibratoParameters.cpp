@@ -4,8 +4,14 @@
 const String VibratoParameters::lfoWaveformID = "lfoWaveform";
 const String VibratoParameters::lfoWaveformName = TRANS("LFO");
 const String VibratoParameters::lfoWaveformLabel = "";
-const int VibratoParameters::lfoWaveformEnumCount = 5;
+const int VibratoParameters::lfoWaveformEnumCount = 4;
 const int VibratoParameters::lfoWaveformDefault = 0;
+// LFO Sync
+const String VibratoParameters::lfoSyncID = "lfoSync";
+const String VibratoParameters::lfoSyncName = TRANS("LFO Sync");
+const String VibratoParameters::lfoSyncLabel = "";
+const int VibratoParameters::lfoSyncEnumCount = BlockLFO::kNumSyncs;
+const int VibratoParameters::lfoSyncDefault = 0;
 // LFO Frequency
 const String VibratoParameters::lfoFreqID = "lfoFreq";
 const String VibratoParameters::lfoFreqName = TRANS("LFO Freq");
@@ -26,7 +32,7 @@ const float VibratoParameters::sweepWidthStep = 0.0005f;
 const String VibratoParameters::interpTypeID = "interpType";
 const String VibratoParameters::interpTypeName = TRANS("Interpolation Type");
 const String VibratoParameters::interpTypeLabel = "";
-const int VibratoParameters::interpTypeEnumCount = 3;
+const int VibratoParameters::interpTypeEnumCount = DelayInterpolation::kNumInterpolations;
 const int VibratoParameters::interpTypeDefault = 1;
 
 AudioProcessorValueTreeState::ParameterLayout VibratoParameters::createParameterLayout()
@@ -39,6 +45,12 @@ AudioProcessorValueTreeState::ParameterLayout VibratoParameters::createParameter
         lfoWaveformLabel,
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, lfoSyncEnumCount - 1, lfoSyncDefault,
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
     params.push_back(std::make_unique<AudioParameterFloat>(
         lfoFreqID, lfoFreqName,
         NormalisableRange<float>(lfoFreqMin, lfoFreqMax, lfoFreqStep), lfoFreqDefault,
@@ -66,12 +78,14 @@ AudioProcessorValueTreeState::ParameterLayout VibratoParameters::createParameter
 VibratoParameters::VibratoParameters(AudioProcessorValueTreeState& vts,
                                      AudioProcessorValueTreeState::Listener* processor)
     : lfoWaveform(VibratoLFO::Waveform(lfoWaveformDefault))
+    , lfoSync((BlockLFO::Sync)lfoSyncDefault)
     , lfoFreqHz(lfoFreqDefault)
     , sweepWidthHz(sweepWidthDefault)
-    , interpolationType(VibratoInterpolation::Type(interpTypeDefault))
+    , interpolationType(DelayInterpolation::Type(interpTypeDefault))
     , valueTreeState(vts)
     , processorAsListener(processor)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , lfoFreqListener(lfoFreqHz)
     , sweepWidthListener(sweepWidthHz)
     , interpTypeListener(interpolationType)
@@ -88,6 +102,7 @@ VibratoParameters::VibratoParameters(AudioProcessorValueTreeState& vts,
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(sweepWidthID, &sweepWidthListener);
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
 }
 
 VibratoParameters::~VibratoParameters()
@@ -102,11 +117,13 @@ VibratoParameters::~VibratoParameters()
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(sweepWidthID, &sweepWidthListener);
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
 }
 
 void VibratoParameters::detachControls()
 {
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     lfoFreqAttachment.reset(nullptr);
     sweepWidthAttachment.reset(nullptr);
     interpTypeAttachment.reset(nullptr);
@@ -114,6 +131,7 @@ void VibratoParameters::detachControls()
 
 void VibratoParameters::attachControls(
     ComboBox& lfoWaveformCombo,
+    ComboBox& lfoSyncCombo,
     Slider& lfoFreqKnob,
     Slider& sweepWidthKnob,
     ComboBox& interpTypeCombo )
@@ -124,4 +142,5 @@ void VibratoParameters::attachControls(
     sweepWidthAttachment.reset(new SlAt(valueTreeState, sweepWidthID, sweepWidthKnob));
     interpTypeAttachment.reset(new CbAt(valueTreeState, interpTypeID, interpTypeCombo));
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
 }
\ No newline at end of file
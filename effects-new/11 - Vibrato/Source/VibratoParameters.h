@@ -2,7 +2,7 @@
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
 #include "VibratoLFO.h"
-#include "VibratoInterpolation.h"
+#include "DelayInterpolation.h"
 
 class VibratoParameters
 {
@@ -11,6 +11,8 @@ public:
     // Labels are supplementary, typically used for units of measure.
     static const String lfoWaveformID, lfoWaveformName, lfoWaveformLabel;
     static const int lfoWaveformEnumCount, lfoWaveformDefault;
+    static const String lfoSyncID, lfoSyncName, lfoSyncLabel;
+    static const int lfoSyncEnumCount, lfoSyncDefault;
     static const String lfoFreqID, lfoFreqName, lfoFreqLabel;
     static const float lfoFreqMin, lfoFreqMax, lfoFreqDefault, lfoFreqStep;
     static const String sweepWidthID, sweepWidthName, sweepWidthLabel;
@@ -27,15 +29,17 @@ public:
     void detachControls();
     void attachControls(
         ComboBox& lfoWaveformCombo,
+        ComboBox& lfoSyncCombo,
         Slider& lfoFreqKnob,
         Slider& sweepWidthKnob,
         ComboBox& interpTypeCombo );
 
     // working parameter values
     VibratoLFO::Waveform lfoWaveform;
+    BlockLFO::Sync lfoSync;
     float lfoFreqHz;
     float sweepWidthHz;
-    VibratoInterpolation::Type interpolationType;
+    DelayInterpolation::Type interpolationType;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -46,13 +50,15 @@ private:
 
     // Attachment objects link GUI controls to parameters
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoSyncAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> sweepWidthAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> interpTypeAttachment;
 
     // Listener objects link parameters to working variables
     EnumListener<VibratoLFO::Waveform> lfoWaveformListener;
+    EnumListener<BlockLFO::Sync> lfoSyncListener;
     FloatListener lfoFreqListener;
     FloatListener sweepWidthListener;
-    EnumListener<VibratoInterpolation::Type> interpTypeListener;
+    EnumListener<DelayInterpolation::Type> interpTypeListener;
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "VibratoProcessor.h"
 #include "VibratoEditor.h"
 #include "VibratoLFO.h"
-#include "VibratoInterpolation.h"
+#include "DelayInterpolation.h"
 
 // Instantiate this plugin
 AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -12,13 +12,7 @@ AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 // Instantiate this plugin's editor/GUI
 AudioProcessorEditor* VibratoProcessor::createEditor()
 {
-    // Create editor
-    VibratoEditor* editor = new VibratoEditor(*this);
-
-    // Force initial update of pitchShiftDescription and GUI label
-    parameterChanged({}, 0.0f);
-
-    return editor;
+    return new VibratoEditor(*this);
 }
 
 // Constructor: start off assuming stereo input, stereo output
@@ -29,11 +23,9 @@ VibratoProcessor::VibratoProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("Vibrato"), VibratoParameters::createParameterLayout())
     , parameters(valueTreeState, this)
-    , lfoPhase(0.0f)
-    , inverseSampleRate(1.0f / 44100.0f)
-    , delayBufferLength(0)
-    , delayReadPosition(0), delayWritePosition(0)
+    , activeInterpolationType(parameters.interpolationType)
 {
+    parameterChanged({}, 0.0f);
 }
 
 // Destructor
@@ -54,7 +46,6 @@ void VibratoProcessor::parameterChanged(const String&, float)
     // For f(frequency*t), "dx" = frequency
 
     float maxSpeed = 1.0, minSpeed = 1.0;
-    float maxPitch = 0.0, minPitch = 0.0;
 
     float lfoFreqTimesSweep = parameters.lfoFreqHz * parameters.sweepWidthHz;
     const float FLT_PI = 3.1415926f;
@@ -80,36 +71,48 @@ void VibratoProcessor::parameterChanged(const String&, float)
         break;
     }
 
+    // This may be called on the audio thread (e.g. during automation), so just store the results
+    // for the GUI to pick up (see getPitchShiftDescription()); no String formatting, no messages
+    minPlaybackSpeed = minSpeed;
+    maxPlaybackSpeed = maxSpeed;
+}
+
+// Text summary of pitch shift based on current parameter settings, for GUI display
+String VibratoProcessor::getPitchShiftDescription() const
+{
+    float minSpeed = minPlaybackSpeed;
+    float maxSpeed = maxPlaybackSpeed;
+
     // Convert speed to pitch shift --> semitones = 12*log2(speed)
-    maxPitch = 12.0f * logf(maxSpeed) / logf(2.0f);
+    float maxPitch = 12.0f * logf(maxSpeed) / logf(2.0f);
 
     if (minSpeed > 0)
     {
-        minPitch = 12.0f* logf(minSpeed) / logf(2.0f);
-        pitchShiftDescription = String::formatted("Vibrato range: %+.2f to %+.2f semitones (speed %.3f to %.3f)",
-                                                  minPitch, maxPitch, minSpeed, maxSpeed);
+        float minPitch = 12.0f* logf(minSpeed) / logf(2.0f);
+        return String::formatted("Vibrato range: %+.2f to %+.2f semitones (speed %.3f to %.3f)",
+                                 minPitch, maxPitch, minSpeed, maxSpeed);
     }
     else
     {
-        pitchShiftDescription = String::formatted("Vibrato range: 0.0 to %+.2f semitones (speed %.3f to %.3f)",
-                                                  maxPitch, minSpeed, maxSpeed);
+        return String::formatted("Vibrato range: 0.0 to %+.2f semitones (speed %.3f to %.3f)",
+                                 maxPitch, minSpeed, maxSpeed);
     }
-
-    // Signal any active editor to update its pitchShiftDescriptionLabel
-    sendChangeMessage();
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void VibratoProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void VibratoProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
-    // Allocate and zero the delay buffer (size will depend on current sample rate)
-    // Add 3 extra samples to allow cubic interpolation even at maximum delay
-    delayBufferLength = (int)(VibratoParameters::sweepWidthMax * sampleRate) + 3;
-    delayBuffer.setSize(2, delayBufferLength);
-    delayBuffer.clear();
-    lfoPhase = 0.0f;
+    // Scheduled parameter changes are timed from here
+    automation.reset();
 
-    inverseSampleRate = 1.0 / sampleRate;
+    // Allocate and zero the delay buffer (size will depend on current sample rate)
+    // Add extra samples to allow any interpolation method even at maximum delay
+    delayLine.prepare(getTotalNumInputChannels(),
+                      int(VibratoParameters::sweepWidthMax * sampleRate) + DelayInterpolation::minDelaySamples + 1,
+                      maxSamplesPerBlock);
+    interpolatorState.allocate(size_t(delayLine.getNumChannels() * DelayInterpolation::stateSize), true);
+    activeInterpolationType = parameters.interpolationType;
+    lfo.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -119,6 +122,60 @@ void VibratoProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void VibratoProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo and position at the start of each block
+    lfo.setSync(parameters.lfoSync);
+    lfo.syncToPlayHead(getPlayHead());
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void VibratoProcessor::processSubBlock (AudioBuffer<float>& buffer)
+{
+    // Any interpolator state belongs to the previous interpolation method
+    if (parameters.interpolationType != activeInterpolationType)
+    {
+        interpolatorState.clear(size_t(delayLine.getNumChannels() * DelayInterpolation::stateSize));
+        activeInterpolationType = parameters.interpolationType;
+    }
+
+    // Render this block of LFO output once, for all channels
+    lfo.advance(buffer.getNumSamples(), parameters.lfoFreqHz);
+    const float* lfoOut = lfo.render(0, VibratoLFO::getBlockWaveform(parameters.lfoWaveform),
+                                     buffer.getNumSamples());
+
+    // Choose the interpolation method once for the whole block, so the per-sample loop in
+    // processChannels() is compiled for each method without any switches
+    switch (activeInterpolationType)
+    {
+    case DelayInterpolation::kInterpolationNearestNeighbour:
+        processChannels<DelayInterpolation::NearestNeighbour>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLinear:
+        processChannels<DelayInterpolation::Linear>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationCubic:
+        processChannels<DelayInterpolation::Cubic>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLagrange3:
+        processChannels<DelayInterpolation::Lagrange3>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLagrange5:
+        processChannels<DelayInterpolation::Lagrange5>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationSinc:
+        processChannels<DelayInterpolation::Sinc>(buffer, lfoOut);
+        break;
+    case DelayInterpolation::kInterpolationThiran:
+    default:
+        processChannels<DelayInterpolation::Thiran>(buffer, lfoOut);
+        break;
+    }
+}
+
+template <typename Interpolator>
+void VibratoProcessor::processChannels (AudioBuffer<float>& buffer, const float* lfoOut)
 {
     ScopedNoDenormals noDenormals;
 
@@ -128,10 +185,8 @@ void VibratoProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     const int numSamples = buffer.getNumSamples();              // How many samples in the buffer for this block?
 
     // working variables
-    int dpw = delayWritePosition;   // delay write position (integer)
-    float dpr;                      // delay read position (real-valued)
     float currentDelay;
-    float ph = lfoPhase;
+    const float sampleRate = float(getSampleRate());
 
     // Go through each channel of audio that's passed in. In this example we apply identical
     // effects to each channel, regardless of how many input channels there are. For some effects, like
@@ -142,15 +197,9 @@ void VibratoProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
         // channelData is an array of length numSamples which contains the audio for one channel
         float* channelData = buffer.getWritePointer(channel);
 
-        // delayData is the circular buffer for implementing delay on this channel
-        float* delayData = delayBuffer.getWritePointer(jmin(channel, delayBuffer.getNumChannels() - 1));
-
-        // Make a temporary copy of any state variables declared in PluginProcessor.h which need to be
-        // maintained between calls to processBlock(). Each channel needs to be processed identically
-        // which means that the activity of processing one channel can't affect the state variable for
-        // the next channel.
-        dpw = delayWritePosition;
-        ph = lfoPhase;
+        // delayChannel is the channel of the circular buffer for implementing delay on this channel
+        const int delayChannel = jmin(channel, delayLine.getNumChannels() - 1);
+        float* state = interpolatorState + delayChannel * DelayInterpolation::stateSize;
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -160,41 +209,28 @@ void VibratoProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
             // Recalculate the read pointer position with respect to the write pointer. A more efficient
             // implementation might increment the read pointer based on the derivative of the LFO without
             // running the whole equation again, but this format makes the operation clearer.
-            currentDelay = parameters.sweepWidthHz * VibratoLFO::getSample(ph, parameters.lfoWaveform);
+            currentDelay = parameters.sweepWidthHz * lfoOut[i];
 
-            // Subtract 3 samples to the delay pointer to make sure we have enough previously written
+            // Add a few samples to the delay to make sure we have enough previously written
             // samples to interpolate with
-            dpr = fmodf(float(dpw - (currentDelay * getSampleRate()) + delayBufferLength - 3.0),
-                        float(delayBufferLength));
-
-            // In this example, the output is the input plus the contents of the delay buffer (weighted by delayMix)
-            // The last term implements a tremolo (variable amplitude) on the whole thing.
-            interpolatedSample = VibratoInterpolation::processSample(parameters.interpolationType,
-                                                                     dpr, delayData, delayBufferLength);
+            interpolatedSample = delayLine.read<Interpolator>(delayChannel, i,
+                currentDelay * sampleRate + float(DelayInterpolation::minDelaySamples), state);
 
             // Store the current information in the delay buffer. With feedback, what we read is
             // included in what gets stored in the buffer, otherwise it's just a simple delay line
             // of the input signal.
-            delayData[dpw] = in;
-
-            // Increment the write pointer at a constant rate. The read pointer will move at different
-            // rates depending on the settings of the LFO, the delay and the sweep width.
-            if (++dpw >= delayBufferLength) dpw = 0;
+            delayLine.write(delayChannel, i, in);
 
             // Store the output sample in the buffer, replacing the input. In the vibrato effect,
             // the delaye sample is the only component of the output (no mixing with the dry signal)
             channelData[i] = interpolatedSample;
-
-            // Update the LFO phase, keeping it in the range 0-1
-            ph += float(parameters.lfoFreqHz * inverseSampleRate);
-            while (ph >= 1.0f) ph -= 1.0f;
         }
     }
 
-    // Having made a local copy of the state variables for each channel, now transfer the result
-    // back to the main state variable so they will be preserved for the next call of processBlock()
-    delayWritePosition = dpw;
-    lfoPhase = ph;
+    // Move the delay line on, ready for the next call of processBlock().
+    // The write position moves on at a constant rate; the read position moves at different rates
+    // depending on the settings of the LFO and the sweep width.
+    delayLine.advance(numSamples);
 
     // In case we have more outputs than inputs, we'll clear any output
     // channels that didn't contain input data, (because these aren't
@@ -1,10 +1,12 @@
 #pragma once
 #include "JuceHeader.h"
 #include "VibratoParameters.h"
+#include "DelayLine.h"
+#include "AutomationScheduler.h"
 
 class VibratoProcessor  : public AudioProcessor
                         , public AudioProcessorValueTreeState::Listener
-                        , public ChangeBroadcaster
+                        , public AutomationScheduler::Owner
 {
 public:
     VibratoProcessor();
@@ -31,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -43,19 +48,31 @@ public:
     VibratoParameters parameters;
 
     // Text summary of pitch shift based current parameter settings, for GUI display
-    String pitchShiftDescription;
+    // (allocates memory, so must not be called on the audio thread)
+    String getPitchShiftDescription() const;
 
     // Responding to parameter changes
     void parameterChanged(const String&, float) override;
 
 private:
-    float lfoPhase;             // Phase of the low-frequency oscillator
-    double inverseSampleRate;   // Cache inverse of sample rate (more efficient to multiply than divide)
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // The processing loop, compiled for each interpolation method, given the block's LFO output
+    template <typename Interpolator> void processChannels(AudioBuffer<float>&, const float* lfoOut);
+
+    // Range of playback speed (1.0 = normal) resulting from current parameter settings
+    std::atomic<float> minPlaybackSpeed, maxPlaybackSpeed;
+
+    BlockLFO lfo;               // Renders each block's modulation once, for all channels
+
+    // Circular buffer for implementing delay
+    DelayLine delayLine;
 
-    // Circular buffer variables for implementing delay
-    AudioSampleBuffer delayBuffer;
-    int delayBufferLength;
-    int delayReadPosition, delayWritePosition;
+    // State for interpolators which need it (one set per channel), and the method it belongs to
+    HeapBlock<float> interpolatorState;
+    DelayInterpolation::Type activeInterpolationType;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VibratoProcessor)
 };
\ No newline at end of file
@@ -39,12 +39,19 @@ FlangerEditor::FlangerEditor (FlangerProcessor& p)
     lfoWaveformCombo.setJustificationType(Justification::centredLeft);
     FlangerLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
+    lfoSyncLabel.setText("LFO Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
     interpTypeLabel.setText("Interpolation Type", dontSendNotification);
     interpTypeLabel.setJustificationType(Justification::right);
     addAndMakeVisible(&interpTypeLabel);
     interpTypeCombo.setEditableText(false);
     interpTypeCombo.setJustificationType(Justification::centredLeft);
-    FlangerInterpolation::populateInterpolationComboBox(interpTypeCombo);
+    DelayInterpolation::populateInterpolationComboBox(interpTypeCombo);
     addAndMakeVisible(interpTypeCombo);
 
     processor.parameters.attachControls(
@@ -55,9 +62,10 @@ FlangerEditor::FlangerEditor (FlangerProcessor& p)
         lfoFreqKnob,
         stereoButton,
         lfoWaveformCombo,
+        lfoSyncCombo,
         interpTypeCombo );
 
-    setSize (60 + 100 * 8 + 10 * (8 - 1), 180);
+    setSize (60 + 100 * 8 + 10 * (8 - 1), 214);
 }
 
 FlangerEditor::~FlangerEditor()
@@ -96,6 +104,11 @@ void FlangerEditor::resized()
     lfoWaveformCombo.setBounds(rowArea);
     widgetsArea.removeFromTop(10);
     rowArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(rowArea.removeFromLeft(120));
+    rowArea.removeFromLeft(10);
+    lfoSyncCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
     interpTypeLabel.setBounds(rowArea.removeFromLeft(120));
     rowArea.removeFromLeft(10);
     interpTypeCombo.setBounds(rowArea);
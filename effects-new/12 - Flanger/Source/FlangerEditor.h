@@ -26,6 +26,7 @@ private:
     BasicKnob lfoFreqKnob; LabeledKnob labeledLfoFreqKnob;
     ToggleButton stereoButton;
     ComboBox lfoWaveformCombo; Label lfoWaveformLabel;
+    ComboBox lfoSyncCombo; Label lfoSyncLabel;
     ComboBox interpTypeCombo; Label interpTypeLabel;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlangerEditor)
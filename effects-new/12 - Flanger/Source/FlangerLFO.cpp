@@ -1,6 +1,4 @@
 #include "FlangerLFO.h"
-#include <cmath>
-#define TWOPI_F 6.283185f
 
 void FlangerLFO::populateWaveformComboBox(ComboBox& cb)
 {
@@ -12,31 +10,18 @@ void FlangerLFO::populateWaveformComboBox(ComboBox& cb)
     cb.addItem("Sawtooth", ++itemNumber);
 }
 
-// Function for calculating "biased" LFO waveforms with output range [0, 1].
-// Phase range [0, 1], output also [0, 1] (not [-1, +1] as for the ordinary Sine function).
-float FlangerLFO::getSample(float phase, Waveform waveform)
+BlockLFO::Waveform FlangerLFO::getBlockWaveform(Waveform waveform)
 {
     switch (waveform)
     {
     case kWaveformTriangle:
-        if (phase < 0.25f)
-            return 0.5f + 2.0f*phase;
-        else if (phase < 0.75f)
-            return 1.0f - 2.0f*(phase - 0.25f);
-        else
-            return 2.0f*(phase - 0.75f);
+        return BlockLFO::kWaveformTriangle;
     case kWaveformSquare:
-        if (phase < 0.5f)
-            return 1.0f;
-        else
-            return 0.0f;
+        return BlockLFO::kWaveformSquare;
     case kWaveformSawtooth:
-        if (phase < 0.5f)
-            return 0.5f + phase;
-        else
-            return phase - 0.5f;
+        return BlockLFO::kWaveformSawtooth;
     case kWaveformSine:
     default:
-        return 0.5f + 0.5f*sinf(TWOPI_F * phase);
+        return BlockLFO::kWaveformSine;
     }
 }
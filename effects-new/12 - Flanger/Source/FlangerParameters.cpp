@@ -52,11 +52,17 @@ const String FlangerParameters::lfoWaveformName = TRANS("LFO");
 const String FlangerParameters::lfoWaveformLabel = "";
 const int FlangerParameters::lfoWaveformEnumCount = 4;
 const int FlangerParameters::lfoWaveformDefault = 0;
+// LFO Sync
+const String FlangerParameters::lfoSyncID = "lfoSync";
+const String FlangerParameters::lfoSyncName = TRANS("LFO Sync");
+const String FlangerParameters::lfoSyncLabel = "";
+const int FlangerParameters::lfoSyncEnumCount = BlockLFO::kNumSyncs;
+const int FlangerParameters::lfoSyncDefault = 0;
 // Interpolation Type
 const String FlangerParameters::interpTypeID = "interpType";
 const String FlangerParameters::interpTypeName = TRANS("Interpolation Type");
 const String FlangerParameters::interpTypeLabel = "";
-const int FlangerParameters::interpTypeEnumCount = 3;
+const int FlangerParameters::interpTypeEnumCount = DelayInterpolation::kNumInterpolations;
 const int FlangerParameters::interpTypeDefault = 1;
 
 AudioProcessorValueTreeState::ParameterLayout FlangerParameters::createParameterLayout()
@@ -110,6 +116,12 @@ AudioProcessorValueTreeState::ParameterLayout FlangerParameters::createParameter
         lfoWaveformLabel,
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, lfoSyncEnumCount - 1, lfoSyncDefault,
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
     params.push_back(std::make_unique<AudioParameterInt>(
         interpTypeID, interpTypeName,
         0, interpTypeEnumCount - 1, interpTypeDefault,
@@ -121,14 +133,15 @@ AudioProcessorValueTreeState::ParameterLayout FlangerParameters::createParameter
 }
 
 FlangerParameters::FlangerParameters(AudioProcessorValueTreeState& vts)
-    : minDelayMs(minDelayDefault)
-    , sweepWidthMs(sweepWidthDefault)
-    , depth(depthDefault)
-    , feedback(feedbackDefault)
-    , lfoFreqHz(lfoFreqDefault)
+    : minDelayMs(minDelayDefault, 0.1f)
+    , sweepWidthMs(sweepWidthDefault, 0.1f)
+    , depth(0.01f * depthDefault, 0.02f)
+    , feedback(0.01f * feedbackDefault, 0.02f)
+    , lfoFreqHz(lfoFreqDefault, 0.05f, SmoothedParameter::kMultiplicative)
     , stereoMode(stereoDefault)
     , lfoWaveform((FlangerLFO::Waveform)lfoWaveformDefault)
-    , interpolationType((FlangerInterpolation::Type)interpTypeDefault)
+    , lfoSync((BlockLFO::Sync)lfoSyncDefault)
+    , interpolationType((DelayInterpolation::Type)interpTypeDefault)
     , valueTreeState(vts)
     , minDelayListener(minDelayMs)
     , sweepWidthListener(sweepWidthMs)
@@ -137,6 +150,7 @@ FlangerParameters::FlangerParameters(AudioProcessorValueTreeState& vts)
     , lfoFreqListener(lfoFreqHz)
     , stereoListener(stereoMode)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , interpTypeListener(interpolationType)
 {
     valueTreeState.addParameterListener(minDelayID, &minDelayListener);
@@ -146,10 +160,8 @@ FlangerParameters::FlangerParameters(AudioProcessorValueTreeState& vts)
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(stereoID, &stereoListener);
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.addParameterListener(interpTypeID, &interpTypeListener);
-
-    depth *= 0.01f;
-    feedback *= 0.01f;
 }
 
 FlangerParameters::~FlangerParameters()
@@ -162,6 +174,7 @@ FlangerParameters::~FlangerParameters()
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(stereoID, &stereoListener);
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.removeParameterListener(interpTypeID, &interpTypeListener);
 }
 
@@ -174,6 +187,7 @@ void FlangerParameters::detachControls()
     lfoFreqAttachment.reset(nullptr);
     stereoAttachment.reset(nullptr);
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     interpTypeAttachment.reset(nullptr);
 }
 
@@ -185,6 +199,7 @@ void FlangerParameters::attachControls(
     Slider& lfoFreqKnob,
     ToggleButton& stereoButton,
     ComboBox& lfoWaveformCombo,
+    ComboBox& lfoSyncCombo,
     ComboBox& interpTypeCombo )
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -197,5 +212,6 @@ void FlangerParameters::attachControls(
     lfoFreqAttachment.reset(new SlAt(valueTreeState, lfoFreqID, lfoFreqKnob));
     stereoAttachment.reset(new TbAt(valueTreeState, stereoID, stereoButton));
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
     interpTypeAttachment.reset(new CbAt(valueTreeState, interpTypeID, interpTypeCombo));
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "JuceHeader.h"
 #include "ParameterListeners.h"
 #include "FlangerLFO.h"
-#include "FlangerInterpolation.h"
+#include "DelayInterpolation.h"
 
 class FlangerParameters
 {
@@ -23,6 +23,8 @@ public:
     static const int stereoEnumCount, stereoDefault;
     static const String lfoWaveformID, lfoWaveformName, lfoWaveformLabel;
     static const int lfoWaveformEnumCount, lfoWaveformDefault;
+    static const String lfoSyncID, lfoSyncName, lfoSyncLabel;
+    static const int lfoSyncEnumCount, lfoSyncDefault;
     static const String interpTypeID, interpTypeName, interpTypeLabel;
     static const int interpTypeEnumCount, interpTypeDefault;
     static AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -40,17 +42,19 @@ public:
         Slider& lfoFreqKnob,
         ToggleButton& stereoToggle,
         ComboBox& lfoWaveformCombo,
+        ComboBox& lfoSyncCombo,
         ComboBox& interpTypeCombo );
 
     // working parameter values
-    float minDelayMs;
-    float sweepWidthMs;
-    float depth;
-    float feedback;
-    float lfoFreqHz;
+    SmoothedParameter minDelayMs;
+    SmoothedParameter sweepWidthMs;
+    SmoothedParameter depth;
+    SmoothedParameter feedback;
+    SmoothedParameter lfoFreqHz;
     bool stereoMode;
     FlangerLFO::Waveform lfoWaveform;
-    FlangerInterpolation::Type interpolationType;
+    BlockLFO::Sync lfoSync;
+    DelayInterpolation::Type interpolationType;
 
 private:
     // Reference to AudioProcessorValueTreeState object that owns the parameter objects
@@ -64,15 +68,17 @@ private:
     std::unique_ptr<AudioProcessorValueTreeState::SliderAttachment> lfoFreqAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ButtonAttachment> stereoAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> lfoSyncAttachment;
     std::unique_ptr<AudioProcessorValueTreeState::ComboBoxAttachment> interpTypeAttachment;
 
     // Listener objects link parameters to working variables
-    FloatListener minDelayListener;
-    FloatListener sweepWidthListener;
-    FloatListener depthListener;
-    FloatListener feedbackListener;
-    FloatListener lfoFreqListener;
+    SmoothedFloatListener minDelayListener;
+    SmoothedFloatListener sweepWidthListener;
+    SmoothedFloatListener depthListener;
+    SmoothedFloatListener feedbackListener;
+    SmoothedFloatListener lfoFreqListener;
     BoolListener stereoListener;
     EnumListener<FlangerLFO::Waveform> lfoWaveformListener;
-    EnumListener<FlangerInterpolation::Type> interpTypeListener;
+    EnumListener<BlockLFO::Sync> lfoSyncListener;
+    EnumListener<DelayInterpolation::Type> interpTypeListener;
 };
\ No newline at end of file
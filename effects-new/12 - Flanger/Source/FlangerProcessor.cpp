@@ -21,10 +21,7 @@ FlangerProcessor::FlangerProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("Flanger"), FlangerParameters::createParameterLayout())
     , parameters(valueTreeState)
-    , lfoPhase(0.0f)
-    , inverseSampleRate(1.0f / 44100.0f)
-    , delayBufferLength(0)
-    , delayWritePosition(0)
+    , activeInterpolationType(parameters.interpolationType)
 {
 }
 
@@ -34,17 +31,24 @@ FlangerProcessor::~FlangerProcessor()
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void FlangerProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void FlangerProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     // Allocate and zero the delay buffer (size will depend on current sample rate)
     // Add 3 extra samples to allow cubic interpolation even at maximum delay
-    double maxDelaySec = 0.001 * FlangerParameters::minDelayMax + FlangerParameters::sweepWidthMax;
-    delayBufferLength = (int)(maxDelaySec * sampleRate) + 3;
-    delayBuffer.setSize(2, delayBufferLength);
-    delayBuffer.clear();
-    lfoPhase = 0.0f;
-
-    inverseSampleRate = 1.0 / sampleRate;
+    double maxDelaySec = 0.001 * (FlangerParameters::minDelayMax + FlangerParameters::sweepWidthMax);
+    delayLine.prepare(getTotalNumInputChannels(), int(maxDelaySec * sampleRate) + 3, maxSamplesPerBlock);
+    interpolatorState.allocate(size_t(delayLine.getNumChannels() * DelayInterpolation::stateSize), true);
+    activeInterpolationType = parameters.interpolationType;
+    lfo.prepare(sampleRate, maxSamplesPerBlock, 2);
+
+    parameters.minDelayMs.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.sweepWidthMs.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.depth.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.feedback.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.lfoFreqHz.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -54,6 +58,63 @@ void FlangerProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void FlangerProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo and position at the start of each block
+    lfo.setSync(parameters.lfoSync);
+    lfo.syncToPlayHead(getPlayHead());
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void FlangerProcessor::processSubBlock (AudioBuffer<float>& buffer)
+{
+    // Any interpolator state belongs to the previous interpolation method
+    if (parameters.interpolationType != activeInterpolationType)
+    {
+        interpolatorState.clear(size_t(delayLine.getNumChannels() * DelayInterpolation::stateSize));
+        activeInterpolationType = parameters.interpolationType;
+    }
+
+    // Render this block of LFO output once for all channels; for stereo flanging, channels other
+    // than the first use a second copy, 90 degrees out of phase with the first
+    const int numSamples = buffer.getNumSamples();
+    lfo.advance(numSamples, parameters.lfoFreqHz.getNextBlock(numSamples));
+    const BlockLFO::Waveform waveform = FlangerLFO::getBlockWaveform(parameters.lfoWaveform);
+    const float* lfoOut = lfo.render(0, waveform, numSamples);
+    const float* quadratureLfoOut = parameters.stereoMode ? lfo.render(1, waveform, numSamples, 0.25f) : lfoOut;
+
+    // Choose the interpolation method once for the whole block, so the per-sample loop in
+    // processChannels() is compiled for each method without any switches
+    switch (activeInterpolationType)
+    {
+    case DelayInterpolation::kInterpolationNearestNeighbour:
+        processChannels<DelayInterpolation::NearestNeighbour>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLinear:
+        processChannels<DelayInterpolation::Linear>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationCubic:
+        processChannels<DelayInterpolation::Cubic>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLagrange3:
+        processChannels<DelayInterpolation::Lagrange3>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationLagrange5:
+        processChannels<DelayInterpolation::Lagrange5>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationSinc:
+        processChannels<DelayInterpolation::Sinc>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    case DelayInterpolation::kInterpolationThiran:
+    default:
+        processChannels<DelayInterpolation::Thiran>(buffer, lfoOut, quadratureLfoOut);
+        break;
+    }
+}
+
+template <typename Interpolator>
+void FlangerProcessor::processChannels (AudioBuffer<float>& buffer, const float* lfoOut, const float* quadratureLfoOut)
 {
     ScopedNoDenormals noDenormals;
 
@@ -63,11 +124,14 @@ void FlangerProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     const int numSamples = buffer.getNumSamples();              // How many samples in the buffer for this block?
 
     // working variables
-    int dpw = delayWritePosition;   // delay write position (integer)
-    float dpr;                      // delay read position (real-valued)
     float currentDelay;
-    float ph = lfoPhase;
-    float channel0EndPhase = lfoPhase;
+    const float sampleRate = float(getSampleRate());
+
+    // Smoothed parameter values, for every sample of this block
+    const float* minDelayMs = parameters.minDelayMs.getNextBlock(numSamples);
+    const float* sweepWidthMs = parameters.sweepWidthMs.getNextBlock(numSamples);
+    const float* depth = parameters.depth.getNextBlock(numSamples);
+    const float* feedback = parameters.feedback.getNextBlock(numSamples);
 
     // Go through each channel of audio that's passed in. In this example we apply identical
     // effects to each channel, regardless of how many input channels there are. For some effects, like
@@ -78,19 +142,11 @@ void FlangerProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
         // channelData is an array of length numSamples which contains the audio for one channel
         float* channelData = buffer.getWritePointer(channel);
 
-        // delayData is the circular buffer for implementing delay on this channel
-        float* delayData = delayBuffer.getWritePointer(jmin(channel, delayBuffer.getNumChannels() - 1));
+        // delayChannel is the channel of the circular buffer for implementing delay on this channel
+        const int delayChannel = jmin(channel, delayLine.getNumChannels() - 1);
+        float* state = interpolatorState + delayChannel * DelayInterpolation::stateSize;
 
-        // Make a temporary copy of any state variables declared in PluginProcessor.h which need to be
-        // maintained between calls to processBlock(). Each channel needs to be processed identically
-        // which means that the activity of processing one channel can't affect the state variable for
-        // the next channel.
-        dpw = delayWritePosition;
-        ph = lfoPhase;
-
-        // For stereo flanging, keep the channels 90 degrees out of phase with each other
-        if (parameters.stereoMode && channel != 0)
-            ph = fmodf(ph + 0.25f, 1.0f);
+        const float* lfoSamples = channel == 0 ? lfoOut : quadratureLfoOut;
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -100,42 +156,25 @@ void FlangerProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
             // Recalculate the read pointer position with respect to the write pointer. A more efficient
             // implementation might increment the read pointer based on the derivative of the LFO without
             // running the whole equation again, but this format makes the operation clearer.
-            float lfoSample = FlangerLFO::getSample(ph, parameters.lfoWaveform);
-            currentDelay = 0.001f * (parameters.minDelayMs + lfoSample * parameters.sweepWidthMs);
-            dpr = fmodf(float(dpw) - float(currentDelay * getSampleRate()) + float(delayBufferLength),
-                        float(delayBufferLength));
+            currentDelay = 0.001f * (minDelayMs[i] + lfoSamples[i] * sweepWidthMs[i]);
 
             // In this example, the output is the input plus the contents of the delay buffer (weighted by delayMix)
             // The last term implements a tremolo (variable amplitude) on the whole thing.
-            interpolatedSample = FlangerInterpolation::processSample(parameters.interpolationType,
-                                                                     dpr, delayData, delayBufferLength);
+            interpolatedSample = delayLine.read<Interpolator>(delayChannel, i, currentDelay * sampleRate, state);
             // Store the current information in the delay buffer. With feedback, what we read is
             // included in what gets stored in the buffer, otherwise it's just a simple delay line
             // of the input signal.
-            delayData[dpw] = in + (interpolatedSample * parameters.feedback);
-
-            // Increment the write pointer at a constant rate. The read pointer will move at different
-            // rates depending on the settings of the LFO, the delay and the sweep width.
-            if (++dpw >= delayBufferLength) dpw = 0;
+            delayLine.write(delayChannel, i, in + (interpolatedSample * feedback[i]));
 
             // Store the output sample in the buffer, replacing the input
-            channelData[i] = in + parameters.depth * interpolatedSample;
-
-            // Update the LFO phase, keeping it in the range 0-1
-            ph += float(parameters.lfoFreqHz * inverseSampleRate);
-            while (ph >= 1.0f) ph -= 1.0f;
+            channelData[i] = in + depth[i] * interpolatedSample;
         }
-
-        // Use channel 0 only to keep the phase in sync between calls to processBlock()
-        // Otherwise quadrature phase on multiple channels will create problems.
-        if (channel == 0)
-            channel0EndPhase = ph;
     }
 
-    // Having made a local copy of the state variables for each channel, now transfer the result
-    // back to the main state variable so they will be preserved for the next call of processBlock()
-    delayWritePosition = dpw;
-    lfoPhase = channel0EndPhase;
+    // Move the delay line on, ready for the next call of processBlock().
+    // The write position moves on at a constant rate; the read position moves at different rates
+    // depending on the settings of the LFO, the delay and the sweep width.
+    delayLine.advance(numSamples);
 
     // In case we have more outputs than inputs, we'll clear any output
     // channels that didn't contain input data, (because these aren't
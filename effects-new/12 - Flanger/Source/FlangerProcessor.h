@@ -1,8 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "FlangerParameters.h"
+#include "DelayLine.h"
+#include "AutomationScheduler.h"
 
 class FlangerProcessor : public AudioProcessor
+                       , public AutomationScheduler::Owner
 {
 public:
     FlangerProcessor();
@@ -29,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -41,13 +47,22 @@ public:
     FlangerParameters parameters;
 
 private:
-    float lfoPhase;             // Phase of the low-frequency oscillator
-    double inverseSampleRate;   // Cache inverse of sample rate (more efficient to multiply than divide)
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // The processing loop, compiled for each interpolation method, given the block's LFO output
+    template <typename Interpolator>
+    void processChannels(AudioBuffer<float>&, const float* lfoOut, const float* quadratureLfoOut);
+
+    BlockLFO lfo;               // Renders each block's modulation once (twice for stereo)
+
+    // Circular buffer for implementing delay
+    DelayLine delayLine;
 
-    // Circular buffer variables for implementing delay
-    AudioSampleBuffer delayBuffer;
-    int delayBufferLength;
-    int delayWritePosition;
+    // State for interpolators which need it (one set per channel), and the method it belongs to
+    HeapBlock<float> interpolatorState;
+    DelayInterpolation::Type activeInterpolationType;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlangerProcessor)
 };
\ No newline at end of file
@@ -57,12 +57,19 @@ ChorusEditor::ChorusEditor(ChorusProcessor& p)
     lfoWaveformCombo.setJustificationType(Justification::centredLeft);
     ChorusLFO::populateWaveformComboBox(lfoWaveformCombo);
     addAndMakeVisible(lfoWaveformCombo);
+    lfoSyncLabel.setText("LFO Sync", dontSendNotification);
+    lfoSyncLabel.setJustificationType(Justification::right);
+    addAndMakeVisible(&lfoSyncLabel);
+    lfoSyncCombo.setEditableText(false);
+    lfoSyncCombo.setJustificationType(Justification::centredLeft);
+    BlockLFO::populateSyncComboBox(lfoSyncCombo);
+    addAndMakeVisible(lfoSyncCombo);
     interpTypeLabel.setText("Interpolation Type", dontSendNotification);
     interpTypeLabel.setJustificationType(Justification::right);
     addAndMakeVisible(&interpTypeLabel);
     interpTypeCombo.setEditableText(false);
     interpTypeCombo.setJustificationType(Justification::centredLeft);
-    ChorusInterpolation::populateInterpolationComboBox(interpTypeCombo);
+    DelayInterpolation::populateInterpolationComboBox(interpTypeCombo);
     addAndMakeVisible(interpTypeCombo);
 
     processor.parameters.attachControls(
@@ -73,9 +80,10 @@ ChorusEditor::ChorusEditor(ChorusProcessor& p)
         lfoFreqKnob,
         stereoButton,
         lfoWaveformCombo,
+        lfoSyncCombo,
         interpTypeCombo );
 
-    setSize (60 + 100 * 8 + 10 * (8 - 1), 180);
+    setSize (60 + 100 * 8 + 10 * (8 - 1), 214);
 }
 
 ChorusEditor::~ChorusEditor()
@@ -114,6 +122,11 @@ void ChorusEditor::resized()
     lfoWaveformCombo.setBounds(rowArea);
     widgetsArea.removeFromTop(10);
     rowArea = widgetsArea.removeFromTop(24);
+    lfoSyncLabel.setBounds(rowArea.removeFromLeft(120));
+    rowArea.removeFromLeft(10);
+    lfoSyncCombo.setBounds(rowArea);
+    widgetsArea.removeFromTop(10);
+    rowArea = widgetsArea.removeFromTop(24);
     interpTypeLabel.setBounds(rowArea.removeFromLeft(120));
     rowArea.removeFromLeft(10);
     interpTypeCombo.setBounds(rowArea);
@@ -52,11 +52,17 @@ const String ChorusParameters::lfoWaveformName = TRANS("LFO");
 const String ChorusParameters::lfoWaveformLabel = "";
 const int ChorusParameters::lfoWaveformEnumCount = 4;
 const int ChorusParameters::lfoWaveformDefault = 0;
+// LFO Sync
+const String ChorusParameters::lfoSyncID = "lfoSync";
+const String ChorusParameters::lfoSyncName = TRANS("LFO Sync");
+const String ChorusParameters::lfoSyncLabel = "";
+const int ChorusParameters::lfoSyncEnumCount = BlockLFO::kNumSyncs;
+const int ChorusParameters::lfoSyncDefault = 0;
 // Interpolation Type
 const String ChorusParameters::interpTypeID = "interpType";
 const String ChorusParameters::interpTypeName = TRANS("Interpolation Type");
 const String ChorusParameters::interpTypeLabel = "";
-const int ChorusParameters::interpTypeEnumCount = 3;
+const int ChorusParameters::interpTypeEnumCount = DelayInterpolation::kNumInterpolations;
 const int ChorusParameters::interpTypeDefault = 1;
 
 AudioProcessorValueTreeState::ParameterLayout ChorusParameters::createParameterLayout()
@@ -110,6 +116,12 @@ AudioProcessorValueTreeState::ParameterLayout ChorusParameters::createParameterL
         lfoWaveformLabel,
         [](int value, int maxLength) { return String(value).substring(0, maxLength); },
         [](const String& text) { return text.getIntValue(); }));
+    params.push_back(std::make_unique<AudioParameterInt>(
+        lfoSyncID, lfoSyncName,
+        0, lfoSyncEnumCount - 1, lfoSyncDefault,
+        lfoSyncLabel,
+        [](int value, int maxLength) { return String(value).substring(0, maxLength); },
+        [](const String& text) { return text.getIntValue(); }));
     params.push_back(std::make_unique<AudioParameterInt>(
         interpTypeID, interpTypeName,
         0, interpTypeEnumCount - 1, interpTypeDefault,
@@ -121,14 +133,15 @@ AudioProcessorValueTreeState::ParameterLayout ChorusParameters::createParameterL
 }
 
 ChorusParameters::ChorusParameters(AudioProcessorValueTreeState& vts)
-    : minDelayMs(minDelayDefault)
-    , sweepWidthMs(sweepWidthDefault)
-    , depth(depthDefault)
+    : minDelayMs(minDelayDefault, 0.1f)
+    , sweepWidthMs(sweepWidthDefault, 0.1f)
+    , depth(0.01f * depthDefault, 0.02f)
     , voiceCount(int(voiceCountDefault))
-    , lfoFreqHz(lfoFreqDefault)
+    , lfoFreqHz(lfoFreqDefault, 0.05f, SmoothedParameter::kMultiplicative)
     , stereoMode(stereoDefault)
     , lfoWaveform((ChorusLFO::Waveform)lfoWaveformDefault)
-    , interpolationType((ChorusInterpolation::Type)interpTypeDefault)
+    , lfoSync((BlockLFO::Sync)lfoSyncDefault)
+    , interpolationType((DelayInterpolation::Type)interpTypeDefault)
     , valueTreeState(vts)
     , minDelayListener(minDelayMs)
     , sweepWidthListener(sweepWidthMs)
@@ -137,6 +150,7 @@ ChorusParameters::ChorusParameters(AudioProcessorValueTreeState& vts)
     , lfoFreqListener(lfoFreqHz)
     , stereoListener(stereoMode)
     , lfoWaveformListener(lfoWaveform)
+    , lfoSyncListener(lfoSync)
     , interpTypeListener(interpolationType)
 {
     valueTreeState.addParameterListener(minDelayID, &minDelayListener);
@@ -146,9 +160,8 @@ ChorusParameters::ChorusParameters(AudioProcessorValueTreeState& vts)
     valueTreeState.addParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.addParameterListener(stereoID, &stereoListener);
     valueTreeState.addParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.addParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.addParameterListener(interpTypeID, &interpTypeListener);
-
-    depth *= 0.01f;
 }
 
 ChorusParameters::~ChorusParameters()
@@ -161,6 +174,7 @@ ChorusParameters::~ChorusParameters()
     valueTreeState.removeParameterListener(lfoFreqID, &lfoFreqListener);
     valueTreeState.removeParameterListener(stereoID, &stereoListener);
     valueTreeState.removeParameterListener(lfoWaveformID, &lfoWaveformListener);
+    valueTreeState.removeParameterListener(lfoSyncID, &lfoSyncListener);
     valueTreeState.removeParameterListener(interpTypeID, &interpTypeListener);
 }
 
@@ -173,6 +187,7 @@ void ChorusParameters::detachControls()
     lfoFreqAttachment.reset(nullptr);
     stereoAttachment.reset(nullptr);
     lfoWaveformAttachment.reset(nullptr);
+    lfoSyncAttachment.reset(nullptr);
     interpTypeAttachment.reset(nullptr);
 }
 
@@ -184,6 +199,7 @@ void ChorusParameters::attachControls(
     Slider& lfoFreqKnob,
     ToggleButton& stereoButton,
     ComboBox& lfoWaveformCombo,
+    ComboBox& lfoSyncCombo,
     ComboBox& interpTypeCombo )
 {
     using CbAt = AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -196,5 +212,6 @@ void ChorusParameters::attachControls(
     lfoFreqAttachment.reset(new SlAt(valueTreeState, lfoFreqID, lfoFreqKnob));
     stereoAttachment.reset(new TbAt(valueTreeState, stereoID, stereoButton));
     lfoWaveformAttachment.reset(new CbAt(valueTreeState, lfoWaveformID, lfoWaveformCombo));
+    lfoSyncAttachment.reset(new CbAt(valueTreeState, lfoSyncID, lfoSyncCombo));
     interpTypeAttachment.reset(new CbAt(valueTreeState, interpTypeID, interpTypeCombo));
 }
\ No newline at end of file
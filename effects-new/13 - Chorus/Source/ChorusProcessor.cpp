@@ -21,10 +21,8 @@ ChorusProcessor::ChorusProcessor()
                      )
     , valueTreeState(*this, nullptr, Identifier("Chorus"), ChorusParameters::createParameterLayout())
     , parameters(valueTreeState)
-    , lfoPhase(0.0f)
-    , inverseSampleRate(1.0f / 44100.0f)
-    , delayBufferLength(0)
-    , delayWritePosition(0)
+    , tapsPerChannel(0)
+    , activeInterpolationType(parameters.interpolationType)
 {
 }
 
@@ -34,17 +32,24 @@ ChorusProcessor::~ChorusProcessor()
 }
 
 // Prepare to process audio (always called at least once before processBlock)
-void ChorusProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
+void ChorusProcessor::prepareToPlay (double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     // Allocate and zero the delay buffer (size will depend on current sample rate)
     // Add 3 extra samples to allow cubic interpolation even at maximum delay
-    double maxDelaySec = 0.001 * ChorusParameters::minDelayMax + ChorusParameters::sweepWidthMax;
-    delayBufferLength = (int)(maxDelaySec * sampleRate) + 3;
-    delayBuffer.setSize(2, delayBufferLength);
-    delayBuffer.clear();
-    lfoPhase = 0.0f;
-
-    inverseSampleRate = 1.0 / sampleRate;
+    double maxDelaySec = 0.001 * (ChorusParameters::minDelayMax + ChorusParameters::sweepWidthMax);
+    delayLine.prepare(getTotalNumInputChannels(), int(maxDelaySec * sampleRate) + 3, maxSamplesPerBlock);
+    tapsPerChannel = int(ChorusParameters::voiceCountMax) - 1;
+    interpolatorState.allocate(size_t(delayLine.getNumChannels() * tapsPerChannel * DelayInterpolation::stateSize), true);
+    activeInterpolationType = parameters.interpolationType;
+    lfo.prepare(sampleRate, maxSamplesPerBlock, tapsPerChannel);
+
+    parameters.minDelayMs.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.sweepWidthMs.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.depth.prepare(sampleRate, maxSamplesPerBlock);
+    parameters.lfoFreqHz.prepare(sampleRate, maxSamplesPerBlock);
 }
 
 // Audio processing finished; release any allocated memory
@@ -54,6 +59,66 @@ void ChorusProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void ChorusProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    // Tempo sync (if selected) follows the host's tempo and position at the start of each block
+    lfo.setSync(parameters.lfoSync);
+    lfo.syncToPlayHead(getPlayHead());
+
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void ChorusProcessor::processSubBlock (AudioBuffer<float>& buffer)
+{
+    // Any interpolator state belongs to the previous interpolation method
+    if (parameters.interpolationType != activeInterpolationType)
+    {
+        interpolatorState.clear(size_t(delayLine.getNumChannels() * tapsPerChannel * DelayInterpolation::stateSize));
+        activeInterpolationType = parameters.interpolationType;
+    }
+
+    // Render this block of LFO output once for each delayed voice (shared by all channels).
+    // All voices use the same LFO, but with different phase offsets: a 3-voice chorus uses two
+    // voices in quadrature phase (90 degrees apart); otherwise, the voice phases are spread evenly
+    // around the unit circle. (For 2-voice chorus, there is only one delayed voice.)
+    const int numSamples = buffer.getNumSamples();
+    lfo.advance(numSamples, parameters.lfoFreqHz.getNextBlock(numSamples));
+    const BlockLFO::Waveform waveform = ChorusLFO::getBlockWaveform(parameters.lfoWaveform);
+    const float phaseIncrement = parameters.voiceCount < 3 ? 0.25f : 1.0f / float(parameters.voiceCount - 1);
+    for (int j = 0; j < jmin(parameters.voiceCount - 1, tapsPerChannel); ++j)
+        lfo.render(j, waveform, numSamples, j * phaseIncrement);
+
+    // Choose the interpolation method once for the whole block, so the per-sample loop in
+    // processChannels() is compiled for each method without any switches
+    switch (activeInterpolationType)
+    {
+    case DelayInterpolation::kInterpolationNearestNeighbour:
+        processChannels<DelayInterpolation::NearestNeighbour>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationLinear:
+        processChannels<DelayInterpolation::Linear>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationCubic:
+        processChannels<DelayInterpolation::Cubic>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationLagrange3:
+        processChannels<DelayInterpolation::Lagrange3>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationLagrange5:
+        processChannels<DelayInterpolation::Lagrange5>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationSinc:
+        processChannels<DelayInterpolation::Sinc>(buffer);
+        break;
+    case DelayInterpolation::kInterpolationThiran:
+    default:
+        processChannels<DelayInterpolation::Thiran>(buffer);
+        break;
+    }
+}
+
+template <typename Interpolator>
+void ChorusProcessor::processChannels (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -63,10 +128,14 @@ void ChorusProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
     const int numSamples = buffer.getNumSamples();              // How many samples in the buffer for this block?
 
     // working variables
-    int dpw = delayWritePosition;   // delay write position (integer)
-    float dpr;                      // delay read position (real-valued)
     float currentDelay;
-    float ph = lfoPhase;
+    const int numDelayedVoices = jmin(parameters.voiceCount - 1, tapsPerChannel);
+    const float sampleRate = float(getSampleRate());
+
+    // Smoothed parameter values, for every sample of this block
+    const float* minDelayMs = parameters.minDelayMs.getNextBlock(numSamples);
+    const float* sweepWidthMs = parameters.sweepWidthMs.getNextBlock(numSamples);
+    const float* depth = parameters.depth.getNextBlock(numSamples);
 
     // Go through each channel of audio that's passed in. In this example we apply identical
     // effects to each channel, regardless of how many input channels there are. For some effects, like
@@ -77,27 +146,21 @@ void ChorusProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
         // channelData is an array of length numSamples which contains the audio for one channel
         float* channelData = buffer.getWritePointer(channel);
 
-        // delayData is the circular buffer for implementing delay on this channel
-        float* delayData = delayBuffer.getWritePointer(jmin(channel, delayBuffer.getNumChannels() - 1));
-
-        // Make a temporary copy of any state variables declared in PluginProcessor.h which need to be
-        // maintained between calls to processBlock(). Each channel needs to be processed identically
-        // which means that the activity of processing one channel can't affect the state variable for
-        // the next channel.
-        dpw = delayWritePosition;
-        ph = lfoPhase;
+        // delayChannel is the channel of the circular buffer for implementing delay on this channel
+        const int delayChannel = jmin(channel, delayLine.getNumChannels() - 1);
+        float* state = interpolatorState + delayChannel * tapsPerChannel * DelayInterpolation::stateSize;
 
         for (int i = 0; i < numSamples; ++i)
         {
             const float in = channelData[i];
             float interpolatedSample = 0.0f;
-            float phaseOffset = 0.0f;
             float weight;
 
             // Chorus can have more than 2 voices (where the original, undelayed signal counts as a voice).
-            // In this implementation, all voices use the same LFO, but with different phase offsets. It
-            // is also possible to use different waveforms and different frequencies for each voice.
-            for (int j = 0; j < parameters.voiceCount - 1; ++j)
+            // In this implementation, all voices use the same LFO, but with different phase offsets (see
+            // processSubBlock()). It is also possible to use different waveforms and different frequencies
+            // for each voice.
+            for (int j = 0; j < numDelayedVoices; ++j)
             {
                 if (parameters.stereoMode && (parameters.voiceCount > 2))
                 {
@@ -119,46 +182,27 @@ void ChorusProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
                 // Add the voice to the mix if it has nonzero weight
                 if (weight != 0.0f)
                 {
-                    float lfoSample = ChorusLFO::getSample(fmodf(ph + phaseOffset, 1.0f), parameters.lfoWaveform);
-                    currentDelay = 0.001f * (parameters.minDelayMs + lfoSample * parameters.sweepWidthMs);
-                    dpr = fmodf(float(dpw) - float(currentDelay * getSampleRate()) + float(delayBufferLength),
-                        float(delayBufferLength));
+                    currentDelay = 0.001f * (minDelayMs[i] + lfo.getOutput(j)[i] * sweepWidthMs[i]);
 
                     // In this example, the output is the input plus the contents of the delay buffer (weighted by delayMix)
                     // The last term implements a tremolo (variable amplitude) on the whole thing.
-                    interpolatedSample = ChorusInterpolation::processSample(parameters.interpolationType,
-                                                                            dpr, delayData, delayBufferLength);
+                    interpolatedSample = delayLine.read<Interpolator>(delayChannel, i, currentDelay * sampleRate,
+                                                                      state + j * DelayInterpolation::stateSize);
 
                     // Store the output sample in the buffer, which starts by containing the input sample
-                    channelData[i] += parameters.depth * weight * interpolatedSample;
+                    channelData[i] += depth[i] * weight * interpolatedSample;
                 }
-
-                // 3-voice chorus uses two voices in quadrature phase (90 degrees apart). Otherwise,
-                // spread the voice phases evenly around the unit circle. (For 2-voice chorus, this
-                // code doesn't matter since the loop only runs once.)
-                if (parameters.voiceCount < 3)
-                    phaseOffset += 0.25f;
-                else
-                    phaseOffset += 1.0f / (float)(parameters.voiceCount - 1);
             }
 
             // Store the current input in the delay buffer (no feedback in a chorus, unlike a flanger).
-            delayData[dpw] = in;
-
-            // Increment the write pointer at a constant rate. The read pointer will move at different
-            // rates depending on the settings of the LFO, the delay and the sweep width.
-            if (++dpw >= delayBufferLength) dpw = 0;
-
-            // Update the LFO phase, keeping it in the range 0-1
-            ph += float(parameters.lfoFreqHz * inverseSampleRate);
-            while (ph >= 1.0f) ph -= 1.0f;
+            delayLine.write(delayChannel, i, in);
         }
     }
 
-    // Having made a local copy of the state variables for each channel, now transfer the result
-    // back to the main state variable so they will be preserved for the next call of processBlock()
-    delayWritePosition = dpw;
-    lfoPhase = ph;
+    // Move the delay line on, ready for the next call of processBlock().
+    // The write position moves on at a constant rate; the read positions move at different rates
+    // depending on the settings of the LFO, the delay and the sweep width.
+    delayLine.advance(numSamples);
 
     // In case we have more outputs than inputs, we'll clear any output
     // channels that didn't contain input data, (because these aren't
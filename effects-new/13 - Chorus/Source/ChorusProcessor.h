@@ -1,8 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "ChorusParameters.h"
+#include "DelayLine.h"
+#include "AutomationScheduler.h"
 
 class ChorusProcessor : public AudioProcessor
+                      , public AutomationScheduler::Owner
 {
 public:
     ChorusProcessor();
@@ -29,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -41,13 +47,23 @@ public:
     ChorusParameters parameters;
 
 private:
-    float lfoPhase;             // Phase of the low-frequency oscillator
-    double inverseSampleRate;   // Cache inverse of sample rate (more efficient to multiply than divide)
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
+    // The processing loop, compiled for each interpolation method
+    template <typename Interpolator> void processChannels(AudioBuffer<float>&);
+
+    BlockLFO lfo;               // Renders each block's modulation once per voice, for all channels
+
+    // Circular buffer for implementing delay
+    DelayLine delayLine;
 
-    // Circular buffer variables for implementing delay
-    AudioSampleBuffer delayBuffer;
-    int delayBufferLength;
-    int delayWritePosition;
+    // State for interpolators which need it (one set per delayed voice, per channel),
+    // and the method it belongs to
+    HeapBlock<float> interpolatorState;
+    int tapsPerChannel;
+    DelayInterpolation::Type activeInterpolationType;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusProcessor)
 };
\ No newline at end of file
@@ -70,6 +70,9 @@ bool ReverbProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 // Prepare to process audio (always called at least once before processBlock)
 void ReverbProcessor::prepareToPlay(double sampleRate, int maxSamplesPerBlock)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     if (maxSamplesPerBlock != tempInput.getNumSamples())
     {
         mverb.reset();
@@ -87,6 +90,12 @@ void ReverbProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void ReverbProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void ReverbProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
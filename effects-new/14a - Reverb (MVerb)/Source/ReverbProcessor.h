@@ -2,9 +2,11 @@
 #include "JuceHeader.h"
 #include "ReverbParameters.h"
 #include "MVerb.h"
+#include "AutomationScheduler.h"
 
 class ReverbProcessor   : public AudioProcessor
                         , public AudioProcessorValueTreeState::Listener
+                        , public AutomationScheduler::Owner
 {
 public:
     ReverbProcessor();
@@ -31,6 +33,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -49,6 +54,10 @@ public:
     MVerb<float> mverb;
 
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
     AudioSampleBuffer tempInput, tempOutput;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReverbProcessor)
@@ -61,6 +61,9 @@ void JuceVerbProcessor::parameterChanged(const String& paramID, float newValue)
 // Prepare to process audio (always called at least once before processBlock)
 void JuceVerbProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     reverb.setSampleRate(sampleRate);
 }
 
@@ -71,6 +74,12 @@ void JuceVerbProcessor::releaseResources()
 
 // Process one buffer ("block") of data
 void JuceVerbProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+{
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void JuceVerbProcessor::processSubBlock (AudioBuffer<float>& buffer)
 {
     ScopedNoDenormals noDenormals;
 
@@ -1,9 +1,11 @@
 #pragma once
 #include "JuceHeader.h"
 #include "JuceVerbParameters.h"
+#include "AutomationScheduler.h"
 
 class JuceVerbProcessor : public AudioProcessor
                         , public AudioProcessorValueTreeState::Listener
+                        , public AutomationScheduler::Owner
 {
 public:
     JuceVerbProcessor();
@@ -30,6 +32,9 @@ public:
     void releaseResources() override;
     void processBlock (AudioBuffer<float>&, MidiBuffer&) override;
 
+    // Sample-accurate parameter changes (see AutomationScheduler.h)
+    AutomationScheduler& getAutomationScheduler() override { return automation; }
+
     // Enabling the host to save and restore state
     void getStateInformation (MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
@@ -45,6 +50,10 @@ public:
     void parameterChanged(const String&, float) override;
 
 private:
+    // Splits each block at the times of scheduled parameter changes
+    AutomationScheduler automation;
+    void processSubBlock(AudioBuffer<float>&);
+
     Reverb reverb;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JuceVerbProcessor)
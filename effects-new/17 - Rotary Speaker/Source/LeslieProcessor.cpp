@@ -48,6 +48,9 @@ void LeslieProcessor::parameterChanged(const String&, float)
 // Prepare to process audio (always called at least once before processBlock)
 void LeslieProcessor::prepareToPlay (double sampleRate, int /*maxSamplesPerBlock*/)
 {
+    // Scheduled parameter changes are timed from here
+    automation.reset();
+
     leslie.init(sampleRate);
 }
 
@@ -60,10 +63,6 @@ void LeslieProcessor::releaseResources()
 // Process one buffer ("block") of data
 void LeslieProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
 {
-    ScopedNoDenormals noDenormals;
-    const float *inBuffers[2] = { buffer.getReadPointer(0), buffer.getReadPointer(1) };
-    float* outBuffers[2] = { buffer.getWritePointer(0), buffer.getWritePointer(1) };
-
     MidiBuffer::Iterator it(midiMessages);
     MidiMessage msg;
     int samplePos;
@@ -94,6 +93,16 @@ void LeslieProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi
     }
     midiMessages.clear(0, buffer.getNumSamples());
 
+    automation.processBlock(buffer, [this](AudioBuffer<float>& subBlock) { processSubBlock(subBlock); });
+}
+
+// Process part of a block, during which no scheduled parameter changes occur
+void LeslieProcessor::processSubBlock (AudioBuffer<float>& buffer)
+{
+    ScopedNoDenormals noDenormals;
+    const float *inBuffers[2] = { buffer.getReadPointer(0), buffer.getReadPointer(1) };
+    float* outBuffers[2] = { buffer.getWritePointer(0), buffer.getWritePointer(1) };
+
     leslie.render(buffer.getNumSamples(), inBuffers, outBuffers);
 }
 
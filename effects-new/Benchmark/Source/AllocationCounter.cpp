@@ -0,0 +1,91 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<bool> countingEnabled { false };
+static std::atomic<int64_t> allocationCount { 0 };
+
+static inline void noteAllocation()
+{
+    if (countingEnabled.load(std::memory_order_relaxed))
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocationCounter::startCounting()
+{
+    allocationCount.store(0);
+    countingEnabled.store(true);
+}
+
+int64_t AllocationCounter::stopCounting()
+{
+    countingEnabled.store(false);
+    return allocationCount.load();
+}
+
+#if defined(__GLIBC__)
+
+// glibc exports its allocator under these names, so the standard entry points can be
+// replaced by thin counting wrappers. operator new calls malloc(), so it is covered too.
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+
+    void* malloc(size_t size)
+    {
+        noteAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        noteAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        noteAllocation();
+        return __libc_realloc(ptr, size);
+    }
+}
+
+#else
+
+void* operator new(std::size_t size)
+{
+    noteAllocation();
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    noteAllocation();
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    noteAllocation();
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    noteAllocation();
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+/*  AllocationCounter counts heap allocations made (by any thread) while counting is enabled.
+    EffectsBench enables it only around each call to processBlock(), so the count shows
+    whether an effect allocates memory on the audio thread, which it never should.
+
+    On Linux (glibc), malloc(), calloc() and realloc() are intercepted, which also covers
+    operator new, HeapBlock and AudioBuffer. Elsewhere only operator new is intercepted.
+*/
+
+struct AllocationCounter
+{
+    static void startCounting();
+    static int64_t stopCounting();     // returns count since startCounting()
+};
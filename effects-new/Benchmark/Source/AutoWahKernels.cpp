@@ -0,0 +1,195 @@
+/*  Kernel benchmarks for the Auto-Wah effect (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "AutoWahFilter.h"
+#include "ResonantLowpassFilter.h"
+
+namespace
+{
+    // The plug-in's default settings, plus some envelope modulation, at about the default
+    // attack and decay times
+    AutoWahFilter::Sweep makeTestSweep(double sampleRate)
+    {
+        const double ONE_OVER_E = 1.0 / 2.71828182845904523536;
+        AutoWahFilter::Sweep sweep;
+        sweep.inverseSampleRate = 1.0 / sampleRate;
+        sweep.centreFreqHz = 350.0f;
+        sweep.lfoWidthHz = 1000.0f;
+        sweep.envWidthHz = 1000.0f;
+        sweep.filterQ = 5.0f;
+        sweep.attackMultiplier = std::pow(ONE_OVER_E, sweep.inverseSampleRate / 0.006);
+        sweep.decayMultiplier = std::pow(ONE_OVER_E, sweep.inverseSampleRate / 0.2);
+        sweep.lfoPhase = 0.0f;
+        sweep.lfoPhaseIncrement = float(2.0 * sweep.inverseSampleRate);
+        sweep.intervalSamples = 1;
+        sweep.detector = AutoWahFilter::kDetectorPeak;
+        sweep.linked = false;
+        return sweep;
+    }
+
+    // The original AutoWahProcessor loop, for one channel: new biquad coefficients every sample
+    struct ReferenceChannel
+    {
+        ResonantLowpassFilter filter;
+        double envelope = 0.0;
+
+        void reset() { filter.reset(); envelope = 0.0; }
+
+        float processSamples(float* samples, int numSamples, const AutoWahFilter::Sweep& sweep)
+        {
+            const float TWOPI_F = 6.283185f;
+            const double kWahwahFilterGain = 0.5;
+            float phi = sweep.lfoPhase;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float in = samples[i];
+                float centreFrequency = sweep.centreFreqHz;
+
+                if (fabs(in) > envelope)
+                    envelope += (1.0 - sweep.attackMultiplier) * (fabs(in) - envelope);
+                else
+                    envelope *= sweep.decayMultiplier;
+
+                if (sweep.lfoWidthHz > 0.0f)
+                    centreFrequency += sweep.lfoWidthHz * (0.5f + 0.5f * sinf(TWOPI_F * phi));
+                if (sweep.envWidthHz > 0.0f)
+                    centreFrequency += sweep.envWidthHz * float(envelope);
+
+                filter.makeResonantLowpass(sweep.inverseSampleRate, centreFrequency,
+                                           sweep.filterQ, kWahwahFilterGain);
+                samples[i] = filter.processSingleSample(in);
+
+                phi += sweep.lfoPhaseIncrement;
+                while (phi > 1.0f) phi -= 1.0f;
+            }
+            return phi;
+        }
+    };
+}
+
+// AutoWahFilter, updating its cutoff at each control rate, against the original per-sample
+// biquad design, on one channel of noise, so times are per channel. With a fixed cutoff, the
+// two filters differ only by rounding, but while it moves they respond a little differently
+// (their states mean different things); at the slower rates, the cutoff also lags up to one
+// control interval behind, which is most of the "error".
+void benchmarkAutoWah(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+    float* referenceOut = referenceOutput.getWritePointer(0);
+    float* optimizedOut = optimizedOutput.getWritePointer(0);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        // The LFO phase carries on from block to block, as in the processor, and every pass
+        // starts afresh, so the outputs can be compared
+        ReferenceChannel reference;
+        auto sweep = makeTestSweep(settings.sampleRate);
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            if (start == 0) { reference.reset(); sweep.lfoPhase = 0.0f; }
+            FloatVectorOperations::copy(referenceOut + start, in + start, count);
+            sweep.lfoPhase = reference.processSamples(referenceOut + start, count, sweep);
+        });
+        KernelBenchmarks::printResult("auto-wah", blockSize, "reference", referenceNs, referenceNs, {});
+
+        for (int rate = 0; rate < AutoWahFilter::kNumControlRates; ++rate)
+        {
+            AutoWahFilter filter;
+            filter.prepare(1);
+            sweep = makeTestSweep(settings.sampleRate);
+            sweep.intervalSamples = AutoWahFilter::getIntervalSamples(AutoWahFilter::ControlRate(rate));
+            double svfNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                if (start == 0) { filter.reset(); sweep.lfoPhase = 0.0f; }
+                FloatVectorOperations::copy(optimizedOut + start, in + start, count);
+                float* channel = optimizedOut + start;
+                sweep.lfoPhase = filter.processSamples(&channel, 1, count, sweep);
+            });
+
+            float maxError = 0.0f;
+            for (int i = 0; i < settings.numSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            String svfName = "svf-" + String(sweep.intervalSamples);
+            KernelBenchmarks::printResult("auto-wah", blockSize, svfName.toRawUTF8(),
+                                          svfNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
+
+// AutoWahFilter on several channels at once, each with its own envelope and then linked, against
+// the original loop run on each channel in turn, at the default control rate; times are per
+// sample frame, i.e. for all the channels together. The max error is from the first channel,
+// compared with the reference's, and only unlinked, since linking changes the sweep.
+void benchmarkAutoWahChannels(const KernelBenchmarks::Settings& settings)
+{
+    const int maxChannels = 8;
+    AudioBuffer<float> input(maxChannels, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    AudioBuffer<float> referenceOutput(maxChannels, settings.numSamples), optimizedOutput(maxChannels, settings.numSamples);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        for (int numChannels : { 1, 2, 4, maxChannels })
+        {
+            ReferenceChannel reference[maxChannels];
+            auto sweep = makeTestSweep(settings.sampleRate);
+            float endPhase = 0.0f;
+            double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                if (start == 0) { sweep.lfoPhase = 0.0f; }
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    if (start == 0) reference[ch].reset();
+                    float* out = referenceOutput.getWritePointer(ch, start);
+                    FloatVectorOperations::copy(out, input.getReadPointer(ch, start), count);
+                    endPhase = reference[ch].processSamples(out, count, sweep);
+                }
+                sweep.lfoPhase = endPhase;
+            });
+            String referenceName = "reference-" + String(numChannels);
+            KernelBenchmarks::printResult("auto-wah-channels", blockSize, referenceName.toRawUTF8(),
+                                          referenceNs, referenceNs, {});
+
+            for (bool linked : { false, true })
+            {
+                AutoWahFilter filter;
+                filter.prepare(numChannels);
+                sweep = makeTestSweep(settings.sampleRate);
+                sweep.intervalSamples = AutoWahFilter::getIntervalSamples(AutoWahFilter::kEvery32Samples);
+                sweep.linked = linked;
+                double lanesNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+                {
+                    if (start == 0) { filter.reset(); sweep.lfoPhase = 0.0f; }
+                    float* channels[maxChannels];
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        channels[ch] = optimizedOutput.getWritePointer(ch, start);
+                        FloatVectorOperations::copy(channels[ch], input.getReadPointer(ch, start), count);
+                    }
+                    sweep.lfoPhase = filter.processSamples(channels, numChannels, count, sweep);
+                });
+
+                String maxError;
+                if (!linked)
+                {
+                    const float* referenceOut = referenceOutput.getReadPointer(0);
+                    const float* optimizedOut = optimizedOutput.getReadPointer(0);
+                    float error = 0.0f;
+                    for (int i = 0; i < settings.numSamples; ++i)
+                        error = jmax(error, std::abs(optimizedOut[i] - referenceOut[i]));
+                    maxError = String(error, 7);
+                }
+                String lanesName = String(linked ? "linked-" : "lanes-") + String(numChannels);
+                KernelBenchmarks::printResult("auto-wah-channels", blockSize, lanesName.toRawUTF8(),
+                                              lanesNs, referenceNs, maxError);
+            }
+        }
+    }
+}
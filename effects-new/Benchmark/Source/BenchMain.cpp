@@ -0,0 +1,456 @@
+/*  EffectsBench: renders audio through effects-new processors without a DAW or GUI,
+    and reports how long processBlock() takes. See README.md in the Benchmark folder.
+*/
+
+#include "JuceHeader.h"
+#include "EffectRegistry.h"
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "AllocationCounter.h"
+#include "AutomationScheduler.h"
+#include <chrono>
+#include <cstdio>
+
+struct ScheduledChange
+{
+    String paramID;
+    float value;                        // in user (not normalized) units
+    double seconds;                     // from the start of the input
+};
+
+struct BenchOptions
+{
+    StringArray effectNames;            // empty means all effects
+    StringArray kernelNames;            // if not empty, these kernels are run instead of effects
+    File inputFile;                     // if not set, a synthetic signal is used
+    TestSignals::Type signal = TestSignals::kNoise;
+    double seconds = 10.0;
+    double sampleRate = 48000.0;
+    Array<int> blockSizes;
+    int numChannels = 0;                // 0 means use each effect's default bus layout
+    int repeats = 1;
+    StringPairArray params;             // parameter ID -> value, in user (not normalized) units
+    Array<ScheduledChange> changes;     // sample-accurate parameter changes during processing
+    File outputFile;                    // if set, the rendered result is written here
+};
+
+struct BenchResult
+{
+    double nsPerSample;                 // processing time per sample frame (all channels)
+    double realtimeFactor;              // audio duration / processing time
+    double allocationsPerBlock;
+    int64 maxAllocationsInBlock;
+};
+
+static void printUsage()
+{
+    printf("Usage: EffectsBench [options]\n"
+           "  --list                    list the available effects and exit\n"
+           "  --effect=<name>[,<name>]  effect(s) to run (default: all)\n"
+           "  --list-kernels            list the available DSP kernel benchmarks and exit\n"
+           "  --kernel=<name>[,<name>]  run kernel benchmark(s) instead of effects\n"
+           "  --input=<file>            input audio file (default: synthetic signal)\n"
+           "  --signal=<type>           sine, sweep, noise, impulse or silence (default: noise)\n"
+           "  --seconds=<t>             length of synthetic signal (default: 10)\n"
+           "  --rate=<Hz>               sample rate of synthetic signal (default: 48000)\n"
+           "  --block=<n>[,<n>]         block size(s) (default: 512)\n"
+           "  --channels=<n>            main bus channel count (default: effect's own)\n"
+           "  --repeat=<n>              passes over the input (default: 1)\n"
+           "  --param=<id>=<value>      set a parameter before processing (repeatable)\n"
+           "  --automate=<id>=<v>@<t>   set a parameter to v, t seconds into the input (repeatable)\n"
+           "  --output=<file.wav>       write the rendered audio (one effect and block size only)\n");
+}
+
+// Split "--name=value" into name and value; returns false if arg isn't of that form
+static bool parseOption(const String& arg, String& name, String& value)
+{
+    if (!arg.startsWith("--")) return false;
+    name = arg.substring(2).upToFirstOccurrenceOf("=", false, false);
+    value = arg.fromFirstOccurrenceOf("=", false, false);
+    return true;
+}
+
+static bool parseArguments(const StringArray& args, BenchOptions& options)
+{
+    for (auto& arg : args)
+    {
+        String name, value;
+        if (!parseOption(arg, name, value))
+        {
+            fprintf(stderr, "Unexpected argument: %s\n", arg.toRawUTF8());
+            return false;
+        }
+
+        if (name == "effect")
+            options.effectNames.addTokens(value, ",", {});
+        else if (name == "kernel")
+            options.kernelNames.addTokens(value, ",", {});
+        else if (name == "input")
+            options.inputFile = File::getCurrentWorkingDirectory().getChildFile(value);
+        else if (name == "signal")
+        {
+            if (!TestSignals::parseName(value, options.signal))
+            {
+                fprintf(stderr, "Unknown signal type: %s\n", value.toRawUTF8());
+                return false;
+            }
+        }
+        else if (name == "seconds")
+            options.seconds = value.getDoubleValue();
+        else if (name == "rate")
+            options.sampleRate = value.getDoubleValue();
+        else if (name == "block")
+        {
+            for (auto& token : StringArray::fromTokens(value, ",", {}))
+                options.blockSizes.add(token.getIntValue());
+        }
+        else if (name == "channels")
+            options.numChannels = value.getIntValue();
+        else if (name == "repeat")
+            options.repeats = value.getIntValue();
+        else if (name == "param")
+            options.params.set(value.upToFirstOccurrenceOf("=", false, false),
+                               value.fromFirstOccurrenceOf("=", false, false));
+        else if (name == "automate")
+        {
+            if (!value.contains("=") || !value.contains("@"))
+            {
+                fprintf(stderr, "--automate requires <id>=<value>@<seconds>\n");
+                return false;
+            }
+            String valueAndTime = value.fromFirstOccurrenceOf("=", false, false);
+            options.changes.add({ value.upToFirstOccurrenceOf("=", false, false),
+                                  valueAndTime.upToFirstOccurrenceOf("@", false, false).getFloatValue(),
+                                  valueAndTime.fromFirstOccurrenceOf("@", false, false).getDoubleValue() });
+        }
+        else if (name == "output")
+            options.outputFile = File::getCurrentWorkingDirectory().getChildFile(value);
+        else
+        {
+            fprintf(stderr, "Unknown option: --%s\n", name.toRawUTF8());
+            return false;
+        }
+    }
+
+    if (options.blockSizes.isEmpty()) options.blockSizes.add(512);
+    for (int bs : options.blockSizes)
+    {
+        if (bs < 1)
+        {
+            fprintf(stderr, "Block sizes must be positive\n");
+            return false;
+        }
+    }
+    if (options.seconds <= 0.0 || options.sampleRate <= 0.0 || options.repeats < 1)
+    {
+        fprintf(stderr, "--seconds, --rate and --repeat must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+static bool loadInput(const BenchOptions& options, AudioBuffer<float>& input, double& sampleRate)
+{
+    if (options.inputFile == File())
+    {
+        sampleRate = options.sampleRate;
+        input.setSize(2, int(options.seconds * sampleRate));
+        TestSignals::generate(options.signal, input, sampleRate);
+        return true;
+    }
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(options.inputFile));
+    if (reader == nullptr)
+    {
+        fprintf(stderr, "Cannot read %s\n", options.inputFile.getFullPathName().toRawUTF8());
+        return false;
+    }
+
+    sampleRate = reader->sampleRate;
+    input.setSize(int(reader->numChannels), int(reader->lengthInSamples));
+    reader->read(&input, 0, int(reader->lengthInSamples), 0, true, true);
+    return true;
+}
+
+static bool setMainBusChannels(AudioProcessor& processor, int numChannels)
+{
+    auto layout = processor.getBusesLayout();
+    auto channelSet = AudioChannelSet::canonicalChannelSet(numChannels);
+    if (layout.inputBuses.size() > 0) layout.inputBuses.getReference(0) = channelSet;
+    if (layout.outputBuses.size() > 0) layout.outputBuses.getReference(0) = channelSet;
+    return processor.setBusesLayout(layout);
+}
+
+static RangedAudioParameter* findParameter(AudioProcessor& processor, const String& paramID)
+{
+    for (auto* param : processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<RangedAudioParameter*>(param);
+        if (ranged != nullptr && ranged->paramID == paramID)
+            return ranged;
+    }
+    return nullptr;
+}
+
+// Set a parameter by ID, as a host would; the value is in the parameter's own units
+static bool setParameter(AudioProcessor& processor, const String& paramID, float value)
+{
+    auto* param = findParameter(processor, paramID);
+    if (param == nullptr) return false;
+
+    param->setValueNotifyingHost(param->convertTo0to1(value));
+    return true;
+}
+
+// Schedule every --automate change for one pass over the input, which starts at passStart
+static bool scheduleChanges(AudioProcessor& processor, const BenchOptions& options,
+                            double sampleRate, int64 passStart)
+{
+    auto* owner = dynamic_cast<AutomationScheduler::Owner*>(&processor);
+    if (owner == nullptr) return false;
+
+    for (auto& change : options.changes)
+    {
+        auto* param = findParameter(processor, change.paramID);
+        if (param == nullptr) return false;
+
+        int64 position = passStart + int64(change.seconds * sampleRate + 0.5);
+        if (!owner->getAutomationScheduler().scheduleChange(param, param->convertTo0to1(change.value), position))
+            return false;
+    }
+    return true;
+}
+
+static bool writeOutput(const File& file, const AudioBuffer<float>& audio, double sampleRate)
+{
+    file.deleteFile();
+    std::unique_ptr<FileOutputStream> stream(file.createOutputStream());
+    if (stream == nullptr) return false;
+
+    WavAudioFormat wavFormat;
+    std::unique_ptr<AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate,
+                                              unsigned(audio.getNumChannels()), 24, {}, 0));
+    if (writer == nullptr) return false;
+    stream.release();   // writer now owns the stream
+
+    return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+}
+
+static bool runBenchmark(const EffectRegistry::Entry& entry, const BenchOptions& options,
+                         const AudioBuffer<float>& input, double sampleRate, int blockSize,
+                         BenchResult& result)
+{
+    std::unique_ptr<AudioProcessor> processor(entry.create());
+
+    if (options.numChannels > 0 && !setMainBusChannels(*processor, options.numChannels))
+    {
+        fprintf(stderr, "%s: does not support %d channels\n", entry.name, options.numChannels);
+        return false;
+    }
+
+    for (auto& paramID : options.params.getAllKeys())
+    {
+        if (!setParameter(*processor, paramID, options.params[paramID].getFloatValue()))
+        {
+            fprintf(stderr, "%s: no parameter with ID '%s'\n", entry.name, paramID.toRawUTF8());
+            return false;
+        }
+    }
+
+    const int numInputChannels = processor->getTotalNumInputChannels();
+    const int numOutputChannels = processor->getTotalNumOutputChannels();
+    processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor->setNonRealtime(true);
+    processor->prepareToPlay(sampleRate, blockSize);
+
+    // Run long enough past the end of the input to flush out any reported latency,
+    // which is then trimmed from the front of the rendered output.
+    const int inputLength = input.getNumSamples();
+    const int latency = processor->getLatencySamples();
+    const int numBlocks = (inputLength + latency + blockSize - 1) / blockSize;
+
+    AudioBuffer<float> block(jmax(numInputChannels, numOutputChannels), blockSize);
+    MidiBuffer midiMessages;
+    AudioBuffer<float> rendered;
+    if (options.outputFile != File())
+        rendered.setSize(numOutputChannels, numBlocks * blockSize);
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration totalTime(0);
+    int64 totalAllocations = 0;
+    int64 maxAllocations = 0;
+
+    for (int pass = 0; pass < options.repeats; pass++)
+    {
+        if (!options.changes.isEmpty() &&
+            !scheduleChanges(*processor, options, sampleRate, int64(pass) * numBlocks * blockSize))
+        {
+            fprintf(stderr, "%s: cannot schedule --automate changes (unknown parameter ID?)\n", entry.name);
+            return false;
+        }
+
+        for (int b = 0; b < numBlocks; b++)
+        {
+            const int start = b * blockSize;
+            const int count = jlimit(0, blockSize, inputLength - start);
+
+            block.clear();
+            for (int ch = 0; ch < numInputChannels; ch++)
+                if (count > 0)
+                    block.copyFrom(ch, 0, input, ch % input.getNumChannels(), start, count);
+            midiMessages.clear();
+
+            AllocationCounter::startCounting();
+            auto startTime = Clock::now();
+            processor->processBlock(block, midiMessages);
+            totalTime += Clock::now() - startTime;
+            int64 allocations = AllocationCounter::stopCounting();
+
+            totalAllocations += allocations;
+            maxAllocations = jmax(maxAllocations, allocations);
+
+            if (pass == 0 && rendered.getNumChannels() > 0)
+                for (int ch = 0; ch < numOutputChannels; ch++)
+                    rendered.copyFrom(ch, start, block, ch, 0, blockSize);
+        }
+    }
+
+    processor->releaseResources();
+
+    const double totalSamples = double(numBlocks) * blockSize * options.repeats;
+    const double totalNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>(totalTime).count());
+    result.nsPerSample = totalNs / totalSamples;
+    result.realtimeFactor = totalNs > 0.0 ? (totalSamples / sampleRate) / (totalNs * 1e-9) : 0.0;
+    result.allocationsPerBlock = double(totalAllocations) / (double(numBlocks) * options.repeats);
+    result.maxAllocationsInBlock = maxAllocations;
+
+    if (rendered.getNumChannels() > 0)
+    {
+        AudioBuffer<float> trimmed(numOutputChannels, inputLength);
+        for (int ch = 0; ch < numOutputChannels; ch++)
+            trimmed.copyFrom(ch, 0, rendered, ch, latency, inputLength);
+
+        if (!writeOutput(options.outputFile, trimmed, sampleRate))
+        {
+            fprintf(stderr, "Cannot write %s\n", options.outputFile.getFullPathName().toRawUTF8());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int runKernelBenchmarks(const BenchOptions& options)
+{
+    Array<const KernelBenchmarks::Entry*> kernels;
+    for (auto& name : options.kernelNames)
+    {
+        auto entry = KernelBenchmarks::find(name);
+        if (entry == nullptr)
+        {
+            fprintf(stderr, "Unknown kernel: %s (use --list-kernels)\n", name.toRawUTF8());
+            return 1;
+        }
+        kernels.add(entry);
+    }
+
+    KernelBenchmarks::Settings settings { options.sampleRate, int(options.seconds * options.sampleRate),
+                                          options.blockSizes, options.repeats };
+    KernelBenchmarks::printHeading();
+    for (auto entry : kernels)
+        entry->run(settings);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    // Some processors post change messages, which requires a MessageManager
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    StringArray args;
+    for (int i = 1; i < argc; i++) args.add(CharPointer_UTF8(argv[i]));
+
+    if (args.contains("--help") || args.contains("-h"))
+    {
+        printUsage();
+        return 0;
+    }
+    if (args.contains("--list"))
+    {
+        for (auto& entry : EffectRegistry::getEntries())
+            printf("%s\n", entry.name);
+        return 0;
+    }
+
+    if (args.contains("--list-kernels"))
+    {
+        for (auto& entry : KernelBenchmarks::getEntries())
+            printf("%s\n", entry.name);
+        return 0;
+    }
+
+    BenchOptions options;
+    if (!parseArguments(args, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (options.kernelNames.size() > 0)
+        return runKernelBenchmarks(options);
+
+    Array<const EffectRegistry::Entry*> effects;
+    if (options.effectNames.isEmpty())
+    {
+        for (auto& entry : EffectRegistry::getEntries())
+            effects.add(&entry);
+    }
+    else
+    {
+        for (auto& name : options.effectNames)
+        {
+            auto entry = EffectRegistry::find(name);
+            if (entry == nullptr)
+            {
+                fprintf(stderr, "Unknown effect: %s (use --list)\n", name.toRawUTF8());
+                return 1;
+            }
+            effects.add(entry);
+        }
+    }
+
+    if (options.outputFile != File() && (effects.size() != 1 || options.blockSizes.size() != 1))
+    {
+        fprintf(stderr, "--output requires exactly one effect and one block size\n");
+        return 1;
+    }
+
+    AudioBuffer<float> input;
+    double sampleRate;
+    if (!loadInput(options, input, sampleRate)) return 1;
+
+    printf("%-14s %7s %8s %9s %11s %13s\n",
+           "effect", "block", "rate", "ns/sample", "x realtime", "allocs/block");
+
+    bool allAllocationFree = true;
+    for (auto entry : effects)
+    {
+        for (int blockSize : options.blockSizes)
+        {
+            BenchResult result;
+            if (!runBenchmark(*entry, options, input, sampleRate, blockSize, result))
+                return 1;
+
+            printf("%-14s %7d %8.0f %9.2f %11.1f %8.2f (max %lld)\n",
+                   entry->name, blockSize, sampleRate, result.nsPerSample, result.realtimeFactor,
+                   result.allocationsPerBlock, (long long)result.maxAllocationsInBlock);
+
+            if (result.maxAllocationsInBlock > 0) allAllocationFree = false;
+        }
+    }
+
+    // Non-zero exit status flags audio-thread allocations, so scripts can catch regressions
+    return allAllocationFree ? 0 : 2;
+}
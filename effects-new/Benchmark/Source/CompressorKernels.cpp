@@ -0,0 +1,110 @@
+/*  Kernel benchmarks for the Compressor effect (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "CompressorGainComputer.h"
+
+namespace
+{
+    struct CompressorSettings
+    {
+        float threshold = -24.0f;
+        float ratio = 4.0f;
+        float makeUpGain = 6.0f;
+        float alphaAttack, alphaRelease;
+
+        CompressorSettings(double sampleRate)
+        {
+            alphaAttack = std::exp(-1.0f / (0.001f * float(sampleRate) * 5.0f));
+            alphaRelease = std::exp(-1.0f / (0.001f * float(sampleRate) * 100.0f));
+        }
+    };
+
+    // The original per-sample loop from CompressorProcessor::computeCompressionGain(),
+    // with all its intermediate arrays, as the reference
+    struct ReferenceGainComputer
+    {
+        HeapBlock<float> x_g, x_l, y_g, y_l;
+        float yL_prev = 0.0f;
+
+        ReferenceGainComputer(int maxBlockSize)
+            : x_g(maxBlockSize, true), x_l(maxBlockSize, true), y_g(maxBlockSize, true), y_l(maxBlockSize, true)
+        {
+        }
+
+        void process(const float* input, float* c, int numSamples, const CompressorSettings& s)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (fabs(input[i]) < 0.000001f) x_g[i] = -120;
+                else x_g[i] = 20 * log10(fabs(input[i]));
+
+                if (x_g[i] >= s.threshold)
+                    y_g[i] = s.threshold + (x_g[i] - s.threshold) / s.ratio;
+                else
+                    y_g[i] = x_g[i];
+                x_l[i] = x_g[i] - y_g[i];
+
+                if (x_l[i] > yL_prev)
+                    y_l[i] = s.alphaAttack * yL_prev + (1 - s.alphaAttack) * x_l[i];
+                else
+                    y_l[i] = s.alphaRelease * yL_prev + (1 - s.alphaRelease) * x_l[i];
+
+                c[i] = pow(10.0f, (s.makeUpGain - y_l[i]) / 20.0f);
+                yL_prev = y_l[i];
+            }
+        }
+    };
+
+    struct OptimizedGainComputer
+    {
+        float yL_prev = 0.0f;
+
+        void process(const float* input, float* c, int numSamples, const CompressorSettings& s)
+        {
+            CompressorGainComputer::computeGainReduction(input, c, numSamples, s.threshold, s.ratio);
+            CompressorGainComputer::applyBallistics(c, numSamples, s.alphaAttack, s.alphaRelease, yL_prev);
+            CompressorGainComputer::computeControlGain(c, numSamples, s.makeUpGain);
+        }
+    };
+}
+
+void benchmarkCompressorGain(const KernelBenchmarks::Settings& settings)
+{
+    // Noise at -6 dBFS, boosted to -0 dBFS for the second half, so the compressor
+    // spends time both above and below threshold, attacking and releasing
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    input.applyGain(settings.numSamples / 2, settings.numSamples - settings.numSamples / 2, 2.0f);
+
+    CompressorSettings compressorSettings(settings.sampleRate);
+    AudioBuffer<float> referenceGain(1, settings.numSamples), optimizedGain(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        ReferenceGainComputer reference(blockSize);
+        float* cRef = referenceGain.getWritePointer(0);
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            reference.process(in + start, cRef + start, count, compressorSettings);
+        });
+
+        OptimizedGainComputer optimized;
+        float* cOpt = optimizedGain.getWritePointer(0);
+        double optimizedNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            optimized.process(in + start, cOpt + start, count, compressorSettings);
+        });
+
+        // Both have processed the same blocks in the same order, so should agree closely
+        double maxErrorDB = 0.0;
+        for (int i = 0; i < settings.numSamples; ++i)
+            maxErrorDB = jmax(maxErrorDB, std::abs(20.0 * std::log10(double(cOpt[i]) / double(cRef[i]))));
+
+        KernelBenchmarks::printResult("compressor-gain", blockSize, "reference", referenceNs, referenceNs, {});
+        KernelBenchmarks::printResult("compressor-gain", blockSize, "vectorized", optimizedNs, referenceNs,
+                                      String(maxErrorDB, 5) + " dB");
+    }
+}
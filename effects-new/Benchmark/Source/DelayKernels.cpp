@@ -0,0 +1,222 @@
+/*  Kernel benchmarks for the Delay and Ping-Pong Delay effects (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "DelayLine.h"
+#include "MultiTapDelay.h"
+
+namespace
+{
+    const float pingPongFeedback = 0.75f;
+    const float pingPongWetLevel = 0.5f;
+
+    // The original PingPongDelayProcessor loop, one sample at a time, as the reference
+    struct PerSamplePingPong
+    {
+        DelayLine delayLine;
+        int delayL, delayR;
+
+        PerSamplePingPong(int maxDelaySamples, int maxBlockSize, int delayLeft, int delayRight)
+            : delayL(delayLeft), delayR(delayRight)
+        {
+            delayLine.prepare(2, maxDelaySamples, maxBlockSize);
+        }
+
+        void process(float* channelDataL, float* channelDataR, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float inL = channelDataL[i];
+                const float inR = channelDataR[i];
+                const float delayedL = delayLine.read(0, i, delayL);
+                const float delayedR = delayLine.read(1, i, delayR);
+
+                delayLine.write(1, i, inR + (delayedL * pingPongFeedback));
+                delayLine.write(0, i, inL + (delayedR * pingPongFeedback));
+
+                channelDataL[i] = inL + pingPongWetLevel * delayedL;
+                channelDataR[i] = inR + pingPongWetLevel * delayedR;
+            }
+            delayLine.advance(numSamples);
+        }
+    };
+
+    // The same, as PingPongDelayProcessor now does it: block reads and writes, in parts no
+    // longer than the shorter delay
+    struct BlockPingPong
+    {
+        DelayLine delayLine;
+        int delayL, delayR;
+        HeapBlock<float> delayedLeft, delayedRight, delayInput;
+        int maxBlockSize;
+
+        BlockPingPong(int maxDelaySamples, int maxBlockSizeToUse, int delayLeft, int delayRight)
+            : delayL(delayLeft), delayR(delayRight)
+            , delayedLeft(maxBlockSizeToUse), delayedRight(maxBlockSizeToUse), delayInput(maxBlockSizeToUse)
+            , maxBlockSize(maxBlockSizeToUse)
+        {
+            delayLine.prepare(2, maxDelaySamples, maxBlockSize);
+        }
+
+        void process(float* channelDataL, float* channelDataR, int numSamples)
+        {
+            const int longestPart = jmin(delayL, delayR, maxBlockSize);
+            for (int start = 0; start < numSamples; start += longestPart)
+            {
+                const int count = jmin(longestPart, numSamples - start);
+                float* dataL = channelDataL + start;
+                float* dataR = channelDataR + start;
+                delayLine.readBlock(0, delayL, delayedLeft, count);
+                delayLine.readBlock(1, delayR, delayedRight, count);
+
+                FloatVectorOperations::copy(delayInput, dataR, count);
+                FloatVectorOperations::addWithMultiply(delayInput, delayedLeft, pingPongFeedback, count);
+                delayLine.writeBlock(1, delayInput, count);
+                FloatVectorOperations::copy(delayInput, dataL, count);
+                FloatVectorOperations::addWithMultiply(delayInput, delayedRight, pingPongFeedback, count);
+                delayLine.writeBlock(0, delayInput, count);
+
+                FloatVectorOperations::addWithMultiply(dataL, delayedLeft, pingPongWetLevel, count);
+                FloatVectorOperations::addWithMultiply(dataR, delayedRight, pingPongWetLevel, count);
+
+                delayLine.advance(count);
+            }
+        }
+    };
+
+    // Per-sample values for the multi-tap delay, all constant, as they are once the knobs stop
+    // moving: the Delay's default tap settings, with a little feedback on each tap
+    struct TapValues
+    {
+        HeapBlock<float> dryLevel, wetLevel, level[MultiTapDelay::maxTaps], pan[MultiTapDelay::maxTaps], feedback;
+
+        TapValues(int numSamples)
+            : dryLevel(numSamples), wetLevel(numSamples), feedback(numSamples)
+        {
+            FloatVectorOperations::fill(dryLevel, 1.0f, numSamples);
+            FloatVectorOperations::fill(wetLevel, 0.5f, numSamples);
+            FloatVectorOperations::fill(feedback, 0.05f, numSamples);
+            for (int tap = 0; tap < MultiTapDelay::maxTaps; ++tap)
+            {
+                level[tap].allocate(numSamples, false);
+                pan[tap].allocate(numSamples, false);
+                FloatVectorOperations::fill(level[tap], 1.0f - 0.06f * tap, numSamples);
+                FloatVectorOperations::fill(pan[tap], (tap % 2) == 0 ? -0.5f : 0.5f, numSamples);
+            }
+        }
+
+        // Taps 0.125 seconds apart, so all but every eighth are a fractional number of samples
+        // at 44.1 kHz. isSteady false makes the delay go a sample at a time, as it does while
+        // anything is moving.
+        MultiTapDelay::Settings makeSettings(double sampleRate, int numTaps, bool isSteady) const
+        {
+            MultiTapDelay::Settings settings;
+            settings.numTaps = numTaps;
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                MultiTapDelay::Tap& t = settings.taps[tap];
+                t.delaySamples = float(0.125 * (tap + 1) * sampleRate);
+                t.level = level[tap];
+                t.pan = pan[tap];
+                t.feedback = feedback;
+            }
+            settings.timeChange = MultiTapDelay::kTimeChangeGlide;
+            settings.dryLevel = dryLevel;
+            settings.wetLevel = wetLevel;
+            settings.isSteady = isSteady;
+            settings.feedbackPath = { 0.0f, 0.0f, 0.0f, nullptr };    // every stage off
+            return settings;
+        }
+    };
+}
+
+// The block paths of the Ping-Pong Delay and the Delay's MultiTapDelay, which are used while
+// nothing is moving, against the same delays processed a sample at a time, on two channels of
+// noise; times are per sample frame, i.e. for both channels together. The ping-pong delays are
+// 0.5 and 0.375 seconds, with 75% feedback. The multi-tap delay runs 1, 4 and 16 taps; its
+// per-sample variant is what it does while anything is ramping, and is the reference for the
+// block variant with the same number of taps.
+void benchmarkStaticDelay(const KernelBenchmarks::Settings& settings)
+{
+    const int numChannels = 2;
+    AudioBuffer<float> input(numChannels, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    AudioBuffer<float> referenceOutput(numChannels, settings.numSamples), optimizedOutput(numChannels, settings.numSamples);
+
+    auto copyInput = [&](AudioBuffer<float>& output, float** channels, int start, int count)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            channels[ch] = output.getWritePointer(ch, start);
+            FloatVectorOperations::copy(channels[ch], input.getReadPointer(ch, start), count);
+        }
+    };
+    auto getMaxError = [&]()
+    {
+        float maxError = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* referenceOut = referenceOutput.getReadPointer(ch);
+            const float* optimizedOut = optimizedOutput.getReadPointer(ch);
+            for (int i = 0; i < settings.numSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+        }
+        return String(maxError, 7);
+    };
+
+    const int maxDelaySamples = int(2.0 * settings.sampleRate) + 1;
+    const int delayLeft = roundToInt(0.5 * settings.sampleRate);
+    const int delayRight = roundToInt(0.375 * settings.sampleRate);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        std::unique_ptr<PerSamplePingPong> perSample;
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            if (start == 0) perSample.reset(new PerSamplePingPong(maxDelaySamples, blockSize, delayLeft, delayRight));
+            float* channels[numChannels];
+            copyInput(referenceOutput, channels, start, count);
+            perSample->process(channels[0], channels[1], count);
+        });
+        KernelBenchmarks::printResult("static-delay", blockSize, "pingpong-ref", referenceNs, referenceNs, {});
+
+        std::unique_ptr<BlockPingPong> block;
+        double blockNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            if (start == 0) block.reset(new BlockPingPong(maxDelaySamples, blockSize, delayLeft, delayRight));
+            float* channels[numChannels];
+            copyInput(optimizedOutput, channels, start, count);
+            block->process(channels[0], channels[1], count);
+        });
+        KernelBenchmarks::printResult("static-delay", blockSize, "pingpong", blockNs, referenceNs, getMaxError());
+
+        TapValues values(blockSize);
+        for (int numTaps : { 1, 4, MultiTapDelay::maxTaps })
+        {
+            auto timeMultiTap = [&](AudioBuffer<float>& output, bool isSteady)
+            {
+                const MultiTapDelay::Settings tapSettings = values.makeSettings(settings.sampleRate, numTaps, isSteady);
+                MultiTapDelay delay;
+                delay.prepare(numChannels, settings.sampleRate, 2.0f, blockSize);
+                return KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+                {
+                    if (start == 0) delay.reset();
+                    float* channels[numChannels];
+                    copyInput(output, channels, start, count);
+                    delay.processSamples(channels, numChannels, count, tapSettings);
+                });
+            };
+
+            double tapsReferenceNs = timeMultiTap(referenceOutput, false);
+            String referenceName = "sample-" + String(numTaps);
+            KernelBenchmarks::printResult("static-delay", blockSize, referenceName.toRawUTF8(),
+                                          tapsReferenceNs, tapsReferenceNs, {});
+
+            double tapsBlockNs = timeMultiTap(optimizedOutput, true);
+            String blockName = "block-" + String(numTaps);
+            KernelBenchmarks::printResult("static-delay", blockSize, blockName.toRawUTF8(),
+                                          tapsBlockNs, tapsReferenceNs, getMaxError());
+        }
+    }
+}
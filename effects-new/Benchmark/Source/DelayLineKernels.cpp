@@ -0,0 +1,225 @@
+/*  Kernel benchmarks for the DelayLine shared by the delay-based effects (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "DelayLine.h"
+
+namespace
+{
+    // A chorus-like load: several voices read one delay line, each with its own modulated delay
+    const int numVoices = 4;
+    const float minDelayMs = 10.0f;
+    const float sweepWidthMs = 20.0f;
+    const float lfoFreqHz = 0.5f;
+
+    // The original circular buffer from the Vibrato, Flanger and Chorus, with its fmodf()
+    // read position and % wrapping, and Catmull-Rom interpolation, as the reference
+    struct ReferenceDelay
+    {
+        HeapBlock<float> delayData;
+        int delayBufferLength;
+        int dpw = 0;
+
+        ReferenceDelay(int maxDelaySamples)
+            : delayData(maxDelaySamples + 3, true), delayBufferLength(maxDelaySamples + 3)
+        {
+        }
+
+        float interpolate(float delayReadPosition) const
+        {
+            int sample1 = (int)floorf(delayReadPosition);
+            int sample2 = (sample1 + 1) % delayBufferLength;
+            int sample3 = (sample2 + 1) % delayBufferLength;
+            int sample0 = (sample1 - 1 + delayBufferLength) % delayBufferLength;
+
+            float fraction = delayReadPosition - floorf(delayReadPosition);
+            float frsq = fraction*fraction;
+
+            float a0 = -0.5f*delayData[sample0] + 1.5f*delayData[sample1]
+            - 1.5f*delayData[sample2] + 0.5f*delayData[sample3];
+            float a1 = delayData[sample0] - 2.5f*delayData[sample1]
+            + 2.0f*delayData[sample2] - 0.5f*delayData[sample3];
+            float a2 = -0.5f*delayData[sample0] + 0.5f*delayData[sample2];
+            float a3 = delayData[sample1];
+
+            return a0*fraction*frsq + a1*frsq + a2*fraction + a3;
+        }
+
+        void process(const float* input, const float* const* delays, float* output, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float sum = 0.0f;
+                for (int v = 0; v < numVoices; ++v)
+                {
+                    float dpr = fmodf(float(dpw) - delays[v][i] + float(delayBufferLength),
+                                      float(delayBufferLength));
+                    sum += interpolate(dpr);
+                }
+                output[i] = sum;
+
+                delayData[dpw] = input[i];
+                if (++dpw >= delayBufferLength) dpw = 0;
+            }
+        }
+    };
+
+    // DelayLine, one sample at a time, as the effects use it, with the interpolation method
+    // fixed at compile time
+    template <typename Interpolator>
+    struct PerSampleDelay
+    {
+        DelayLine delayLine;
+        float state[numVoices * DelayInterpolation::stateSize] = {};
+
+        PerSampleDelay(int maxDelaySamples, int maxBlockSize)
+        {
+            delayLine.prepare(1, maxDelaySamples, maxBlockSize);
+        }
+
+        void process(const float* input, const float* const* delays, float* output, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float sum = 0.0f;
+                for (int v = 0; v < numVoices; ++v)
+                    sum += delayLine.read<Interpolator>(0, i, delays[v][i], state + v * DelayInterpolation::stateSize);
+                output[i] = sum;
+
+                delayLine.write(0, i, input[i]);
+            }
+            delayLine.advance(numSamples);
+        }
+    };
+
+    // The same, choosing the interpolation method with a switch for every read
+    struct SwitchedDelay
+    {
+        DelayLine delayLine;
+        DelayInterpolation::Type type;
+
+        SwitchedDelay(int maxDelaySamples, int maxBlockSize, DelayInterpolation::Type typeToUse)
+            : type(typeToUse)
+        {
+            delayLine.prepare(1, maxDelaySamples, maxBlockSize);
+        }
+
+        void process(const float* input, const float* const* delays, float* output, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float sum = 0.0f;
+                for (int v = 0; v < numVoices; ++v)
+                    sum += delayLine.read(type, 0, i, delays[v][i]);
+                output[i] = sum;
+
+                delayLine.write(0, i, input[i]);
+            }
+            delayLine.advance(numSamples);
+        }
+    };
+
+    // DelayLine's block functions, one voice at a time (possible when there is no feedback)
+    struct BlockDelay
+    {
+        DelayLine delayLine;
+        HeapBlock<float> voice;
+
+        BlockDelay(int maxDelaySamples, int maxBlockSize)
+            : voice(maxBlockSize)
+        {
+            delayLine.prepare(1, maxDelaySamples, maxBlockSize);
+        }
+
+        void process(const float* input, const float* const* delays, float* output, int numSamples)
+        {
+            delayLine.writeBlock(0, input, numSamples);
+
+            delayLine.readBlock<DelayInterpolation::Cubic>(0, delays[0], output, numSamples);
+            for (int v = 1; v < numVoices; ++v)
+            {
+                delayLine.readBlock<DelayInterpolation::Cubic>(0, delays[v], voice, numSamples);
+                FloatVectorOperations::add(output, voice, numSamples);
+            }
+            delayLine.advance(numSamples);
+        }
+    };
+}
+
+void benchmarkDelayLine(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    const float* in = input.getReadPointer(0);
+
+    // Each voice's delay in samples, for every sample: a sine LFO, with the voices'
+    // phases spread evenly around the cycle
+    AudioBuffer<float> delays(numVoices, settings.numSamples);
+    for (int v = 0; v < numVoices; ++v)
+    {
+        float* d = delays.getWritePointer(v);
+        for (int i = 0; i < settings.numSamples; ++i)
+        {
+            double phase = i * lfoFreqHz / settings.sampleRate + double(v) / numVoices;
+            double lfo = 0.5 + 0.5 * std::sin(MathConstants<double>::twoPi * phase);
+            d[i] = float(0.001 * (minDelayMs + lfo * sweepWidthMs) * settings.sampleRate);
+        }
+    }
+    const int maxDelaySamples = int(0.001 * (minDelayMs + sweepWidthMs) * settings.sampleRate) + 3;
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* referenceOut = referenceOutput.getReadPointer(0);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        const float* delayPointers[numVoices];
+        auto delaysFrom = [&](int start)
+        {
+            for (int v = 0; v < numVoices; ++v)
+                delayPointers[v] = delays.getReadPointer(v, start);
+            return delayPointers;
+        };
+
+        // Times are reported per voice, i.e. the cost of one modulated tap
+        ReferenceDelay reference(maxDelaySamples);
+        float* out = referenceOutput.getWritePointer(0);
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            reference.process(in + start, delaysFrom(start), out + start, count);
+        }) / numVoices;
+        KernelBenchmarks::printResult("delay-line", blockSize, "reference", referenceNs, referenceNs, {});
+
+        auto printVariant = [&](const char* variant, double ns)
+        {
+            const float* optimizedOut = optimizedOutput.getReadPointer(0);
+            float maxError = 0.0f;
+            for (int i = 0; i < settings.numSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            KernelBenchmarks::printResult("delay-line", blockSize, variant, ns, referenceNs, String(maxError, 7));
+        };
+
+        out = optimizedOutput.getWritePointer(0);
+        auto timeVariant = [&](const char* variant, auto&& delay)
+        {
+            printVariant(variant, KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                delay.process(in + start, delaysFrom(start), out + start, count);
+            }) / numVoices);
+        };
+
+        // Cubic, as the reference uses: switching per read, templated, and block-at-a-time
+        timeVariant("switched", SwitchedDelay(maxDelaySamples, blockSize, DelayInterpolation::kInterpolationCubic));
+        timeVariant("per-sample", PerSampleDelay<DelayInterpolation::Cubic>(maxDelaySamples, blockSize));
+        timeVariant("block", BlockDelay(maxDelaySamples, blockSize));
+
+        // The other interpolation methods, templated, for comparison (their "error" is mostly
+        // the difference between methods)
+        timeVariant("nearest", PerSampleDelay<DelayInterpolation::NearestNeighbour>(maxDelaySamples, blockSize));
+        timeVariant("linear", PerSampleDelay<DelayInterpolation::Linear>(maxDelaySamples, blockSize));
+        timeVariant("lagrange3", PerSampleDelay<DelayInterpolation::Lagrange3>(maxDelaySamples, blockSize));
+        timeVariant("lagrange5", PerSampleDelay<DelayInterpolation::Lagrange5>(maxDelaySamples, blockSize));
+        timeVariant("sinc", PerSampleDelay<DelayInterpolation::Sinc>(maxDelaySamples, blockSize));
+        timeVariant("thiran", PerSampleDelay<DelayInterpolation::Thiran>(maxDelaySamples, blockSize));
+    }
+}
@@ -0,0 +1,247 @@
+/*  Kernel benchmarks for the Distortion effect (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "Distortion.h"
+#include "Oversampler.h"
+#include "TransferCurve.h"
+
+namespace
+{
+    // A sine, driven hard into the clipper, so it has strong harmonics well above Nyquist.
+    // Its frequency is a whole number of cycles per analysisLength samples (a prime number,
+    // so no harmonic's alias lands exactly on another harmonic), and the last analysisLength
+    // samples of the output can be analysed without a window.
+    const int analysisLength = 4096;
+    const int sineCycles = 373;             // about 4.4 kHz at 48 kHz
+    const float linearGain = 10.0f;         // +20 dB
+    const Distortion::Type distType = Distortion::kHardClipping;
+
+    // Power at one DFT bin of analysisLength samples (Goertzel's algorithm)
+    double getBinPower(const float* signal, int bin)
+    {
+        const double w = MathConstants<double>::twoPi * bin / analysisLength;
+        const double coefficient = 2.0 * std::cos(w);
+        double s1 = 0.0, s2 = 0.0;
+        for (int i = 0; i < analysisLength; ++i)
+        {
+            double s0 = signal[i] + coefficient * s1 - s2;
+            s2 = s1;
+            s1 = s0;
+        }
+        return s1 * s1 + s2 * s2 - coefficient * s1 * s2;
+    }
+
+    // Everything in the output which is not the sine or one of its harmonics below Nyquist,
+    // i.e. aliasing (plus the filters' own small errors), in dB relative to the sine
+    String getAliasLevel(const float* signal)
+    {
+        double totalPower = 0.0;
+        for (int i = 0; i < analysisLength; ++i)
+            totalPower += double(signal[i]) * signal[i];
+
+        // Parseval: a bin's power is (analysisLength / 2) times the signal power it carries
+        const double binScale = 2.0 / (double(analysisLength) * analysisLength);
+        const double fundamentalPower = getBinPower(signal, sineCycles) * binScale;
+        double harmonicPower = 0.0;
+        for (int bin = sineCycles; bin < analysisLength / 2; bin += sineCycles)
+            harmonicPower += getBinPower(signal, bin) * binScale;
+
+        // DC (the rectifiers have some) is not aliasing either
+        double dc = 0.0;
+        for (int i = 0; i < analysisLength; ++i)
+            dc += signal[i];
+        dc /= analysisLength;
+
+        const double aliasPower = jmax(1e-30, totalPower / analysisLength - harmonicPower - dc * dc);
+        return String(10.0 * std::log10(aliasPower / fundamentalPower), 1) + " dB alias";
+    }
+
+    // The original DistortionProcessor loop: gain, then the wave-shaper, at the host's rate
+    void processReference(float* data, int numSamples)
+    {
+        FloatVectorOperations::multiply(data, linearGain, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = Distortion::processSample(data[i], distType);
+    }
+
+    // As DistortionProcessor::processSubBlock() does it now
+    void processOversampled(Oversampler& oversampler, Distortion::Antialiasing antialiasing,
+                            Distortion::AntialiasingState& state, float* data, int numSamples)
+    {
+        float* oversampled = oversampler.upsample(0, data, numSamples);
+        const int numOversampled = numSamples * oversampler.getRatio();
+        Distortion::processBlockAntialiased(oversampled, numOversampled, distType, linearGain, antialiasing, state);
+        oversampler.downsample(0, data, numSamples);
+    }
+}
+
+void benchmarkDistortion(const KernelBenchmarks::Settings& settings)
+{
+    jassert(settings.numSamples >= analysisLength);
+
+    AudioBuffer<float> input(1, settings.numSamples), output(1, settings.numSamples);
+    float* in = input.getWritePointer(0);
+    for (int i = 0; i < settings.numSamples; ++i)
+        in[i] = std::sin(MathConstants<float>::twoPi * float((i * sineCycles) % analysisLength) / analysisLength);
+
+    // Every variant processes in place, so each block is copied from the input first
+    float* out = output.getWritePointer(0);
+    const float* analysed = out + settings.numSamples - analysisLength;
+
+    struct Variant
+    {
+        Oversampler::Factor factor;
+        Distortion::Antialiasing antialiasing;
+        const char* name;
+    };
+    const Variant variants[] =
+    {
+        { Oversampler::kFactor1x, Distortion::kAntialiasingNone, "1x" },
+        { Oversampler::kFactor2x, Distortion::kAntialiasingNone, "2x" },
+        { Oversampler::kFactor4x, Distortion::kAntialiasingNone, "4x" },
+        { Oversampler::kFactor8x, Distortion::kAntialiasingNone, "8x" },
+        { Oversampler::kFactor1x, Distortion::kAntialiasingFirstOrder, "1x-adaa1" },
+        { Oversampler::kFactor1x, Distortion::kAntialiasingSecondOrder, "1x-adaa2" },
+        { Oversampler::kFactor2x, Distortion::kAntialiasingFirstOrder, "2x-adaa1" },
+        { Oversampler::kFactor2x, Distortion::kAntialiasingSecondOrder, "2x-adaa2" },
+    };
+
+    for (int blockSize : settings.blockSizes)
+    {
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            FloatVectorOperations::copy(out + start, in + start, count);
+            processReference(out + start, count);
+        });
+        KernelBenchmarks::printResult("distortion", blockSize, "reference", referenceNs, referenceNs,
+                                      getAliasLevel(analysed));
+
+        for (auto& variant : variants)
+        {
+            Oversampler oversampler;
+            oversampler.prepare(1, blockSize);
+            oversampler.setFactor(variant.factor);
+            Distortion::AntialiasingState state;
+            state.prepare(blockSize * oversampler.getRatio());
+            double variantNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copy(out + start, in + start, count);
+                processOversampled(oversampler, variant.antialiasing, state, out + start, count);
+            });
+            KernelBenchmarks::printResult("distortion", blockSize, variant.name, variantNs, referenceNs,
+                                          getAliasLevel(analysed));
+        }
+    }
+}
+
+// Distortion::processBlock() against the original per-sample loop (which is also the reference
+// for "distortion" above), for every type, over noise driven well into every curve's knee
+void benchmarkDistortionShaper(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    const float gain = 4.0f;
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+    float* referenceOut = referenceOutput.getWritePointer(0);
+    float* optimizedOut = optimizedOutput.getWritePointer(0);
+
+    const std::pair<Distortion::Type, const char*> types[] =
+    {
+        { Distortion::kHardClipping, "hard" },
+        { Distortion::kSoftClipping, "soft" },
+        { Distortion::kSoftClippingExp, "exp" },
+        { Distortion::kFullWaveRectifier, "full-wave" },
+        { Distortion::kHalfWaveRectifier, "half-wave" },
+    };
+
+    for (int blockSize : settings.blockSizes)
+    {
+        for (auto& type : types)
+        {
+            double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copyWithMultiply(referenceOut + start, in + start, gain, count);
+                for (int i = start; i < start + count; ++i)
+                    referenceOut[i] = Distortion::processSample(referenceOut[i], type.first);
+            });
+            String referenceName = String("reference-") + type.second;
+            KernelBenchmarks::printResult("distortion-shaper", blockSize, referenceName.toRawUTF8(),
+                                          referenceNs, referenceNs, {});
+
+            double blockNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copy(optimizedOut + start, in + start, count);
+                Distortion::processBlock(optimizedOut + start, count, type.first, gain);
+            });
+
+            float maxError = 0.0f;
+            for (int i = 0; i < settings.numSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            String blockName = String("block-") + type.second;
+            KernelBenchmarks::printResult("distortion-shaper", blockSize, blockName.toRawUTF8(),
+                                          blockNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
+
+// TransferCurve::processBlock() against the curve's Chebyshev polynomials evaluated directly,
+// sample by sample, over the same noise as "distortion-shaper"; the cost of the lookup does not
+// depend on how many harmonics are used, so all of them are
+void benchmarkTransferCurve(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    const float gain = 4.0f;
+    const float levels[TransferCurve::numHarmonics] = { 1.0f, 0.5f, -0.3f, 0.2f, 0.1f };
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+    float* referenceOut = referenceOutput.getWritePointer(0);
+    float* optimizedOut = optimizedOutput.getWritePointer(0);
+
+    // The curve at x, clamped to +/-1, by the recurrence T[k+1] = 2x T[k] - T[k-1]
+    auto evaluate = [&levels](float x)
+    {
+        x = jlimit(-1.0f, 1.0f, x);
+        float t0 = 1.0f, t1 = x, y = 0.0f;
+        for (int h = 0; h < TransferCurve::numHarmonics; ++h)
+        {
+            y += levels[h] * t1;
+            const float t2 = 2.0f * x * t1 - t0;
+            t0 = t1;
+            t1 = t2;
+        }
+        return y;
+    };
+    const float offset = evaluate(0.0f);
+
+    TransferCurve transferCurve;
+    transferCurve.setHarmonicLevels(levels);
+    transferCurve.compileNow();
+
+    for (int blockSize : settings.blockSizes)
+    {
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            for (int i = start; i < start + count; ++i)
+                referenceOut[i] = evaluate(gain * in[i]) - offset;
+        });
+        KernelBenchmarks::printResult("transfer-curve", blockSize, "reference", referenceNs, referenceNs, {});
+
+        double tableNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            FloatVectorOperations::copy(optimizedOut + start, in + start, count);
+            transferCurve.processBlock(optimizedOut + start, count, gain);
+        });
+
+        float maxError = 0.0f;
+        for (int i = 0; i < settings.numSamples; ++i)
+            maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+        KernelBenchmarks::printResult("transfer-curve", blockSize, "table", tableNs, referenceNs,
+                                      String(maxError, 7));
+    }
+}
@@ -0,0 +1,55 @@
+#include "EffectRegistry.h"
+
+// Factory functions, one per effect library; names must match CMakeLists.txt
+#define DECLARE_EFFECT(name) AudioProcessor* JUCE_CALLTYPE create##name##Effect();
+DECLARE_EFFECT(BasicGain)
+DECLARE_EFFECT(Tremolo)
+DECLARE_EFFECT(RingMod)
+DECLARE_EFFECT(Compressor)
+DECLARE_EFFECT(Distortion)
+DECLARE_EFFECT(ParametricEQ)
+DECLARE_EFFECT(WahWah)
+DECLARE_EFFECT(AutoWah)
+DECLARE_EFFECT(Phaser)
+DECLARE_EFFECT(Delay)
+DECLARE_EFFECT(PingPongDelay)
+DECLARE_EFFECT(Vibrato)
+DECLARE_EFFECT(Flanger)
+DECLARE_EFFECT(Chorus)
+DECLARE_EFFECT(MVerb)
+DECLARE_EFFECT(JuceVerb)
+DECLARE_EFFECT(Leslie)
+#undef DECLARE_EFFECT
+
+const Array<EffectRegistry::Entry>& EffectRegistry::getEntries()
+{
+    static const Array<Entry> entries
+    {
+        { "BasicGain", createBasicGainEffect },
+        { "Tremolo", createTremoloEffect },
+        { "RingMod", createRingModEffect },
+        { "Compressor", createCompressorEffect },
+        { "Distortion", createDistortionEffect },
+        { "ParametricEQ", createParametricEQEffect },
+        { "WahWah", createWahWahEffect },
+        { "AutoWah", createAutoWahEffect },
+        { "Phaser", createPhaserEffect },
+        { "Delay", createDelayEffect },
+        { "PingPongDelay", createPingPongDelayEffect },
+        { "Vibrato", createVibratoEffect },
+        { "Flanger", createFlangerEffect },
+        { "Chorus", createChorusEffect },
+        { "MVerb", createMVerbEffect },
+        { "JuceVerb", createJuceVerbEffect },
+        { "Leslie", createLeslieEffect },
+    };
+    return entries;
+}
+
+const EffectRegistry::Entry* EffectRegistry::find(const String& name)
+{
+    for (auto& entry : getEntries())
+        if (name.equalsIgnoreCase(entry.name))
+            return &entry;
+    return nullptr;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  EffectRegistry lists every effects-new processor that EffectsBench can instantiate.
+    Each entry's factory is the project's own createPluginFilter(), renamed at compile time
+    (see add_benchmarked_effect() in CMakeLists.txt).
+*/
+
+struct EffectRegistry
+{
+    struct Entry
+    {
+        const char* name;
+        AudioProcessor* (JUCE_CALLTYPE *create)();
+    };
+
+    static const Array<Entry>& getEntries();
+
+    // Returns nullptr if there is no effect with the given name (case-insensitive)
+    static const Entry* find(const String& name);
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+/*  Stands in for the JuceHeader.h the Projucer would generate, so that the effect sources
+    (which all #include "JuceHeader.h") can be compiled unchanged by the CMake build in this
+    folder. JucePlugin_Name is defined separately for each effect in CMakeLists.txt.
+*/
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <juce_events/juce_events.h>
+#include <juce_graphics/juce_graphics.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+using namespace juce;
+
+namespace ProjectInfo
+{
+    const char* const  projectName    = "EffectsBench";
+    const char* const  companyName    = "Dunne-Reiss-McPherson";
+    const char* const  versionString  = "1.0.0";
+    const int          versionNumber  = 0x10000;
+}
@@ -0,0 +1,58 @@
+#include "KernelBenchmarks.h"
+#include <cstdio>
+
+// Kernel benchmark functions, one per kernel; see e.g. CompressorKernels.cpp
+#define DECLARE_KERNEL(function) void function(const KernelBenchmarks::Settings&);
+DECLARE_KERNEL(benchmarkCompressorGain)
+DECLARE_KERNEL(benchmarkDelayLine)
+DECLARE_KERNEL(benchmarkDistortion)
+DECLARE_KERNEL(benchmarkDistortionShaper)
+DECLARE_KERNEL(benchmarkTransferCurve)
+DECLARE_KERNEL(benchmarkLFO)
+DECLARE_KERNEL(benchmarkParametricEQ)
+DECLARE_KERNEL(benchmarkLinearPhaseEQ)
+DECLARE_KERNEL(benchmarkAutoWah)
+DECLARE_KERNEL(benchmarkAutoWahChannels)
+DECLARE_KERNEL(benchmarkPhaser)
+DECLARE_KERNEL(benchmarkStaticDelay)
+#undef DECLARE_KERNEL
+
+const Array<KernelBenchmarks::Entry>& KernelBenchmarks::getEntries()
+{
+    static const Array<Entry> entries
+    {
+        { "compressor-gain", benchmarkCompressorGain },
+        { "delay-line", benchmarkDelayLine },
+        { "distortion", benchmarkDistortion },
+        { "distortion-shaper", benchmarkDistortionShaper },
+        { "transfer-curve", benchmarkTransferCurve },
+        { "lfo", benchmarkLFO },
+        { "parametric-eq", benchmarkParametricEQ },
+        { "linear-phase-eq", benchmarkLinearPhaseEQ },
+        { "auto-wah", benchmarkAutoWah },
+        { "auto-wah-channels", benchmarkAutoWahChannels },
+        { "phaser", benchmarkPhaser },
+        { "static-delay", benchmarkStaticDelay },
+    };
+    return entries;
+}
+
+const KernelBenchmarks::Entry* KernelBenchmarks::find(const String& name)
+{
+    for (auto& entry : getEntries())
+        if (name.equalsIgnoreCase(entry.name))
+            return &entry;
+    return nullptr;
+}
+
+void KernelBenchmarks::printHeading()
+{
+    printf("%-18s %7s %-12s %9s %8s  %s\n", "kernel", "block", "variant", "ns/sample", "speedup", "max error");
+}
+
+void KernelBenchmarks::printResult(const char* kernelName, int blockSize, const char* variant,
+                                   double nsPerSample, double referenceNsPerSample, const String& maxError)
+{
+    printf("%-18s %7d %-12s %9.2f %7.2fx  %s\n", kernelName, blockSize, variant, nsPerSample,
+           nsPerSample > 0.0 ? referenceNsPerSample / nsPerSample : 0.0, maxError.toRawUTF8());
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "JuceHeader.h"
+#include <chrono>
+
+/*  KernelBenchmarks times individual DSP kernels (as opposed to whole processors), each
+    against a reference version of the same computation, usually the code it replaced.
+    Run with EffectsBench --kernel=<name>; each kernel prints one line per variant and block
+    size, with its speed relative to the reference and its maximum deviation from it.
+*/
+
+struct KernelBenchmarks
+{
+    struct Settings
+    {
+        double sampleRate;
+        int numSamples;             // length of test signal
+        Array<int> blockSizes;
+        int repeats;                // passes over the signal; the fastest is reported
+    };
+
+    struct Entry
+    {
+        const char* name;
+        void (*run)(const Settings&);
+    };
+
+    static const Array<Entry>& getEntries();
+
+    // Returns nullptr if there is no kernel with the given name (case-insensitive)
+    static const Entry* find(const String& name);
+
+    static void printHeading();
+    static void printResult(const char* kernelName, int blockSize, const char* variant,
+                            double nsPerSample, double referenceNsPerSample, const String& maxError);
+
+    // Calls process(startSample, numSamples) for successive blocks over the whole test signal,
+    // settings.repeats times, and returns the fastest time per sample in nanoseconds.
+    template <typename ProcessFunction>
+    static double timePerSample(const Settings& settings, int blockSize, ProcessFunction&& process)
+    {
+        using Clock = std::chrono::steady_clock;
+        double bestNs = 0.0;
+        for (int pass = 0; pass < settings.repeats; pass++)
+        {
+            auto startTime = Clock::now();
+            for (int start = 0; start < settings.numSamples; start += blockSize)
+                process(start, jmin(blockSize, settings.numSamples - start));
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+            if (pass == 0 || ns < bestNs) bestNs = double(ns);
+        }
+        return bestNs / settings.numSamples;
+    }
+};
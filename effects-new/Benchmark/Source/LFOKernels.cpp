@@ -0,0 +1,139 @@
+/*  Kernel benchmarks for the BlockLFO shared by the modulation effects (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "BlockLFO.h"
+
+namespace
+{
+    // A stereo load, as in the Phaser and Flanger: the second channel's LFO is a quarter
+    // cycle ahead of the first's
+    const int numChannels = 2;
+    const float lfoFreqHz = 0.5f;
+
+    // The original per-effect code: each channel steps its own copy of the phase, and works
+    // out every sample with a switch and sinf()
+    struct ReferenceLFO
+    {
+        float lfoPhase = 0.0f;
+        float inverseSampleRate;
+        BlockLFO::Waveform waveform;
+
+        ReferenceLFO(double sampleRate, BlockLFO::Waveform waveformToUse)
+            : inverseSampleRate(float(1.0 / sampleRate)), waveform(waveformToUse)
+        {
+        }
+
+        static float getSample(float phase, BlockLFO::Waveform waveform)
+        {
+            switch (waveform)
+            {
+            case BlockLFO::kWaveformTriangle:
+                if (phase < 0.25f)
+                    return 0.5f + 2.0f*phase;
+                else if (phase < 0.75f)
+                    return 1.0f - 2.0f*(phase - 0.25f);
+                else
+                    return 2.0f*(phase - 0.75f);
+            case BlockLFO::kWaveformSine:
+            default:
+                return 0.5f + 0.5f*sinf(6.283185f * phase);
+            }
+        }
+
+        void process(float* const* outputs, int numSamples)
+        {
+            float ph = lfoPhase;
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                ph = lfoPhase;
+                if (channel != 0)
+                    ph = fmodf(ph + 0.25f, 1.0f);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    outputs[channel][i] = getSample(ph, waveform);
+                    ph += lfoFreqHz * inverseSampleRate;
+                    while (ph >= 1.0f) ph -= 1.0f;
+                }
+
+                if (channel == 0) lfoPhase = ph;
+            }
+        }
+    };
+
+    // BlockLFO, as the effects use it: advance once, then render one buffer per phase offset
+    struct BlockLFOVariant
+    {
+        BlockLFO lfo;
+        BlockLFO::Waveform waveform;
+
+        BlockLFOVariant(double sampleRate, int maxBlockSize, BlockLFO::Waveform waveformToUse)
+            : waveform(waveformToUse)
+        {
+            lfo.prepare(sampleRate, maxBlockSize, numChannels);
+        }
+
+        void process(float* const* outputs, int numSamples)
+        {
+            lfo.advance(numSamples, lfoFreqHz);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* lfoOut = lfo.render(channel, waveform, numSamples, 0.25f * channel);
+                FloatVectorOperations::copy(outputs[channel], lfoOut, numSamples);
+            }
+        }
+    };
+}
+
+void benchmarkLFO(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> referenceOutput(numChannels, settings.numSamples);
+    AudioBuffer<float> optimizedOutput(numChannels, settings.numSamples);
+
+    const std::pair<BlockLFO::Waveform, const char*> waveforms[] =
+    {
+        { BlockLFO::kWaveformSine, "sine" },
+        { BlockLFO::kWaveformTriangle, "triangle" },
+    };
+
+    for (int blockSize : settings.blockSizes)
+    {
+        for (auto& waveform : waveforms)
+        {
+            // Times are reported per channel, i.e. the cost of one LFO sample
+            ReferenceLFO reference(settings.sampleRate, waveform.first);
+            double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                float* outputs[numChannels];
+                for (int channel = 0; channel < numChannels; ++channel)
+                    outputs[channel] = referenceOutput.getWritePointer(channel, start);
+                reference.process(outputs, count);
+            }) / numChannels;
+            String referenceName = String("reference-") + waveform.second;
+            KernelBenchmarks::printResult("lfo", blockSize, referenceName.toRawUTF8(), referenceNs, referenceNs, {});
+
+            BlockLFOVariant block(settings.sampleRate, blockSize, waveform.first);
+            double blockNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                float* outputs[numChannels];
+                for (int channel = 0; channel < numChannels; ++channel)
+                    outputs[channel] = optimizedOutput.getWritePointer(channel, start);
+                block.process(outputs, count);
+            }) / numChannels;
+
+            // The reference accumulates its phase in single precision, one sample at a time, so
+            // over a long signal it drifts slightly from BlockLFO's
+            float maxError = 0.0f;
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* referenceOut = referenceOutput.getReadPointer(channel);
+                const float* optimizedOut = optimizedOutput.getReadPointer(channel);
+                for (int i = 0; i < settings.numSamples; ++i)
+                    maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            }
+            String blockName = String("block-") + waveform.second;
+            KernelBenchmarks::printResult("lfo", blockSize, blockName.toRawUTF8(), blockNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*  Kernel benchmarks for the Parametric EQ effect (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "ParametricEQFilter.h"
+#include "LinearPhaseEQ.h"
+
+namespace
+{
+    // Alternate boosts and cuts, spread across the audio range, as in a typical mastering EQ
+    ParametricEQFilter::Coefficients makeTestBand(int band, double sampleRate)
+    {
+        const double frequencyHz = 60.0 * std::pow(2.0, 1.1 * band);
+        const double gainDb = (band % 2 == 0) ? 6.0 : -6.0;
+        return ParametricEQFilter::makeBand(ParametricEQFilter::kPeaking,
+                                            MathConstants<double>::twoPi * frequencyHz / sampleRate,
+                                            1.0, Decibels::decibelsToGain(gainDb));
+    }
+}
+
+// ParametricEQFilter's vectorized cascade against the same bands as a chain of JUCE IIRFilters,
+// one per band, as the original single-band effect would run them (one plug-in per band), on
+// one channel of noise. Only numBands bands are active in the cascade; it always does the
+// work of ParametricEQFilter::numBands, so is compared with chains of several lengths.
+void benchmarkParametricEQ(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+    float* referenceOut = referenceOutput.getWritePointer(0);
+    float* optimizedOut = optimizedOutput.getWritePointer(0);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        for (int numBands : { 2, 4, ParametricEQFilter::numBands })
+        {
+            OwnedArray<IIRFilter> chain;
+            ParametricEQFilter cascade;
+            for (int band = 0; band < numBands; ++band)
+            {
+                auto c = makeTestBand(band, settings.sampleRate);
+                chain.add(new IIRFilter)->setCoefficients(IIRCoefficients(c.b0, c.b1, c.b2, 1.0, c.a1, c.a2));
+                cascade.setBand(band, c);
+            }
+
+            double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copy(referenceOut + start, in + start, count);
+                for (auto filter : chain)
+                    filter->processSamples(referenceOut + start, count);
+            });
+            String referenceName = "reference-" + String(numBands);
+            KernelBenchmarks::printResult("parametric-eq", blockSize, referenceName.toRawUTF8(),
+                                          referenceNs, referenceNs, {});
+
+            double cascadeNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copy(optimizedOut + start, in + start, count);
+                cascade.processSamples(optimizedOut + start, count);
+            });
+
+            float maxError = 0.0f;
+            for (int i = 0; i < settings.numSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            String cascadeName = "cascade-" + String(numBands);
+            KernelBenchmarks::printResult("parametric-eq", blockSize, cascadeName.toRawUTF8(),
+                                          cascadeNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
+
+// LinearPhaseEQ's partitioned FFT convolution at each block size, against the same FIR filter
+// applied directly, tap by tap, to one channel of noise. The taps are one convolver's own
+// impulse response, so the max error is only rounding (every block size designs the same
+// filter); each block size's output is one block later than the direct filter's, which is
+// allowed for.
+void benchmarkLinearPhaseEQ(const KernelBenchmarks::Settings& settings)
+{
+    AudioBuffer<float> input(1, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+
+    AudioBuffer<float> referenceOutput(1, settings.numSamples), optimizedOutput(1, settings.numSamples);
+    const float* in = input.getReadPointer(0);
+    float* referenceOut = referenceOutput.getWritePointer(0);
+    float* optimizedOut = optimizedOutput.getWritePointer(0);
+
+    ParametricEQFilter::Coefficients bands[ParametricEQFilter::numBands];
+    for (int band = 0; band < ParametricEQFilter::numBands; ++band)
+        bands[band] = makeTestBand(band, settings.sampleRate);
+
+    // Process part of one of the output buffers in place, through an AudioBuffer referring to it
+    auto processInPlace = [](LinearPhaseEQ& eq, float* data, int count)
+    {
+        AudioBuffer<float> block(&data, 1, count);
+        eq.processBlock(block, 1);
+    };
+
+    OwnedArray<LinearPhaseEQ> eqs;
+    for (int b = 0; b < LinearPhaseEQ::kNumBlockSizes; ++b)
+    {
+        auto eq = eqs.add(new LinearPhaseEQ);
+        eq->prepare(settings.sampleRate, 1);
+        eq->setBands(bands, LinearPhaseEQ::BlockSize(b));
+        eq->designNow();
+    }
+
+    // The filter's taps, by way of a unit impulse (they come out one block late)
+    const int firstBlockSamples = LinearPhaseEQ::getBlockSamples(LinearPhaseEQ::BlockSize(0));
+    const int numTaps = 2 * (eqs[0]->getLatencySamples(LinearPhaseEQ::BlockSize(0)) - firstBlockSamples);
+    jassert(settings.numSamples >= 2 * numTaps + LinearPhaseEQ::getBlockSamples(LinearPhaseEQ::kBlock2048));
+    FloatVectorOperations::clear(optimizedOut, firstBlockSamples + numTaps);
+    optimizedOut[0] = 1.0f;
+    processInPlace(*eqs[0], optimizedOut, firstBlockSamples + numTaps);
+    HeapBlock<float> taps(numTaps);
+    FloatVectorOperations::copy(taps, optimizedOut + firstBlockSamples, numTaps);
+    eqs[0]->reset();
+
+    // The direct filter reads numTaps - 1 samples before each block, so the input is copied
+    // after that many zeros. One tap at a time, over the whole block, vectorizes.
+    HeapBlock<float> padded(numTaps + settings.numSamples, true);
+    FloatVectorOperations::copy(padded + numTaps, in, settings.numSamples);
+    const float* paddedIn = padded + numTaps;
+
+    for (int blockSize : settings.blockSizes)
+    {
+        double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+        {
+            FloatVectorOperations::clear(referenceOut + start, count);
+            for (int t = 0; t < numTaps; ++t)
+                FloatVectorOperations::addWithMultiply(referenceOut + start, paddedIn + start - t, taps[t], count);
+        });
+        KernelBenchmarks::printResult("linear-phase-eq", blockSize, "reference", referenceNs, referenceNs, {});
+
+        for (int b = 0; b < LinearPhaseEQ::kNumBlockSizes; ++b)
+        {
+            LinearPhaseEQ& eq = *eqs[b];
+            const int firBlockSamples = LinearPhaseEQ::getBlockSamples(LinearPhaseEQ::BlockSize(b));
+            double partitionedNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                FloatVectorOperations::copy(optimizedOut + start, in + start, count);
+                processInPlace(eq, optimizedOut + start, count);
+            });
+
+            // (the start of each pass follows on from the end of the one before)
+            float maxError = 0.0f;
+            for (int i = numTaps; i < settings.numSamples - firBlockSamples; ++i)
+                maxError = jmax(maxError, std::abs(optimizedOut[i + firBlockSamples] - referenceOut[i]));
+            String partitionedName = "partitioned-" + String(firBlockSamples);
+            KernelBenchmarks::printResult("linear-phase-eq", blockSize, partitionedName.toRawUTF8(),
+                                          partitionedNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
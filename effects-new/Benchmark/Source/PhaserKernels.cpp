@@ -0,0 +1,176 @@
+/*  Kernel benchmarks for the Phaser effect (see KernelBenchmarks.h)
+*/
+
+#include "KernelBenchmarks.h"
+#include "TestSignals.h"
+#include "AllpassCascade.h"
+#include "OnePoleAllpassFilter.h"
+
+namespace
+{
+    // The plug-in's default settings, with some feedback, for stereo phasing
+    AllpassCascade::Sweep makeTestSweep(double sampleRate, int numStages)
+    {
+        AllpassCascade::Sweep sweep;
+        sweep.inverseSampleRate = 1.0 / sampleRate;
+        sweep.baseFreqHz = 200.0f;
+        sweep.sweepWidthHz = 2000.0f;
+        sweep.lfo = sweep.otherChannelsLfo = nullptr;
+        sweep.numStages = numStages;
+        sweep.feedback = 0.5f;
+        sweep.depth = 1.0f;
+        return sweep;
+    }
+
+    // The original PhaserProcessor loop: one OnePoleAllpassFilter object per stage per channel,
+    // all channel 0's first, with new coefficients every filterUpdateInterval samples
+    struct Reference
+    {
+        OwnedArray<OnePoleAllpassFilter> allpassFilters;
+        float lastFilterOutputs[2];
+        unsigned int sampleCount = 0;
+
+        Reference(int numStages)
+        {
+            for (int i = 0; i < 2 * numStages; ++i)
+                allpassFilters.add(new OnePoleAllpassFilter);
+            lastFilterOutputs[0] = lastFilterOutputs[1] = 0.0f;
+        }
+
+        void processSamples(float* const* channelData, int numSamples, const AllpassCascade::Sweep& sweep)
+        {
+            const unsigned int filterUpdateInterval = 8;
+            const int filtersPerChannel = sweep.numStages;
+            unsigned int sc = sampleCount;
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                float* samples = channelData[channel];
+                const float* lfoSamples = channel == 0 ? sweep.lfo : sweep.otherChannelsLfo;
+                sc = sampleCount;
+
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    float out = samples[sample];
+                    if (sweep.feedback != 0.0)
+                        out += sweep.feedback * lastFilterOutputs[channel];
+
+                    for (int j = 0; j < filtersPerChannel; ++j)
+                    {
+                        if (channel * filtersPerChannel + j >= allpassFilters.size())
+                            continue;
+                        auto filter = allpassFilters[channel * filtersPerChannel + j];
+                        if (sc % filterUpdateInterval == 0)
+                        {
+                            double centreFrequency = sweep.baseFreqHz + sweep.sweepWidthHz * lfoSamples[sample];
+                            filter->makeAllpass(sweep.inverseSampleRate, centreFrequency);
+                        }
+                        out = filter->processSingleSampleRaw(out);
+                    }
+
+                    lastFilterOutputs[channel] = out;
+                    float dfrac = 0.5f * sweep.depth;
+                    samples[sample] = (1.0f - dfrac) * samples[sample] + dfrac * out;
+                    sc++;
+                }
+            }
+            sampleCount = sc;
+        }
+    };
+}
+
+// AllpassCascade against the original loop, on two channels of noise with a sine LFO (a
+// quarter cycle apart on the second channel, as in the effect's stereo mode) and 50% feedback,
+// for several numbers of stages; times are per sample frame, i.e. for both channels together.
+// The cascade's feedback loop has no delay in it, unlike the original's, so the two are meant
+// to sound different with feedback; the error is measured from a second, untimed run of each
+// with the feedback off. The original only worked out new coefficients every 8 samples, while
+// the cascade does so on every sample, which accounts for most of that "error".
+void benchmarkPhaser(const KernelBenchmarks::Settings& settings)
+{
+    const int numChannels = 2;
+    AudioBuffer<float> input(numChannels, settings.numSamples);
+    TestSignals::generate(TestSignals::kNoise, input, settings.sampleRate);
+    AudioBuffer<float> referenceOutput(numChannels, settings.numSamples), optimizedOutput(numChannels, settings.numSamples);
+
+    // 1 Hz, a little faster than the default, for more movement
+    HeapBlock<float> lfo(settings.numSamples), quadratureLfo(settings.numSamples);
+    for (int i = 0; i < settings.numSamples; ++i)
+    {
+        const double phase = MathConstants<double>::twoPi * i / settings.sampleRate;
+        lfo[i] = float(0.5 + 0.5 * std::sin(phase));
+        quadratureLfo[i] = float(0.5 + 0.5 * std::sin(phase + MathConstants<double>::halfPi));
+    }
+
+    for (int blockSize : settings.blockSizes)
+    {
+        for (int numStages : { 4, 8, 16, 24, AllpassCascade::maxStages })
+        {
+            auto sweep = makeTestSweep(settings.sampleRate, numStages);
+            auto setBlock = [&](int start)
+            {
+                sweep.lfo = lfo + start;
+                sweep.otherChannelsLfo = quadratureLfo + start;
+            };
+            auto copyInput = [&](AudioBuffer<float>& output, float** channels, int start, int count)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    channels[ch] = output.getWritePointer(ch, start);
+                    FloatVectorOperations::copy(channels[ch], input.getReadPointer(ch, start), count);
+                }
+            };
+
+            std::unique_ptr<Reference> reference;
+            double referenceNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                if (start == 0) reference.reset(new Reference(numStages));
+                float* channels[numChannels];
+                copyInput(referenceOutput, channels, start, count);
+                setBlock(start);
+                reference->processSamples(channels, count, sweep);
+            });
+            String referenceName = "reference-" + String(numStages);
+            KernelBenchmarks::printResult("phaser", blockSize, referenceName.toRawUTF8(),
+                                          referenceNs, referenceNs, {});
+
+            AllpassCascade cascade;
+            cascade.prepare(numChannels);
+            double cascadeNs = KernelBenchmarks::timePerSample(settings, blockSize, [&](int start, int count)
+            {
+                if (start == 0) cascade.reset();
+                float* channels[numChannels];
+                copyInput(optimizedOutput, channels, start, count);
+                setBlock(start);
+                cascade.processSamples(channels, numChannels, count, sweep);
+            });
+
+            // Both again, from the start, without feedback
+            sweep.feedback = 0.0f;
+            reference.reset(new Reference(numStages));
+            cascade.reset();
+            for (int start = 0; start < settings.numSamples; start += blockSize)
+            {
+                const int count = jmin(blockSize, settings.numSamples - start);
+                float* channels[numChannels];
+                setBlock(start);
+                copyInput(referenceOutput, channels, start, count);
+                reference->processSamples(channels, count, sweep);
+                copyInput(optimizedOutput, channels, start, count);
+                cascade.processSamples(channels, numChannels, count, sweep);
+            }
+
+            float maxError = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* referenceOut = referenceOutput.getReadPointer(ch);
+                const float* optimizedOut = optimizedOutput.getReadPointer(ch);
+                for (int i = 0; i < settings.numSamples; ++i)
+                    maxError = jmax(maxError, std::abs(optimizedOut[i] - referenceOut[i]));
+            }
+            String cascadeName = "cascade-" + String(numStages);
+            KernelBenchmarks::printResult("phaser", blockSize, cascadeName.toRawUTF8(),
+                                          cascadeNs, referenceNs, String(maxError, 7));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "TestSignals.h"
+#define TWOPI_D 6.283185307179586
+
+const char* TestSignals::getName(Type type)
+{
+    switch (type)
+    {
+    case kSine:     return "sine";
+    case kSweep:    return "sweep";
+    case kNoise:    return "noise";
+    case kImpulse:  return "impulse";
+    case kSilence:  return "silence";
+    default:        return "";
+    }
+}
+
+bool TestSignals::parseName(const String& name, Type& type)
+{
+    for (int i = 0; i < kNumTypes; i++)
+    {
+        if (name.equalsIgnoreCase(getName(Type(i))))
+        {
+            type = Type(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TestSignals::generate(Type type, AudioBuffer<float>& buffer, double sampleRate)
+{
+    const int numSamples = buffer.getNumSamples();
+    const float amplitude = 0.5f;   // -6 dBFS
+    buffer.clear();
+
+    switch (type)
+    {
+    case kSine:
+    {
+        const double dphi = TWOPI_D * 440.0 / sampleRate;
+        for (int i = 0; i < numSamples; i++)
+            buffer.setSample(0, i, amplitude * float(sin(dphi * i)));
+        break;
+    }
+
+    case kSweep:
+    {
+        // Exponential sweep: instantaneous frequency f1 * (f2/f1)^(t/T)
+        const double f1 = 20.0, f2 = 20000.0;
+        const double T = numSamples / sampleRate;
+        const double k = log(f2 / f1);
+        for (int i = 0; i < numSamples; i++)
+        {
+            double t = i / sampleRate;
+            double phase = TWOPI_D * f1 * T / k * (exp(t * k / T) - 1.0);
+            buffer.setSample(0, i, amplitude * float(sin(phase)));
+        }
+        break;
+    }
+
+    case kNoise:
+    {
+        Random random(12345);
+        for (int i = 0; i < numSamples; i++)
+            buffer.setSample(0, i, amplitude * (2.0f * random.nextFloat() - 1.0f));
+        break;
+    }
+
+    case kImpulse:
+        if (numSamples > 0) buffer.setSample(0, 0, 1.0f);
+        break;
+
+    case kSilence:
+    default:
+        break;
+    }
+
+    // all channels carry the same signal
+    for (int ch = 1; ch < buffer.getNumChannels(); ch++)
+        buffer.copyFrom(ch, 0, buffer, 0, 0, numSamples);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  Synthetic input signals for EffectsBench, for when no input file is given.
+    All are deterministic, so repeated runs process identical audio.
+*/
+
+struct TestSignals
+{
+    enum Type
+    {
+        kSine = 0,          // 440 Hz, -6 dBFS
+        kSweep,             // logarithmic sine sweep 20 Hz to 20 kHz, -6 dBFS
+        kNoise,             // white noise, -6 dBFS peak, fixed seed
+        kImpulse,           // single full-scale impulse at the start
+        kSilence,
+        kNumTypes
+    };
+
+    static const char* getName(Type type);
+    static bool parseName(const String& name, Type& type);
+
+    static void generate(Type type, AudioBuffer<float>& buffer, double sampleRate);
+};
@@ -0,0 +1,80 @@
+#include "AutomationScheduler.h"
+
+AutomationScheduler::AutomationScheduler(int capacityToUse)
+    : capacity(capacityToUse)
+    , fifo(capacityToUse)
+    , scheduled(capacityToUse, true)
+    , pending(capacityToUse, true)
+    , numPending(0)
+    , nextPending(0)
+    , samplePosition(0)
+{
+}
+
+bool AutomationScheduler::scheduleChange(AudioProcessorParameter* parameter, float normalisedValue,
+                                         int64 changePosition)
+{
+    jassert(parameter != nullptr);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 < 1) return false;
+
+    scheduled[size1 > 0 ? start1 : start2] = { parameter, normalisedValue, changePosition };
+    fifo.finishedWrite(1);
+    return true;
+}
+
+bool AutomationScheduler::scheduleChange(AudioProcessorValueTreeState& vts, const String& paramID,
+                                         float value, int64 changePosition)
+{
+    auto* parameter = vts.getParameter(paramID);
+    if (parameter == nullptr) return false;
+
+    return scheduleChange(parameter, parameter->convertTo0to1(value), changePosition);
+}
+
+void AutomationScheduler::collectScheduledChanges()
+{
+    // discard changes already applied, to make room at the end of pending
+    if (nextPending > 0)
+    {
+        numPending -= nextPending;
+        for (int i = 0; i < numPending; ++i)
+            pending[i] = pending[nextPending + i];
+        nextPending = 0;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(jmin(fifo.getNumReady(), capacity - numPending), start1, size1, start2, size2);
+    const int numNew = size1 + size2;
+
+    for (int n = 0; n < numNew; ++n)
+    {
+        const Change& change = scheduled[n < size1 ? start1 + n : start2 + n - size1];
+
+        // insertion sort; a change goes after any others at the same position,
+        // so changes to the same parameter at the same time apply in the order scheduled
+        int i = numPending++;
+        while (i > 0 && pending[i - 1].samplePosition > change.samplePosition)
+        {
+            pending[i] = pending[i - 1];
+            --i;
+        }
+        pending[i] = change;
+    }
+
+    fifo.finishedRead(numNew);
+}
+
+void AutomationScheduler::applyChangesUpTo(int64 position)
+{
+    while (nextPending < numPending && pending[nextPending].samplePosition <= position)
+    {
+        const Change& change = pending[nextPending++];
+
+        // exactly as a host sets a parameter, so the processor's listeners are called (right now,
+        // on this thread) and the host and GUI are informed
+        change.parameter->setValueNotifyingHost(change.normalisedValue);
+    }
+}
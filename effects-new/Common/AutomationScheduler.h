@@ -0,0 +1,104 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  AutomationScheduler makes parameter changes sample-accurate. Instead of setting a parameter
+    directly (in which case the change takes effect at the start of whichever block is processed
+    next), a renderer or host calls scheduleChange(), giving the sample position at which the new
+    value should take effect. The processor's processBlock() then hands the block to
+    processBlock() below, which splits it into sub-blocks at the scheduled positions, setting
+    each parameter (and so calling its listeners) between one sub-block and the next.
+
+    Sample positions count from 0 at the last reset(), which processors call in prepareToPlay().
+    Since every change lands on the same sample whatever the block size, rendering the same
+    input with the same scheduled changes gives the same output at any block size, provided the
+    processor's own DSP doesn't depend on block boundaries.
+
+    scheduleChange() is lock-free and may be called from any one thread at a time (normally the
+    one driving the render). Changes scheduled for a position which has already been processed
+    take effect at the start of the next block.
+*/
+
+class AutomationScheduler
+{
+public:
+    // Processors which own an AutomationScheduler implement this, so renderers can find it
+    struct Owner
+    {
+        virtual ~Owner() = default;
+        virtual AutomationScheduler& getAutomationScheduler() = 0;
+    };
+
+    AutomationScheduler(int capacity = 1024);
+
+    // Any thread: returns false (and drops the change) if too many changes are already waiting
+    bool scheduleChange(AudioProcessorParameter* parameter, float normalisedValue, int64 samplePosition);
+
+    // Convenience version: looks up the parameter by ID, and takes a value in the parameter's
+    // own units; returns false if there is no such parameter
+    bool scheduleChange(AudioProcessorValueTreeState& vts, const String& paramID,
+                        float value, int64 samplePosition);
+
+    // Audio thread (or before processing starts): set the sample position of the next block
+    void reset(int64 startPosition = 0) { samplePosition = startPosition; }
+    int64 getSamplePosition() const { return samplePosition; }
+
+    // Audio thread: calls processSubBlock(AudioBuffer<float>&) once for each part of buffer
+    // between scheduled changes (just once, with buffer itself, if there are none)
+    template <typename SubBlockFunction>
+    void processBlock(AudioBuffer<float>& buffer, SubBlockFunction&& processSubBlock)
+    {
+        collectScheduledChanges();
+
+        const int numSamples = buffer.getNumSamples();
+        int start = 0;
+        while (start < numSamples)
+        {
+            applyChangesUpTo(samplePosition + start);
+
+            // every change still pending is after start, so end > start
+            int end = numSamples;
+            if (nextPending < numPending)
+                end = int(jmin(int64(numSamples), pending[nextPending].samplePosition - samplePosition));
+
+            if (start == 0 && end == numSamples)
+                processSubBlock(buffer);
+            else
+            {
+                // refers to buffer's own sample data (no allocation, up to 32 channels)
+                AudioBuffer<float> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                            start, end - start);
+                processSubBlock(subBlock);
+            }
+            start = end;
+        }
+
+        samplePosition += numSamples;
+    }
+
+private:
+    struct Change
+    {
+        AudioProcessorParameter* parameter;
+        float normalisedValue;
+        int64 samplePosition;
+    };
+
+    // Move newly-scheduled changes from the fifo into pending, keeping it sorted by position
+    void collectScheduledChanges();
+
+    // Apply (in order) every pending change scheduled at or before position
+    void applyChangesUpTo(int64 position);
+
+    const int capacity;
+
+    // written by scheduleChange(), read by the audio thread
+    AbstractFifo fifo;
+    HeapBlock<Change> scheduled;
+
+    // audio thread only: changes not yet applied are pending[nextPending .. numPending-1]
+    HeapBlock<Change> pending;
+    int numPending, nextPending;
+    int64 samplePosition;
+
+    JUCE_DECLARE_NON_COPYABLE(AutomationScheduler)
+};
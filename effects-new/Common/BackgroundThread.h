@@ -0,0 +1,23 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  BackgroundThread is one TimeSliceThread, shared by every instance of a plugin, for work which
+    must not be done on the audio thread, such as the Distortion's custom curve compiler or the
+    Parametric EQ's linear-phase filter designer.
+
+    Hold one through a SharedResourcePointer<BackgroundThread>: the first one created starts the
+    thread, and it stops when the last one goes. Each job is a TimeSliceClient, added with
+    addTimeSliceClient() and removed (which waits, if the job is running) with
+    removeTimeSliceClient(), and its useTimeSlice() says when it next wants to be called. A host
+    may load hundreds of instances of a plugin, and they then share a single thread, rather than
+    each waking one of its own.
+*/
+
+class BackgroundThread : public TimeSliceThread
+{
+public:
+    BackgroundThread() : TimeSliceThread("Effects background thread") { startThread(); }
+    ~BackgroundThread() { stopThread(1000); }
+
+    JUCE_DECLARE_NON_COPYABLE(BackgroundThread)
+};
@@ -32,8 +32,11 @@ void BarGraph::paint (Graphics& g)
 
 void BarGraph::setValue(float v)
 {
+    if (v < 0.0f) v = 0.0f;
+    if (v > 1.0f) v = 1.0f;
+
+    // Meters are typically polled many times a second; don't repaint if nothing changed
+    if (v == value) return;
     value = v;
-    if (value < 0.0f) value = 0.0f;
-    if (value > 1.0f) value = 1.0f;
 	repaint();
 }
@@ -0,0 +1,222 @@
+#include "BlockLFO.h"
+
+namespace
+{
+    // One cycle of each waveform, with a guard point at the end (equal to the first), so a
+    // linear interpolation never needs to wrap. 1200 points puts every corner of the piecewise-
+    // linear waveforms (at 0.25, 0.48, 0.5, 0.75 and 0.98 of a cycle) exactly on a table point,
+    // so they come out exact, apart from the jumps in the square and sawtooth waves, which become
+    // ramps 1/1200 of a cycle long. The sine is within a few millionths.
+    const int tableSize = 1200;
+    float tables[BlockLFO::kNumWaveforms][tableSize + 1];
+
+    // The waveforms exactly as the original per-effect LFO classes computed them
+    float computeSample(BlockLFO::Waveform waveform, float phase)
+    {
+        switch (waveform)
+        {
+        case BlockLFO::kWaveformTriangle:
+            if (phase < 0.25f)
+                return 0.5f + 2.0f*phase;
+            else if (phase < 0.75f)
+                return 1.0f - 2.0f*(phase - 0.25f);
+            else
+                return 2.0f*(phase - 0.75f);
+        case BlockLFO::kWaveformSquare:
+            if (phase < 0.5f)
+                return 1.0f;
+            else
+                return 0.0f;
+        case BlockLFO::kWaveformSquareSlopedEdges:
+            if (phase < 0.48f)
+                return 1.0f;
+            else if (phase < 0.5f)
+                return 1.0f - 50.0f*(phase - 0.48f);
+            else if (phase < 0.98f)
+                return 0.0f;
+            else
+                return 50.0f*(phase - 0.98f);
+        case BlockLFO::kWaveformSawtooth:
+            if (phase < 0.5f)
+                return 0.5f + phase;
+            else
+                return phase - 0.5f;
+        case BlockLFO::kWaveformInverseSawtooth:
+            if (phase < 0.5f)
+                return 0.5f - phase;
+            else
+                return 1.5f - phase;
+        case BlockLFO::kWaveformSine:
+        default:
+            return 0.5f + 0.5f*std::sin(MathConstants<float>::twoPi * phase);
+        }
+    }
+
+    // Fills in the tables during static initialisation, long before any audio thread needs them
+    struct TableInitialiser
+    {
+        TableInitialiser()
+        {
+            for (int w = 0; w < BlockLFO::kNumWaveforms; ++w)
+            {
+                for (int i = 0; i < tableSize; ++i)
+                    tables[w][i] = computeSample(BlockLFO::Waveform(w), float(double(i) / tableSize));
+                tables[w][tableSize] = tables[w][0];
+            }
+        }
+    };
+
+    TableInitialiser tableInitialiser;
+
+    // Quarter notes per cycle for each sync setting, or per bar for the bar-based ones
+    const double quarterNotesPerCycle[BlockLFO::kNumSyncs] = { 0.0, 4.0, 2.0, 1.0, 2.0, 1.0, 0.5, 0.25 };
+    const bool isBarBased[BlockLFO::kNumSyncs] = { false, true, true, true, false, false, false, false };
+}
+
+void BlockLFO::populateSyncComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("Off", ++itemNumber);
+    cb.addItem("4 bars", ++itemNumber);
+    cb.addItem("2 bars", ++itemNumber);
+    cb.addItem("1 bar", ++itemNumber);
+    cb.addItem("1/2", ++itemNumber);
+    cb.addItem("1/4", ++itemNumber);
+    cb.addItem("1/8", ++itemNumber);
+    cb.addItem("1/16", ++itemNumber);
+}
+
+BlockLFO::BlockLFO()
+    : maxBlockSize(0)
+    , numOutputs(1)
+    , phase(0.0)
+    , inverseSampleRate(1.0 / 44100.0)
+    , sync(kSyncOff)
+    , syncedFrequencyHz(0.0)
+{
+}
+
+void BlockLFO::prepare(double sampleRate, int maxSamplesPerBlock, int numOutputsToUse)
+{
+    inverseSampleRate = 1.0 / sampleRate;
+    maxBlockSize = maxSamplesPerBlock;
+    numOutputs = jmax(1, numOutputsToUse);
+    phases.allocate(size_t(maxBlockSize), true);
+    outputs.allocate(size_t(maxBlockSize * numOutputs), true);
+    reset();
+}
+
+void BlockLFO::reset(float startPhase)
+{
+    phase = startPhase;
+    syncedFrequencyHz = 0.0;
+}
+
+void BlockLFO::syncToPlayHead(AudioPlayHead* playHead)
+{
+    syncedFrequencyHz = 0.0;
+
+    AudioPlayHead::CurrentPositionInfo position;
+    if (sync == kSyncOff || playHead == nullptr || !playHead->getCurrentPosition(position) || position.bpm <= 0.0)
+        return;
+
+    double cycleQuarterNotes = quarterNotesPerCycle[sync];
+    if (isBarBased[sync] && position.timeSigDenominator > 0)
+        cycleQuarterNotes *= 4.0 * position.timeSigNumerator / position.timeSigDenominator;
+
+    syncedFrequencyHz = position.bpm / (60.0 * cycleQuarterNotes);
+
+    // While the host plays, the phase follows the song position, so the LFO lines up with the
+    // beat however playback was started, and stays lined up through loops and jumps
+    if (position.isPlaying)
+    {
+        double cycles = position.ppqPosition / cycleQuarterNotes;
+        phase = cycles - std::floor(cycles);
+    }
+}
+
+void BlockLFO::ensureCapacity(int numSamples)
+{
+    // As in SmoothedParameter::getNextBlock(): allocating here is bad, but overrunning is worse
+    jassert(numSamples <= maxBlockSize);
+    if (numSamples > maxBlockSize)
+    {
+        maxBlockSize = numSamples;
+        phases.allocate(size_t(maxBlockSize), true);
+        outputs.allocate(size_t(maxBlockSize * numOutputs), true);
+    }
+}
+
+void BlockLFO::advance(int numSamples, float frequencyHz)
+{
+    ensureCapacity(numSamples);
+    if (isSynced()) frequencyHz = float(syncedFrequencyHz);
+
+    // Each phase is computed from the block's starting phase, so there is no sample-to-sample
+    // dependency, and the loop vectorizes. Phases are >= 0, so truncation is floor().
+    const float start = float(phase);
+    const float increment = float(frequencyHz * inverseSampleRate);
+    float* p = phases;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float x = start + increment * float(i);
+        p[i] = x - float(int(x));
+    }
+
+    phase += double(frequencyHz) * inverseSampleRate * numSamples;
+    phase -= std::floor(phase);
+}
+
+void BlockLFO::advance(int numSamples, const float* frequencyHz)
+{
+    if (isSynced())
+    {
+        advance(numSamples, float(syncedFrequencyHz));
+        return;
+    }
+    ensureCapacity(numSamples);
+
+    // Frequency varies (e.g. a smoothed parameter ramping), so the phase must be accumulated
+    float ph = float(phase);
+    const float invSR = float(inverseSampleRate);
+    float* p = phases;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        p[i] = ph;
+        ph += frequencyHz[i] * invSR;
+        if (ph >= 1.0f) ph -= 1.0f;
+    }
+    phase = ph;
+}
+
+float* BlockLFO::render(int output, Waveform waveform, int numSamples, float phaseOffset)
+{
+    jassert(output >= 0 && output < numOutputs);
+    jassert(numSamples <= maxBlockSize);
+
+    const float* table = tables[jlimit(0, int(kNumWaveforms) - 1, int(waveform))];
+    const float* p = phases;
+    float* out = outputs + output * maxBlockSize;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // A negative offset wraps up into [0, 1), and a phase just below 1 can round up to
+        // tableSize, so the index is clamped, as in getSample()
+        float x = p[i] + phaseOffset;
+        x -= std::floor(x);
+        x *= float(tableSize);
+        const int index = jlimit(0, tableSize - 1, int(x));
+        const float fraction = x - float(index);
+        out[i] = table[index] + fraction * (table[index + 1] - table[index]);
+    }
+    return out;
+}
+
+float BlockLFO::getSample(Waveform waveform, float phase)
+{
+    const float* table = tables[jlimit(0, int(kNumWaveforms) - 1, int(waveform))];
+    float x = phase * float(tableSize);
+    const int index = jlimit(0, tableSize - 1, int(x));
+    const float fraction = x - float(index);
+    return table[index] + fraction * (table[index + 1] - table[index]);
+}
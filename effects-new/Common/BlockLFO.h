@@ -0,0 +1,97 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  BlockLFO is the low-frequency oscillator shared by the modulation effects (Tremolo, Ring
+    Modulator, Phaser, Vibrato, Flanger and Chorus).
+
+    Rather than working out each waveform sample, for every channel, with a switch and a sinf(),
+    it works a block at a time. advance() steps the phase through the whole block, once, keeping
+    the phase at every sample; render() then looks up a waveform at those phases, plus an optional
+    offset (e.g. a quarter cycle for the second channel of a stereo effect), in a table. Each
+    render() fills one of the LFO's output buffers, so one LFO can supply several differently-
+    offset copies of the same modulation, e.g. one per chorus voice.
+
+    The LFO can also follow the host's tempo. With a sync setting other than kSyncOff,
+    syncToPlayHead() (called at the start of each processBlock(), while the play head is valid)
+    replaces the frequency passed to advance() by one cycle per bar or note value, and while the
+    host is playing, locks the phase to the song position.
+
+    All waveforms are "biased", i.e. range [0, 1], as the effects have always used them.
+*/
+
+class BlockLFO
+{
+public:
+    // Every waveform used by any effect; each effect's own XxxLFO::Waveform enum lists the
+    // ones it offers (in its own order, which its parameters depend on)
+    enum Waveform
+    {
+        kWaveformSine = 0,
+        kWaveformTriangle,
+        kWaveformSquare,
+        kWaveformSquareSlopedEdges,
+        kWaveformSawtooth,
+        kWaveformInverseSawtooth,
+        kNumWaveforms
+    };
+
+    enum Sync
+    {
+        kSyncOff = 0,
+        kSyncFourBars,
+        kSyncTwoBars,
+        kSyncOneBar,
+        kSyncHalfNote,
+        kSyncQuarterNote,
+        kSyncEighthNote,
+        kSyncSixteenthNote,
+        kNumSyncs
+    };
+
+    static void populateSyncComboBox(ComboBox& cb);
+
+    BlockLFO();
+
+    // Allocate buffers for blocks of up to maxBlockSize samples, and numOutputs outputs
+    void prepare(double sampleRate, int maxBlockSize, int numOutputs = 1);
+
+    void reset(float startPhase = 0.0f);
+
+    // Audio thread: tempo sync, if the sync setting is not kSyncOff
+    void setSync(Sync newSync) { sync = newSync; }
+    void syncToPlayHead(AudioPlayHead* playHead);
+    bool isSynced() const { return syncedFrequencyHz > 0.0; }
+
+    // Step the phase through the next block, at a constant frequency or one per sample
+    // (either of which tempo sync overrides)
+    void advance(int numSamples, float frequencyHz);
+    void advance(int numSamples, const float* frequencyHz);
+
+    // Phases at each sample of the block last advanced through, in [0, 1)
+    const float* getPhases() const { return phases.get(); }
+
+    // Fill the given output with the waveform at each phase of the block last advanced through,
+    // plus phaseOffset (in cycles, [0, 1)), and return it (the caller may rescale it in place)
+    float* render(int output, Waveform waveform, int numSamples, float phaseOffset = 0.0f);
+
+    // The given output, as last rendered
+    const float* getOutput(int output) const { return outputs.get() + output * maxBlockSize; }
+
+    // The waveform at a single phase, in [0, 1), for code which only needs the occasional value
+    static float getSample(Waveform waveform, float phase);
+
+private:
+    void ensureCapacity(int numSamples);
+
+    HeapBlock<float> phases;        // one block of phases
+    HeapBlock<float> outputs;       // numOutputs blocks of waveform values
+    int maxBlockSize, numOutputs;
+
+    double phase;                   // at the start of the next block
+    double inverseSampleRate;
+
+    Sync sync;
+    double syncedFrequencyHz;       // 0 when not synced
+
+    JUCE_DECLARE_NON_COPYABLE(BlockLFO)
+};
@@ -0,0 +1,55 @@
+#include "DelayInterpolation.h"
+
+void DelayInterpolation::populateInterpolationComboBox(ComboBox& cb)
+{
+    cb.clear(dontSendNotification);
+    int itemNumber = 0;
+    cb.addItem("None", ++itemNumber);
+    cb.addItem("Linear", ++itemNumber);
+    cb.addItem("Cubic", ++itemNumber);
+    cb.addItem("Lagrange 3rd-order", ++itemNumber);
+    cb.addItem("Lagrange 5th-order", ++itemNumber);
+    cb.addItem("Windowed Sinc", ++itemNumber);
+    cb.addItem("Thiran Allpass", ++itemNumber);
+}
+
+float DelayInterpolation::Sinc::table[(numPhases + 1) * numPoints];
+
+namespace
+{
+    // Fills in the Sinc table during static initialisation, so it is ready long before any
+    // audio thread could need it
+    struct SincTableInitialiser
+    {
+        SincTableInitialiser()
+        {
+            using Sinc = DelayInterpolation::Sinc;
+            const double halfWidth = 0.5 * Sinc::numPoints;
+
+            for (int row = 0; row <= Sinc::numPhases; ++row)
+            {
+                const double t = double(row) / Sinc::numPhases;
+                float* coefficients = Sinc::table + row * Sinc::numPoints;
+
+                double sum = 0.0;
+                for (int k = 0; k < Sinc::numPoints; ++k)
+                {
+                    // x is the distance from tap k to the read position
+                    const double x = k - Sinc::pointsBefore - t;
+                    const double sinc = x == 0.0 ? 1.0 : std::sin(MathConstants<double>::pi * x)
+                                                         / (MathConstants<double>::pi * x);
+                    const double w = MathConstants<double>::pi * x / halfWidth;
+                    const double window = 0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+
+                    coefficients[k] = float(sinc * window);
+                    sum += sinc * window;
+                }
+
+                for (int k = 0; k < Sinc::numPoints; ++k)
+                    coefficients[k] = float(coefficients[k] / sum);
+            }
+        }
+    };
+
+    SincTableInitialiser sincTableInitialiser;
+}
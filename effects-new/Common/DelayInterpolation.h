@@ -0,0 +1,178 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  DelayInterpolation: the interpolation methods available for reading a DelayLine at a
+    fractional delay, as used by the Vibrato, Flanger and Chorus effects.
+
+    Each method is a "policy" struct, which DelayLine's read functions take as a template
+    argument, so the interpolation code is inlined straight into the calling loop. Its
+    interpolate() function is given a pointer p to pointsBefore samples before the sample
+    at or just before the read position, and the fraction t (in [0, 1]) of the way from
+    that sample to the next. The numPoints samples p[0] .. p[numPoints - 1] are all valid.
+
+    Methods which need to remember anything from one sample to the next (only the Thiran
+    allpass, so far) keep it in stateSize floats supplied by the caller, one set for each
+    read position ("tap") in each channel; the others ignore the state pointer.
+ */
+
+struct DelayInterpolation
+{
+    enum Type
+    {
+        kInterpolationNearestNeighbour = 0,
+        kInterpolationLinear,
+        kInterpolationCubic,
+        kInterpolationLagrange3,
+        kInterpolationLagrange5,
+        kInterpolationSinc,
+        kInterpolationThiran,
+        kNumInterpolations
+    };
+
+    static void populateInterpolationComboBox(ComboBox& cb);
+
+    struct NearestNeighbour
+    {
+        static const int pointsBefore = 0;
+        static const int numPoints = 2;
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            // round to the nearer of the two samples
+            return t < 0.5f ? p[0] : p[1];
+        }
+    };
+
+    struct Linear
+    {
+        static const int pointsBefore = 0;
+        static const int numPoints = 2;
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            return p[0] + t * (p[1] - p[0]);
+        }
+    };
+
+    struct Cubic
+    {
+        static const int pointsBefore = 1;
+        static const int numPoints = 4;
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            // Catmull-Rom spline through p[0] .. p[3], evaluated between p[1] and p[2]
+            float a0 = -0.5f*p[0] + 1.5f*p[1] - 1.5f*p[2] + 0.5f*p[3];
+            float a1 = p[0] - 2.5f*p[1] + 2.0f*p[2] - 0.5f*p[3];
+            float a2 = -0.5f*p[0] + 0.5f*p[2];
+            float a3 = p[1];
+
+            return ((a0*t + a1)*t + a2)*t + a3;
+        }
+    };
+
+    struct Lagrange3
+    {
+        static const int pointsBefore = 1;
+        static const int numPoints = 4;
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            // 3rd-order polynomial through p[0] .. p[3] (at x = 0 .. 3), evaluated at x = 1 + t.
+            // Each weight is the product of (x - j) for the other points j, over its constant
+            // denominator.
+            const float d0 = t + 1.0f, d1 = t, d2 = t - 1.0f, d3 = t - 2.0f;
+            const float d01 = d0 * d1, d23 = d2 * d3;
+
+            return (d1 * d23) * (-1.0f / 6.0f) * p[0]
+                 + (d0 * d23) * 0.5f * p[1]
+                 + (d01 * d3) * -0.5f * p[2]
+                 + (d01 * d2) * (1.0f / 6.0f) * p[3];
+        }
+    };
+
+    struct Lagrange5
+    {
+        static const int pointsBefore = 2;
+        static const int numPoints = 6;
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            // 5th-order polynomial through p[0] .. p[5] (at x = 0 .. 5), evaluated at x = 2 + t,
+            // using running products of (x - j) from each end to form all six weights
+            const float d0 = t + 2.0f, d1 = t + 1.0f, d2 = t, d3 = t - 1.0f, d4 = t - 2.0f, d5 = t - 3.0f;
+            const float before1 = d0, before2 = before1 * d1, before3 = before2 * d2, before4 = before3 * d3;
+            const float after4 = d5, after3 = after4 * d4, after2 = after3 * d3, after1 = after2 * d2;
+
+            return (after1 * d1) * (-1.0f / 120.0f) * p[0]
+                 + (before1 * after1) * (1.0f / 24.0f) * p[1]
+                 + (before2 * after2) * (-1.0f / 12.0f) * p[2]
+                 + (before3 * after3) * (1.0f / 12.0f) * p[3]
+                 + (before4 * after4) * (-1.0f / 24.0f) * p[4]
+                 + (before4 * d4) * (1.0f / 120.0f) * p[5];
+        }
+    };
+
+    struct Sinc
+    {
+        static const int pointsBefore = 3;
+        static const int numPoints = 8;
+
+        // Windowed-sinc (Blackman window) coefficients for numPoints taps, tabulated at
+        // numPhases + 1 evenly-spaced values of t, each set normalised to unity gain at DC
+        static const int numPhases = 256;
+        static float table[(numPhases + 1) * numPoints];
+
+        static inline float interpolate(const float* p, float t, float*) noexcept
+        {
+            // interpolate linearly between the two tabulated sets of coefficients either side of t
+            const float phase = t * float(numPhases);
+            const int row = jmin(int(phase), numPhases - 1);
+            const float fraction = phase - float(row);
+            const float* c0 = table + row * numPoints;
+            const float* c1 = c0 + numPoints;
+
+            float sum = 0.0f;
+            for (int k = 0; k < numPoints; ++k)
+                sum += (c0[k] + fraction * (c1[k] - c0[k])) * p[k];
+            return sum;
+        }
+    };
+
+    struct Thiran
+    {
+        static const int pointsBefore = 0;
+        static const int numPoints = 3;
+
+        static inline float interpolate(const float* p, float t, float* state) noexcept
+        {
+            // 1st-order allpass, delaying a whole sample by a further d (kept in [0.5, 1.5),
+            // where its coefficient is well away from the pole at -1). state[0] is the previous
+            // input to the filter, state[1] its previous output.
+            jassert(state != nullptr);
+            float d = 1.0f - t;
+            float x = p[1];
+            if (d < 0.5f)
+            {
+                d += 1.0f;
+                x = p[2];
+            }
+            const float a = (1.0f - d) / (1.0f + d);
+
+            const float y = a * (x - state[1]) + state[0];
+            state[0] = x;
+            state[1] = y;
+            return y;
+        }
+    };
+
+    // The largest numPoints of any method above, which DelayLine must allow for
+    static const int maxPoints = 8;
+
+    // The shortest delay, in samples, which every method above can read when each sample is
+    // read before the one at the same offset is written, i.e. numPoints - pointsBefore - 1
+    static const int minDelaySamples = 4;
+
+    // The largest number of floats of state any method above needs, per tap
+    static const int stateSize = 2;
+};
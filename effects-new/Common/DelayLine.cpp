@@ -0,0 +1,51 @@
+#include "DelayLine.h"
+
+DelayLine::DelayLine()
+    : numChannels(0)
+    , size(0)
+    , mask(0)
+    , writePosition(0)
+{
+}
+
+void DelayLine::prepare(int numChannelsToUse, int maxDelaySamples, int maxBlockSize)
+{
+    // Room for the longest delay, plus the interpolator's extra samples, even when a
+    // whole block has been written ahead of the samples being read
+    numChannels = jmax(1, numChannelsToUse);
+    size = nextPowerOfTwo(jmax(1, maxDelaySamples) + jmax(1, maxBlockSize) + DelayInterpolation::maxPoints);
+    mask = size - 1;
+
+    buffer.allocate(size_t(2 * size * numChannels), true);
+    writePosition = 0;
+}
+
+void DelayLine::clear()
+{
+    FloatVectorOperations::clear(buffer.get(), 2 * size * numChannels);
+    writePosition = 0;
+}
+
+void DelayLine::writeBlock(int channel, const float* input, int numSamples) noexcept
+{
+    jassert(numSamples <= size);
+    float* data = getChannelData(channel);
+
+    // at most two runs, either side of the end of the buffer, each stored in both halves
+    const int firstRun = jmin(numSamples, size - writePosition);
+    FloatVectorOperations::copy(data + writePosition, input, firstRun);
+    FloatVectorOperations::copy(data + writePosition + size, input, firstRun);
+    if (firstRun < numSamples)
+    {
+        FloatVectorOperations::copy(data, input + firstRun, numSamples - firstRun);
+        FloatVectorOperations::copy(data + size, input + firstRun, numSamples - firstRun);
+    }
+}
+
+void DelayLine::readBlock(int channel, int delaySamples, float* output, int numSamples) const noexcept
+{
+    // thanks to the mirroring, one run starting in the first half never passes the end
+    jassert(numSamples <= size);
+    const int start = (writePosition - delaySamples) & mask;
+    FloatVectorOperations::copy(output, getChannelData(channel) + start, numSamples);
+}
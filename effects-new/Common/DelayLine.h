@@ -0,0 +1,160 @@
+#pragma once
+#include "JuceHeader.h"
+#include "DelayInterpolation.h"
+
+/*  DelayLine is the multichannel circular buffer shared by all the delay-based effects.
+
+    Its length is a power of two, so positions wrap with a bitwise AND rather than % or fmodf(),
+    and it is "mirrored": every sample is stored twice, once in each half of a buffer twice that
+    length. Any run of samples starting in the first half can therefore be read straight through,
+    without checking for the end of the buffer, which lets interpolators read several adjacent
+    samples, and block reads copy whole runs at once.
+
+    All channels share one write position, which marks the start of the current block. Within
+    the block, samples are addressed by their offset from it, so each channel can be processed
+    in turn (writing and reading at offsets 0, 1, 2...) before advance() moves on to the next
+    block. A delay of d samples at offset i reads the sample written at offset i - d, so d must
+    be at least 1 unless that sample has already been written (e.g. by writeBlock()).
+ */
+
+class DelayLine
+{
+public:
+    DelayLine();
+
+    // Allocate and clear the buffer, for delays up to maxDelaySamples and blocks
+    // of up to maxBlockSize samples
+    void prepare(int numChannels, int maxDelaySamples, int maxBlockSize);
+
+    void clear();
+
+    int getNumChannels() const { return numChannels; }
+
+    // Per-sample writing and reading, at the given offset from the start of the current block
+    inline void write(int channel, int offset, float sample) noexcept
+    {
+        const int index = (writePosition + offset) & mask;
+        float* data = getChannelData(channel);
+        data[index] = data[index + size] = sample;
+    }
+
+    inline float read(int channel, int offset, int delaySamples) const noexcept
+    {
+        return getChannelData(channel)[(writePosition + offset - delaySamples) & mask];
+    }
+
+    // A fractional delay must be at least DelayInterpolation::minDelaySamples, for reading
+    // before writing at the same offset. state is the interpolator's state for this tap, if any.
+    template <typename Interpolator>
+    inline float read(int channel, int offset, float delaySamples, float* state = nullptr) const noexcept
+    {
+        // The read position is (writePosition + offset - delaySamples); split it into
+        // the sample at or before it, and the fraction t of the way to the next one
+        const int wholeSamples = int(delaySamples);
+        const float t = 1.0f - (delaySamples - float(wholeSamples));
+        const int position = writePosition + offset - wholeSamples - 1 - Interpolator::pointsBefore;
+
+        return Interpolator::interpolate(getChannelData(channel) + (position & mask), t, state);
+    }
+
+    // Interpolation chosen at run time, e.g. by a parameter. This switches on every call, so
+    // in a processing loop, it is better to switch once and call a loop templated on the type.
+    inline float read(DelayInterpolation::Type type, int channel, int offset, float delaySamples,
+                      float* state = nullptr) const noexcept
+    {
+        switch (type)
+        {
+        case DelayInterpolation::kInterpolationNearestNeighbour:
+            return read<DelayInterpolation::NearestNeighbour>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationLinear:
+            return read<DelayInterpolation::Linear>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationCubic:
+            return read<DelayInterpolation::Cubic>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationLagrange3:
+            return read<DelayInterpolation::Lagrange3>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationLagrange5:
+            return read<DelayInterpolation::Lagrange5>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationSinc:
+            return read<DelayInterpolation::Sinc>(channel, offset, delaySamples, state);
+        case DelayInterpolation::kInterpolationThiran:
+            return read<DelayInterpolation::Thiran>(channel, offset, delaySamples, state);
+        default:
+            // This line would only be reached if the type argument is invalid
+            return 0.0f;
+        }
+    }
+
+    // The most samples, from offset 0, which can be read at the given delay before writing
+    // any of them, i.e. before the first sample to be written is needed
+    template <typename Interpolator>
+    static int getLongestBlock(float delaySamples) noexcept
+    {
+        return jmax(0, int(delaySamples) + 2 + Interpolator::pointsBefore - Interpolator::numPoints);
+    }
+
+    // Block writing and reading, for offsets 0 .. numSamples - 1 (these vectorize)
+    void writeBlock(int channel, const float* input, int numSamples) noexcept;
+    void readBlock(int channel, int delaySamples, float* output, int numSamples) const noexcept;
+
+    template <typename Interpolator>
+    void readBlock(int channel, const float* delaySamples, float* output, int numSamples,
+                   float* state = nullptr) const noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = read<Interpolator>(channel, i, delaySamples[i], state);
+    }
+
+    // A fixed fractional delay, for offsets 0 .. numSamples - 1. The interpolator's weights
+    // are the same for every sample, so they are worked out once (as its response to each
+    // point on its own), and the block is then one multiply-add over a straight run of the
+    // buffer per point; a weight of zero, e.g. for a whole number of samples, is skipped.
+    // The Thiran allpass has state, so has no fixed weights, and can't be read this way.
+    // Every sample read must already have been written, so without writeBlock() first, the
+    // block can be at most getLongestBlock<Interpolator>(delaySamples) samples long.
+    template <typename Interpolator>
+    void readBlock(int channel, float delaySamples, float* output, int numSamples) const noexcept
+    {
+        static_assert(!std::is_same<Interpolator, DelayInterpolation::Thiran>::value,
+                      "readBlock() at a fixed delay needs a stateless interpolator");
+        jassert(numSamples <= size);
+
+        const int wholeSamples = int(delaySamples);
+        const float t = 1.0f - (delaySamples - float(wholeSamples));
+        const int position = writePosition - wholeSamples - 1 - Interpolator::pointsBefore;
+        const float* p = getChannelData(channel) + (position & mask);
+
+        float weights[Interpolator::numPoints];
+        for (int k = 0; k < Interpolator::numPoints; ++k)
+        {
+            float unit[Interpolator::numPoints] = {};
+            unit[k] = 1.0f;
+            weights[k] = Interpolator::interpolate(unit, t, nullptr);
+        }
+
+        FloatVectorOperations::clear(output, numSamples);
+        for (int k = 0; k < Interpolator::numPoints; ++k)
+            if (weights[k] != 0.0f)
+                FloatVectorOperations::addWithMultiply(output, p + k, weights[k], numSamples);
+    }
+
+    // Move on to the next block, once all channels have been processed
+    inline void advance(int numSamples) noexcept
+    {
+        writePosition = (writePosition + numSamples) & mask;
+    }
+
+private:
+    inline float* getChannelData(int channel) const noexcept
+    {
+        jassert(channel >= 0 && channel < numChannels);
+        return buffer.get() + 2 * size * channel;
+    }
+
+    HeapBlock<float> buffer;    // numChannels runs of 2 * size samples
+    int numChannels;
+    int size;                   // a power of two
+    int mask;                   // size - 1
+    int writePosition;          // in [0, size)
+
+    JUCE_DECLARE_NON_COPYABLE(DelayLine)
+};
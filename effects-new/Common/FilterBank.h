@@ -0,0 +1,50 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  FilterBank holds one filter per channel (or any per-channel object with a reset() function),
+    for processors which used to add new filters to an OwnedArray in every prepareToPlay(), and
+    delete them in releaseResources(). Some hosts call those every time the transport starts,
+    so the array could grow without limit (prepareToPlay() never cleared it), and every call
+    churned the heap.
+
+    prepare() only allocates if asked for more channels than ever before, which preallocate()
+    can avoid altogether by allocating for the expected number up front (e.g. in the processor's
+    constructor); otherwise it just resets the filters it already has, in place. Filters are
+    only deleted along with the bank, so releaseResources() need not do anything with it.
+*/
+
+template <typename FilterType>
+class FilterBank
+{
+public:
+    FilterBank() : numChannels(0) {}
+
+    // Allocate filters for up to maxChannels channels, without using them yet
+    void preallocate(int maxChannels)
+    {
+        while (filters.size() < maxChannels)
+            filters.add(new FilterType);
+    }
+
+    // Not on the audio thread: use numChannelsToUse filters, all reset
+    void prepare(int numChannelsToUse)
+    {
+        preallocate(numChannelsToUse);
+        numChannels = numChannelsToUse;
+        for (auto* filter : *this)
+            filter->reset();
+    }
+
+    int size() const noexcept { return numChannels; }
+    FilterType* operator[](int channel) const noexcept { return filters.getUnchecked(channel); }
+
+    // Range-based for loops visit the filters in use
+    FilterType* const* begin() const noexcept { return filters.begin(); }
+    FilterType* const* end() const noexcept { return filters.begin() + numChannels; }
+
+private:
+    OwnedArray<FilterType> filters;
+    int numChannels;
+
+    JUCE_DECLARE_NON_COPYABLE(FilterBank)
+};
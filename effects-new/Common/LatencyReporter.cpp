@@ -0,0 +1,31 @@
+#include "LatencyReporter.h"
+
+LatencyReporter::LatencyReporter(AudioProcessor& processorToReportFor)
+    : processor(processorToReportFor)
+    , latency(0)
+{
+    startTimerHz(20);
+}
+
+LatencyReporter::~LatencyReporter()
+{
+    stopTimer();
+}
+
+void LatencyReporter::setLatencySamples(int latencySamples)
+{
+    latency.store(latencySamples);
+}
+
+void LatencyReporter::setLatencySamplesNow(int latencySamples)
+{
+    latency.store(latencySamples);
+    processor.setLatencySamples(latencySamples);
+}
+
+void LatencyReporter::timerCallback()
+{
+    const int latencySamples = latency.load();
+    if (latencySamples != processor.getLatencySamples())
+        processor.setLatencySamples(latencySamples);
+}
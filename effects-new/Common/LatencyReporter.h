@@ -0,0 +1,38 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  LatencyReporter tells the host about a processor's latency from the message thread.
+
+    A processor's latency usually changes when a parameter does, but parameter listeners may be
+    called on the audio thread (by host automation, or an AutomationScheduler), and the host may
+    do a lot of work, or even restart the audio, in response to setLatencySamples(), so that
+    should only be called from the message thread. setLatencySamples() here can be called from
+    any thread, including the audio thread: it only stores the new latency atomically, without
+    posting a message or taking a lock. A Timer on the message thread checks it a few times a
+    second, and passes it to the processor when it differs from what the host was last told.
+
+    The processor should call it at the point where the audio it produces actually changes
+    latency, not when the parameter changes, so the host never compensates for a delay the
+    audio doesn't have yet.
+*/
+
+class LatencyReporter : private Timer
+{
+public:
+    LatencyReporter(AudioProcessor& processorToReportFor);
+    ~LatencyReporter();
+
+    // Any thread: report latencySamples to the host, soon, from the message thread
+    void setLatencySamples(int latencySamples);
+
+    // Not on the audio thread (e.g. in prepareToPlay()): report latencySamples at once
+    void setLatencySamplesNow(int latencySamples);
+
+private:
+    void timerCallback() override;
+
+    AudioProcessor& processor;
+    std::atomic<int> latency;
+
+    JUCE_DECLARE_NON_COPYABLE(LatencyReporter)
+};
@@ -0,0 +1,41 @@
+#include "MeterRing.h"
+
+MeterRing::MeterRing(int capacity)
+    : fifo(capacity)
+    , frames(capacity, true)
+{
+}
+
+bool MeterRing::push(const MeterFrame& frame)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 < 1) return false;
+
+    frames[size1 > 0 ? start1 : start2] = frame;
+    fifo.finishedWrite(1);
+    return true;
+}
+
+int MeterRing::read(MeterFrame& merged)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+    int numFrames = size1 + size2;
+    if (numFrames < 1) return 0;
+
+    MeterFrame result = frames[size1 > 0 ? start1 : start2];
+    float sumOfSquares = 0.0f;
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const MeterFrame& frame = frames[i < size1 ? start1 + i : start2 + i - size1];
+        result.gain = jmin(result.gain, frame.gain);
+        result.peak = jmax(result.peak, frame.peak);
+        sumOfSquares += frame.rms * frame.rms;
+    }
+    result.rms = std::sqrt(sumOfSquares / numFrames);
+
+    fifo.finishedRead(numFrames);
+    merged = result;
+    return numFrames;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  MeterRing carries meter readings from a processor's audio thread to its editor, without
+    locks, allocation, or message posting on the audio thread (which sendChangeMessage() does).
+
+    The processor calls push() once per block, with a MeterFrame summarizing that block; push()
+    is wait-free, and if the ring is full (e.g. no editor is open) the frame is simply dropped.
+    The editor polls on a Timer, calling read() to collect every frame pushed since last time,
+    merged into one, so a short peak is not missed just because the GUI was slower than the audio.
+
+    There must be only one pushing thread and one reading thread (single producer/consumer).
+*/
+
+struct MeterFrame
+{
+    float gain;     // linear gain applied, e.g. by a compressor (1.0 = no gain reduction)
+    float peak;     // linear peak level
+    float rms;      // linear RMS level
+};
+
+class MeterRing
+{
+public:
+    MeterRing(int capacity = 64);
+
+    // Audio thread: returns false (and drops the frame) if the ring is full
+    bool push(const MeterFrame& frame);
+
+    // GUI thread: merges all waiting frames (lowest gain, highest peak, overall RMS)
+    // into merged, and returns the number of frames read (0 if none, leaving merged unchanged)
+    int read(MeterFrame& merged);
+
+private:
+    AbstractFifo fifo;
+    HeapBlock<MeterFrame> frames;
+
+    JUCE_DECLARE_NON_COPYABLE(MeterRing)
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "JuceHeader.h"
+#include "SmoothedParameter.h"
 
 struct BoolListener : public AudioProcessorValueTreeState::Listener
 {
@@ -67,3 +68,18 @@ struct EnumListener : public AudioProcessorValueTreeState::Listener
         enumValue = (EnumType)(int(newValue + 0.5f));
     }
 };
+
+// This specialized AudioProcessorValueTreeState::Listener sets the target of a SmoothedParameter,
+// which then ramps to the new value during processBlock(), rather than jumping to it.
+struct SmoothedFloatListener : public AudioProcessorValueTreeState::Listener
+{
+    SmoothedParameter& workingValue;
+    float scaleFactor;      // multiply parameter values by this to get working value
+
+    SmoothedFloatListener(SmoothedParameter& wv, float sf = 1.0f)
+        : AudioProcessorValueTreeState::Listener(), workingValue(wv), scaleFactor(sf) {}
+    void parameterChanged(const String&, float newValue) override
+    {
+        workingValue.setTarget(scaleFactor * newValue);
+    }
+};
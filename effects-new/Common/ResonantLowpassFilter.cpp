@@ -1,10 +1,16 @@
 #include "ResonantLowpassFilter.h"
 #define PI_D 3.141592654
 
-/* The actual audio processing is handled by the Juce IIRFilter parent
- * class. This subclass is used to define the coefficients for our
- * implementation of a parametric equaliser.
- */
+ResonantLowpassFilter::ResonantLowpassFilter()
+    : s1(0.0f), s2(0.0f)
+    , rampLength(0)
+    , rampSamplesRemaining(0)
+{
+    // Start out passing the signal unchanged, until makeResonantLowpass() is called
+    const float unity[5] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 5; ++i)
+        coefficients[i] = targets[i] = unity[i];
+}
 
 void ResonantLowpassFilter::makeResonantLowpass(const double inverseSampleRate,
                                                 const double centreFrequency,
@@ -19,15 +25,50 @@ void ResonantLowpassFilter::makeResonantLowpass(const double inverseSampleRate,
     const double alpha = sin(discreteFrequency) / (2.0 * Q);
     const double cos_w0 = cos(discreteFrequency);
 
-    // setCoefficients() takes arguments: b0, b1, b2, a0, a1, a2
-    // It will normalise the filter according to the value of a0
-    // to allow standard time-domain implementations
-    coefficients = IIRCoefficients(0.5*(1.0 - cos_w0)*gain, // b0
-                     (1.0 - cos_w0)*gain,                   // b1
-                     0.5*(1.0 - cos_w0)*gain,               // b2
-                     1.0 + alpha,                           // a0
-                     -2.0 * cos_w0,                         // a1
-                     1.0 - alpha );                         // a2
-    
-    setCoefficients(coefficients);
+    // b0, b1, b2, a1, a2, normalised according to the value of
+    // a0 = 1 + alpha to allow standard time-domain implementations
+    const double a0 = 1.0 + alpha;
+    targets[0] = float(0.5*(1.0 - cos_w0)*gain / a0);
+    targets[1] = float((1.0 - cos_w0)*gain / a0);
+    targets[2] = float(0.5*(1.0 - cos_w0)*gain / a0);
+    targets[3] = float(-2.0 * cos_w0 / a0);
+    targets[4] = float((1.0 - alpha) / a0);
+
+    // Start a new ramp from wherever the coefficients are now, even part way along a ramp
+    if (rampLength <= 0) jumpToTarget();
+    else
+    {
+        for (int i = 0; i < 5; ++i)
+            increments[i] = (targets[i] - coefficients[i]) / float(rampLength);
+        rampSamplesRemaining = rampLength;
+    }
+}
+
+void ResonantLowpassFilter::jumpToTarget() noexcept
+{
+    for (int i = 0; i < 5; ++i)
+        coefficients[i] = targets[i];
+    rampSamplesRemaining = 0;
+}
+
+void ResonantLowpassFilter::stepRamp() noexcept
+{
+    // Land exactly on the targets, rather than wherever rounding errors have got to
+    if (--rampSamplesRemaining == 0) jumpToTarget();
+    else
+    {
+        for (int i = 0; i < 5; ++i)
+            coefficients[i] += increments[i];
+    }
+}
+
+void ResonantLowpassFilter::reset() noexcept
+{
+    s1 = s2 = 0.0f;
+}
+
+void ResonantLowpassFilter::processSamples(float* samples, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+        samples[i] = processSingleSample(samples[i]);
 }
@@ -32,13 +32,25 @@
 
 /**
  * This class implements a resonant lowpass filter used in the wah-wah
- * effect and its variants
+ * effect and its variants: one biquad section, in transposed direct form II.
+ *
+ * It used to be a JUCE IIRFilter, whose setCoefficients() and processing
+ * functions share a SpinLock. Instead, coefficients are set on the same
+ * thread as the processing, e.g. the audio thread, so no lock is needed.
+ * If a ramp length is set, new coefficients do not take effect at once,
+ * which would click: each one moves to its new value in equal steps, one
+ * per sample, over the ramp length. (Any straight line between two stable
+ * sets of denominator coefficients stays inside the triangle of stable
+ * ones, so the filter stays stable throughout the ramp.)
  */
 
-class ResonantLowpassFilter : public IIRFilter
+class ResonantLowpassFilter
 {
 public:
-    ResonantLowpassFilter() : IIRFilter() {}
+    ResonantLowpassFilter();
+
+    // Ramp length in samples; 0 (the default) makes new coefficients take effect at once
+    void setRampLength(int numSamples) noexcept { rampLength = numSamples; }
 
 	// Sets the filter coefficients to produce a resonant lowpass with a given
     // centre frequency and Q. Also include a gain term to offset resonant peak.
@@ -46,7 +58,30 @@ public:
                              const double centreFrequency,
                              const double Q,
                              const double gain) noexcept;
-	
+
+    // Ends any ramp, with the coefficients at their new values
+    void jumpToTarget() noexcept;
+
+    void reset() noexcept;
+    void processSamples(float* samples, int numSamples) noexcept;
+
+    float processSingleSample(float in) noexcept
+    {
+        const float out = coefficients[0] * in + s1;
+        s1 = coefficients[1] * in - coefficients[3] * out + s2;
+        s2 = coefficients[2] * in - coefficients[4] * out;
+        if (rampSamplesRemaining > 0) stepRamp();
+        return out;
+    }
+
 private:
+    void stepRamp() noexcept;
+
+    // b0, b1, b2, a1, a2, normalised so a0 = 1
+    float coefficients[5], targets[5], increments[5];
+    float s1, s2;
+
+    int rampLength, rampSamplesRemaining;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResonantLowpassFilter);
 };
@@ -0,0 +1,91 @@
+#include "SmoothedParameter.h"
+#include "FastMath.h"
+
+SmoothedParameter::SmoothedParameter(float initialValue, float rampTimeSeconds, RampType type)
+    : target(initialValue)
+    , rampType(type)
+    , rampTimeSec(rampTimeSeconds)
+    , rampLengthSamples(1)
+    , currentValue(initialValue)
+    , rampStart(initialValue)
+    , rampTarget(initialValue)
+    , rampStep(0.0f)
+    , rampPosition(0)
+    , samplesRemaining(0)
+    , multiplicativeRamp(false)
+    , steady(true)
+    , maxBlockSize(0)
+{
+}
+
+void SmoothedParameter::prepare(double sampleRate, int maxSamplesPerBlock)
+{
+    rampLengthSamples = jmax(1, int(rampTimeSec * sampleRate));
+    maxBlockSize = maxSamplesPerBlock;
+    values.allocate(maxBlockSize, false);
+
+    currentValue = rampStart = rampTarget = target.load();
+    rampPosition = samplesRemaining = 0;
+    steady = true;
+}
+
+const float* SmoothedParameter::getNextBlock(int numSamples)
+{
+    // Some hosts occasionally exceed the block size they promised in prepareToPlay(). Allocating
+    // here is bad, but returning too few values would be worse, since callers index up to numSamples.
+    jassert(numSamples <= maxBlockSize);
+    if (numSamples > maxBlockSize)
+    {
+        maxBlockSize = numSamples;
+        values.allocate(maxBlockSize, false);
+    }
+
+    // Start a new ramp, from wherever we are now, if the target has changed
+    float newTarget = target.load();
+    if (newTarget != rampTarget)
+    {
+        rampStart = currentValue;
+        rampTarget = newTarget;
+        rampPosition = 0;
+        samplesRemaining = rampLengthSamples;
+        multiplicativeRamp = rampType == kMultiplicative && currentValue > 0.0f && rampTarget > 0.0f;
+        if (multiplicativeRamp)
+            rampStep = (FastMath::log2(rampTarget) - FastMath::log2(rampStart)) / rampLengthSamples;
+        else
+            rampStep = (rampTarget - rampStart) / rampLengthSamples;
+    }
+
+    // Ramp portion: each value is computed from the ramp's start value, not the previous sample,
+    // so these loops have no sample-to-sample dependency and can be vectorized. This also makes
+    // the values independent of how the ramp is divided into blocks.
+    int rampSamples = jmin(samplesRemaining, numSamples);
+    steady = rampSamples <= 0;
+    if (rampSamples > 0)
+    {
+        float start = rampStart;
+        float step = rampStep;
+        int offset = rampPosition + 1;
+        float* v = values;
+        if (multiplicativeRamp)
+        {
+            for (int i = 0; i < rampSamples; ++i)
+                v[i] = start * FastMath::exp2(step * float(i + offset));
+        }
+        else
+        {
+            for (int i = 0; i < rampSamples; ++i)
+                v[i] = start + step * float(i + offset);
+        }
+
+        rampPosition += rampSamples;
+        samplesRemaining -= rampSamples;
+        if (samplesRemaining == 0) v[rampSamples - 1] = rampTarget;
+        currentValue = v[rampSamples - 1];
+    }
+
+    // Steady portion
+    if (rampSamples < numSamples)
+        FloatVectorOperations::fill(values + rampSamples, currentValue, numSamples - rampSamples);
+
+    return values;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "JuceHeader.h"
+
+/*  SmoothedParameter is a working parameter value which, when changed, ramps smoothly to its
+    new value over a fixed time, instead of jumping (which causes audible "zipper noise").
+
+    Listeners (see SmoothedFloatListener in ParameterListeners.h) call setTarget(), from any
+    thread; the target is published atomically. The audio thread calls getNextBlock() once per
+    processBlock(), which returns an array of per-sample values for the whole block, so a
+    parameter change is spread smoothly across the block, however large the block is.
+
+    Linear ramps suit most parameters (levels, depths, delay times); multiplicative (exponential)
+    ramps suit frequencies and linear gains, where equal ratios sound like equal steps.
+    Multiplicative ramps require strictly positive values.
+*/
+
+class SmoothedParameter
+{
+public:
+    enum RampType { kLinear, kMultiplicative };
+
+    SmoothedParameter(float initialValue, float rampTimeSeconds = 0.05f, RampType type = kLinear);
+
+    // Any thread: set a new value to ramp towards
+    void setTarget(float newTarget) { target.store(newTarget); }
+    float getTarget() const { return target.load(); }
+
+    // Allocate the per-sample value array, and jump straight to the target value
+    void prepare(double sampleRate, int maxSamplesPerBlock);
+
+    // Audio thread: returns values for the next numSamples samples (should be <= maxSamplesPerBlock)
+    const float* getNextBlock(int numSamples);
+
+    // Audio thread: value at the end of the most recent block
+    float getCurrentValue() const { return currentValue; }
+
+    // Audio thread: true if every value the most recent getNextBlock() returned was the same,
+    // i.e. no ramp was in progress during that block
+    bool isSteady() const { return steady; }
+
+private:
+    std::atomic<float> target;
+    RampType rampType;
+    float rampTimeSec;
+    int rampLengthSamples;
+
+    float currentValue;     // value reached at end of previous block
+    float rampStart;        // value at the start of the ramp in progress
+    float rampTarget;       // target of the ramp in progress
+    float rampStep;         // per-sample increment (linear) or log2 of per-sample ratio (multiplicative)
+    int rampPosition;       // samples done in the ramp in progress
+    int samplesRemaining;   // in the ramp in progress
+    bool multiplicativeRamp;    // false if rampType is kLinear, or either end of the ramp is <= 0
+    bool steady;                // no ramp in the most recent block
+
+    HeapBlock<float> values;
+    int maxBlockSize;
+
+    JUCE_DECLARE_NON_COPYABLE(SmoothedParameter)
+};